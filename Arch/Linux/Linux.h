@@ -51,6 +51,12 @@
 #define WKEY_MINUS_LIN                      KEY_KP_SUBTRACT
 #define WKEY_Z_LIN                          KEY_Z
 #define WKEY_X_LIN                          KEY_X
+#define WKEY_1_LIN                          KEY_ONE
+#define WKEY_2_LIN                          KEY_TWO
+#define WKEY_3_LIN                          KEY_THREE
+#define WKEY_4_LIN                          KEY_FOUR
+#define WKEY_P_LIN                          KEY_P
+#define WKEY_F_LIN                          KEY_F
 
 #define MOUSE_WHEEL_SENITIVITY_LIN          0.05f
 
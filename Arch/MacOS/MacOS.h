@@ -51,6 +51,12 @@
 #define WKEY_MINUS_MAC                      47
 #define WKEY_Z_MAC                          KEY_Z
 #define WKEY_X_MAC                          KEY_X
+#define WKEY_1_MAC                          KEY_ONE
+#define WKEY_2_MAC                          KEY_TWO
+#define WKEY_3_MAC                          KEY_THREE
+#define WKEY_4_MAC                          KEY_FOUR
+#define WKEY_P_MAC                          KEY_P
+#define WKEY_F_MAC                          KEY_F
 
 #define MOUSE_WHEEL_SENITIVITY_MAC          0.05f
 
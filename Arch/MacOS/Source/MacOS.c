@@ -19,6 +19,9 @@
 
 #include <stdbool.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 #include "../../../Mods/Public/Public.h"
 #include "../../../Mods/Fund/Fund.h"
@@ -27,6 +30,8 @@
 // ============================================================================ PRIVATE FUNC DECL
 
 void            Path_GetHomeDirForPlatform(char* dst);
+const unsigned char* Pack_MapFileForPlatform(const char* path, int* size);
+void            Pack_UnmapFileForPlatform(const unsigned char* data, int size);
 
 
 
@@ -60,3 +65,35 @@ bool Path_MakeDirForPlatform(const char* path){
 }
 
 
+// **************************************************************************** Pack_MapFileForPlatform
+
+// Map the file to memory, read only. Save the file size at the given pointer. 
+// Return NULL if it fails
+const unsigned char* Pack_MapFileForPlatform(const char* path, int* size){
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {return NULL;}
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0 || st.st_size > 0x7FFFFFFF){
+        close(fd);
+        return NULL;
+    }
+
+    void* data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {return NULL;}
+
+    *size = (int) st.st_size;
+
+    return data;
+}
+
+
+// **************************************************************************** Pack_UnmapFileForPlatform
+
+// Unmap a file, mapped with Pack_MapFileForPlatform
+void Pack_UnmapFileForPlatform(const unsigned char* data, int size){
+    if (data != NULL){
+        munmap((void*) data, size);
+    }
+}
@@ -51,6 +51,12 @@
 #define WKEY_MINUS_WIN                      KEY_KP_SUBTRACT
 #define WKEY_Z_WIN                          KEY_Z
 #define WKEY_X_WIN                          KEY_X
+#define WKEY_1_WIN                          KEY_ONE
+#define WKEY_2_WIN                          KEY_TWO
+#define WKEY_3_WIN                          KEY_THREE
+#define WKEY_4_WIN                          KEY_FOUR
+#define WKEY_P_WIN                          KEY_P
+#define WKEY_F_WIN                          KEY_F
 
 #define MOUSE_WHEEL_SENITIVITY_WIN          0.05f
 
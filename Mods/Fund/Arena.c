@@ -0,0 +1,336 @@
+// ============================================================================
+// RODS
+// Arena
+// by Andreas Socratous
+// Jan 2023
+// ============================================================================
+
+
+// ============================================================================ INFO
+/*
+    Functions for the arenas, the memory regions that hand out blocks by
+    moving an offset, and for the per-frame scratch arena.
+
+    An arena is a single block of capacity bytes. Every allocation takes the
+    next bytes of the block, after a small header that holds the offset of
+    the previous allocation, so the last allocation can be given back by
+    Arena_Pop. Any other allocation stays until Arena_Reset, that gives back
+    all of them at once. When the block is full, the allocation is made on
+    the heap and freed by Arena_Pop or Arena_Reset; the reset then grows the
+    block to the peak use, so an arena that is reset regularly stops using
+    the heap after its busiest cycle.
+
+    The scratch arena holds the temporaries of the main thread, that do not
+    outlive the frame: it is reset at every frame of the main loop. On the
+    other threads, and before Scratch_Init, the scratch functions fall back
+    to Memory_Allocate and Memory_Free, so the functions that use scratch
+    memory can be called from any thread.
+*/
+
+
+// ============================================================================ DEPENDENCIES
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <raylib.h>
+
+#include "../Public/Public.h"
+#include "Fund.h"
+
+
+// Defined here, not the call site macros of Fund.h
+#ifdef MEMORY_TRACK
+    #undef Arena_Allocate
+    #undef Scratch_Allocate
+#endif
+
+
+// ============================================================================ PRIVATE MACROS
+
+// The size rounded up to the alignment of the blocks
+#define ARENA_ALIGN(gSize) \
+    (((gSize) + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1))
+
+
+// ============================================================================ PRIVATE CONSTANTS
+
+#define ARENA_ALIGNMENT                     16
+#define ARENA_HEADER_SIZE                   ARENA_ALIGN((int) sizeof(ArenaHeader))
+
+
+// ============================================================================ PRIVATE STRUCTURES
+
+// **************************************************************************** ArenaHeader
+
+// The header before every block of the arena. The previous top is the offset
+// of the header of the previous allocation in the arena, or INVALID. The next
+// is the next heap block, for the blocks that do not fit in the arena
+typedef struct ArenaHeader{
+    int prevTop;
+    int size;
+    struct ArenaHeader* next;
+}ArenaHeader;
+
+
+// ============================================================================ OPAQUE STRUCTURES
+
+// **************************************************************************** Arena
+
+// The used bytes are the offset of the next allocation and the top is the
+// offset of the header of the last allocation. The requested bytes, in the
+// arena and on the heap, are counted since the last reset, and their peak
+// is the size of the arena after the reset
+struct Arena{
+    unsigned char* data;
+    int capacity;
+    int used;
+    int top;
+
+    int requested;
+    int peak;
+
+    ArenaHeader* overflow;
+};
+
+
+// ============================================================================ PRIVATE VARIABLES
+
+// The scratch arena of the current thread, or NULL if it uses the heap
+static _Thread_local Arena* scratchArena = NULL;
+
+
+// ============================================================================ PRIVATE FUNC DECL
+
+static bool     Arena_Owns(const Arena* arena, const void* ptr);
+static void     Arena_FreeOverflow(Arena* arena);
+static void     Arena_SetZeroValues(void* ptr, int size, E_ZeroValMode zeroValMode);
+
+
+
+
+
+
+// ============================================================================ FUNC DEF
+
+// **************************************************************************** Arena_Make
+
+// Make an arena of the given capacity in bytes
+Arena* Arena_Make(int capacity){
+    Arena* arena = Memory_Allocate(NULL, sizeof(Arena), ZEROVAL_ALL);
+
+    arena->capacity = ARENA_ALIGN(MAX(capacity, ARENA_ALIGNMENT));
+    arena->data = Memory_Allocate(NULL, arena->capacity, ZEROVAL_NONE);
+    arena->top = INVALID;
+
+    return arena;
+}
+
+
+// **************************************************************************** Arena_Free
+
+// Free the arena and all its blocks. Return NULL
+Arena* Arena_Free(Arena* arena){
+    if (arena == NULL) {return NULL;}
+
+    Arena_FreeOverflow(arena);
+    arena->data = Memory_Free(arena->data);
+
+    return Memory_Free(arena);
+}
+
+
+// **************************************************************************** Arena_Allocate
+
+// Allocate a block of the given size in the arena, or on the heap if the
+// arena is full. Eventually set the values to 0 according to the zero values
+// mode
+void* Arena_Allocate(Arena* arena, int size, E_ZeroValMode zeroValMode){
+    Err_Assert(size > 0, "Invalid memory size");
+
+    int blockSize = ARENA_HEADER_SIZE + ARENA_ALIGN(size);
+    arena->requested += blockSize;
+    arena->peak = MAX(arena->peak, arena->requested);
+
+    ArenaHeader* header = NULL;
+    if (arena->used + blockSize <= arena->capacity){
+        header = (ArenaHeader*) (arena->data + arena->used);
+        header->prevTop = arena->top;
+        header->next = NULL;
+
+        arena->top = arena->used;
+        arena->used += blockSize;
+    }else{
+        header = Memory_Allocate(NULL, blockSize, ZEROVAL_NONE);
+        header->prevTop = INVALID;
+        header->next = arena->overflow;
+        arena->overflow = header;
+    }
+    header->size = blockSize;
+
+    void* ptr = (unsigned char*) header + ARENA_HEADER_SIZE;
+    Arena_SetZeroValues(ptr, size, zeroValMode);
+
+    return ptr;
+}
+
+
+// **************************************************************************** Arena_Pop
+
+// Give back the block, if it is the last allocation in the arena or it is on
+// the heap. Any other block is given back at the reset. Return NULL
+void* Arena_Pop(Arena* arena, void* ptr){
+    if (ptr == NULL) {return NULL;}
+
+    ArenaHeader* header = (ArenaHeader*) ((unsigned char*) ptr - ARENA_HEADER_SIZE);
+
+    if (Arena_Owns(arena, ptr)){
+        if (arena->top != INVALID && (unsigned char*) header == arena->data + arena->top){
+            arena->requested -= header->size;
+            arena->used = arena->top;
+            arena->top = header->prevTop;
+        }
+        return NULL;
+    }
+
+    for (ArenaHeader** link = &arena->overflow; *link != NULL; link = &(*link)->next){
+        if (*link == header){
+            *link = header->next;
+            arena->requested -= header->size;
+            Memory_Free(header);
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+
+// **************************************************************************** Arena_Reset
+
+// Give back all the blocks of the arena. If the blocks did not fit in the
+// arena since the last reset, grow it to their peak
+void Arena_Reset(Arena* arena){
+    Arena_FreeOverflow(arena);
+
+    if (arena->peak > arena->capacity){
+        arena->capacity = arena->peak;
+        arena->data = Memory_Allocate(arena->data, arena->capacity, ZEROVAL_NONE);
+    }
+
+    arena->used = 0;
+    arena->top = INVALID;
+    arena->requested = 0;
+    arena->peak = 0;
+}
+
+
+// **************************************************************************** Scratch_Init
+
+// Make the scratch arena of the current thread with the given capacity in
+// bytes. Called on the main thread, at the start of the program
+void Scratch_Init(int capacity){
+    if (scratchArena != NULL) {return;}
+
+    scratchArena = Arena_Make(capacity);
+}
+
+
+// **************************************************************************** Scratch_Close
+
+// Free the scratch arena of the current thread
+void Scratch_Close(void){
+    scratchArena = Arena_Free(scratchArena);
+}
+
+
+// **************************************************************************** Scratch_Allocate
+
+// Allocate a temporary block of the given size, that lives until the end of
+// the frame, or until it is given back by Scratch_Free. Eventually set the
+// values to 0 according to the zero values mode
+void* Scratch_Allocate(int size, E_ZeroValMode zeroValMode){
+    if (scratchArena == NULL){
+        return Memory_Allocate(NULL, size, zeroValMode);
+    }
+
+    return Arena_Allocate(scratchArena, size, zeroValMode);
+}
+
+
+// **************************************************************************** Scratch_Free
+
+// Give back the temporary block. Blocks are best given back in the reverse
+// order of their allocation. Return NULL
+void* Scratch_Free(void* ptr){
+    if (scratchArena == NULL){
+        return Memory_Free(ptr);
+    }
+
+    return Arena_Pop(scratchArena, ptr);
+}
+
+
+// **************************************************************************** Scratch_Reset
+
+// Give back all the temporary blocks of the current thread. Called at every
+// frame of the main loop
+void Scratch_Reset(void){
+    if (scratchArena == NULL) {return;}
+
+    int capacity = scratchArena->capacity;
+    Arena_Reset(scratchArena);
+
+    if (scratchArena->capacity != capacity){
+        TraceLog(LOG_INFO, "ARENA: Scratch arena grown to %d bytes", scratchArena->capacity);
+    }
+}
+
+
+
+
+
+
+// ============================================================================ PRIVATE FUNC DEF
+
+// **************************************************************************** Arena_Owns
+
+// Return true if the pointer is in the block of the arena
+static bool Arena_Owns(const Arena* arena, const void* ptr){
+    uintptr_t address = (uintptr_t) ptr;
+    uintptr_t start = (uintptr_t) arena->data;
+
+    return address >= start && address < start + (uintptr_t) arena->capacity;
+}
+
+
+// **************************************************************************** Arena_FreeOverflow
+
+// Free the blocks of the arena that are on the heap
+static void Arena_FreeOverflow(Arena* arena){
+    while (arena->overflow != NULL){
+        ArenaHeader* next = arena->overflow->next;
+        Memory_Free(arena->overflow);
+        arena->overflow = next;
+    }
+}
+
+
+// **************************************************************************** Arena_SetZeroValues
+
+// Set the values of the block to 0 according to the zero values mode
+static void Arena_SetZeroValues(void* ptr, int size, E_ZeroValMode zeroValMode){
+    switch(zeroValMode){
+        case ZEROVAL_ALL:{
+            Memory_Set(ptr, size, 0);
+            break;
+        }
+
+        case ZEROVAL_LAST:{
+            *((unsigned char*) ptr + size - 1) = 0;
+            break;
+        }
+
+        default: {break;}
+    }
+}
@@ -0,0 +1,238 @@
+// ============================================================================
+// RODS
+// Counter
+// by Andreas Socratous
+// Jan 2023
+// ============================================================================
+
+
+// ============================================================================ INFO
+/*
+    Functions for the registry of the runtime counters, the numbers of what
+    the program does in every frame and in the whole session.
+
+    A counter only grows, by Counter_Add. A gauge, from CNT_FIRST_GAUGE,
+    holds a current value, set by Counter_Set or moved by Counter_Add, and
+    keeps its max. The values are 64-bit and atomic, so the counters can be
+    moved from any thread, at the cost of a single atomic add.
+
+    Counter_BeginFrame takes a snapshot of the counters at the start of
+    every frame, so the value of a counter in the last frame and its max in
+    any frame are known. The registry is written to a JSON file at the end
+    of the session, by Counter_WriteToFile, or by Counter_Dump if the
+    environment variable COUNTER_ENV_VAR holds the path of the file.
+*/
+
+
+// ============================================================================ FILE STRUCTURE
+/*
+    {
+    "frames": <frames>,
+    "counters": {
+        "<name>": {"total": <value>, "last_frame": <value>, "max_frame": <value>},
+        ...
+    },
+    "gauges": {
+        "<name>": {"value": <value>, "max": <value>},
+        ...
+    }
+    }
+*/
+
+
+// ============================================================================ DEPENDENCIES
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <raylib.h>
+
+#include "../Public/Public.h"
+#include "Fund.h"
+
+
+// ============================================================================ PRIVATE CONSTANTS
+
+#define COUNTER_ENV_VAR                     "RODS_COUNTERS"
+
+
+// ============================================================================ PRIVATE VARIABLES
+
+// The names of the counters in the JSON file
+static const char* counterNames[COUNTERS_N] = {
+    "frames",           "frames_drawn",
+    "electrify_nodes",  "reelectrify_calls",
+    "events_queued",    "events_dropped",
+    "rod_batches",      "rod_quads",
+    "allocs",           "alloc_bytes",
+    "frees",            "font_measures",
+    "lod_draws",
+    "live_blocks",      "queue_length"
+};
+
+static atomic_llong counterValues[COUNTERS_N];
+static atomic_llong counterMaxValues[COUNTERS_N];
+
+// The snapshot of the counters at the start of the frame and their values
+// in the last frame
+static long long counterFrameStarts[COUNTERS_N];
+static long long counterLastFrames[COUNTERS_N];
+
+
+// ============================================================================ PRIVATE FUNC DECL
+
+static void     Counter_UpdateMax(E_CounterID id, long long value);
+
+
+
+
+
+
+// ============================================================================ FUNC DEF
+
+// **************************************************************************** Counter_Add
+
+// Add n to the counter or the gauge
+void Counter_Add(E_CounterID id, long long n){
+    long long value = atomic_fetch_add_explicit(&counterValues[id], n, memory_order_relaxed) + n;
+
+    if (id >= CNT_FIRST_GAUGE){
+        Counter_UpdateMax(id, value);
+    }
+}
+
+
+// **************************************************************************** Counter_Set
+
+// Set the value of the gauge
+void Counter_Set(E_CounterID id, long long value){
+    atomic_store_explicit(&counterValues[id], value, memory_order_relaxed);
+    Counter_UpdateMax(id, value);
+}
+
+
+// **************************************************************************** Counter_Get
+
+// Return the value of the counter, in the whole session, or of the gauge
+long long Counter_Get(E_CounterID id){
+    return atomic_load_explicit(&counterValues[id], memory_order_relaxed);
+}
+
+
+// **************************************************************************** Counter_GetFrameValue
+
+// Return the value of the counter since the start of the current frame, or
+// the value of the gauge
+long long Counter_GetFrameValue(E_CounterID id){
+    long long value = Counter_Get(id);
+
+    return (id >= CNT_FIRST_GAUGE) ? value : value - counterFrameStarts[id];
+}
+
+
+// **************************************************************************** Counter_GetName
+
+// Return the name of the counter, as in the JSON file
+const char* Counter_GetName(E_CounterID id){
+    return counterNames[id];
+}
+
+
+// **************************************************************************** Counter_BeginFrame
+
+// Take the snapshot of the counters at the start of a frame and keep their
+// values in the last frame. Called on the main thread, at every frame
+void Counter_BeginFrame(void){
+    bool hasLastFrame = (Counter_Get(CNT_FRAMES) > 0);
+
+    for (int id = 0; id < CNT_FIRST_GAUGE; id++){
+        long long value = Counter_Get(id);
+
+        if (hasLastFrame){
+            counterLastFrames[id] = value - counterFrameStarts[id];
+            Counter_UpdateMax(id, counterLastFrames[id]);
+        }
+        counterFrameStarts[id] = value;
+    }
+
+    for (int id = CNT_FIRST_GAUGE; id < COUNTERS_N; id++){
+        counterLastFrames[id] = Counter_Get(id);
+    }
+
+    Counter_Add(CNT_FRAMES, 1);
+}
+
+
+// **************************************************************************** Counter_WriteToFile
+
+// Write the counters and the gauges to the JSON file at the path. Return true
+// if successful
+bool Counter_WriteToFile(const char* path){
+    if (path == NULL) {return false;}
+
+    FILE* file = fopen(path, "w");
+    if (file == NULL) {return false;}
+
+    fprintf(file, "{\n\"frames\": %lld,\n\"counters\": {\n", Counter_Get(CNT_FRAMES));
+    for (int id = 0; id < CNT_FIRST_GAUGE; id++){
+        fprintf(file, "    \"%s\": {\"total\": %lld, \"last_frame\": %lld, \"max_frame\": %lld}%s\n",
+                counterNames[id], Counter_Get(id), counterLastFrames[id],
+                atomic_load(&counterMaxValues[id]), (id < CNT_FIRST_GAUGE - 1) ? "," : "");
+    }
+
+    fprintf(file, "},\n\"gauges\": {\n");
+    for (int id = CNT_FIRST_GAUGE; id < COUNTERS_N; id++){
+        fprintf(file, "    \"%s\": {\"value\": %lld, \"max\": %lld}%s\n", counterNames[id], Counter_Get(id),
+                atomic_load(&counterMaxValues[id]), (id < COUNTERS_N - 1) ? "," : "");
+    }
+    fprintf(file, "}\n}\n");
+
+    return fclose(file) == 0;
+}
+
+
+// **************************************************************************** Counter_Dump
+
+// Write the counters to the JSON file at the path in the environment variable
+// COUNTER_ENV_VAR, if it is set. Called at the end of the session
+void Counter_Dump(void){
+    const char* path = getenv(COUNTER_ENV_VAR);
+    if (path == NULL || path[0] == '\0') {return;}
+
+    if (Counter_WriteToFile(path)){
+        TraceLog(LOG_INFO, "COUNTER: Counters written to %s", path);
+    }else{
+        TraceLog(LOG_WARNING, "COUNTER: Cannot write the counters to %s", path);
+    }
+}
+
+
+#ifdef DEBUG_MODE
+// **************************************************************************** Counter_Print
+
+    // Multiline print of the counters and the gauges
+    void Counter_Print(void){
+        for (int id = 0; id < COUNTERS_N; id++){
+            printf("%-20s %12lld (last frame %lld, max %lld)\n", CounterID_ToString(id), Counter_Get(id),
+                   counterLastFrames[id], atomic_load(&counterMaxValues[id]));
+        }
+    }
+#endif
+
+
+
+
+
+
+// ============================================================================ PRIVATE FUNC DEF
+
+// **************************************************************************** Counter_UpdateMax
+
+// Raise the max of the counter to the value, if it is larger
+static void Counter_UpdateMax(E_CounterID id, long long value){
+    long long max = atomic_load_explicit(&counterMaxValues[id], memory_order_relaxed);
+    while (value > max &&
+           !atomic_compare_exchange_weak_explicit(&counterMaxValues[id], &max, value, memory_order_relaxed,
+                                                  memory_order_relaxed)){
+    }
+}
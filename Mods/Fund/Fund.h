@@ -12,10 +12,11 @@
 
 // ============================================================================ INFO
 /*
-    Functions for error handling and memory management, math functions, 
-    functions for working with the Bytes structure and directions, for string 
-    manipulation, geometry and working with grid structures, time and for 
-    managing the program's window. 
+    Functions for error handling and memory management, arenas and pools, 
+    math functions, functions for working with the Bytes structure and 
+    directions, for string manipulation, for building strings in fixed 
+    buffers, geometry and working with grid structures, time, for managing 
+    the program's window, for tracing and for the runtime counters. 
 */
 
 
@@ -44,12 +45,39 @@ void            Memory_Set(void* ptr, int size, unsigned char value);
 void*           Memory_Free(void* ptr);
 void            Memory_FreeAll(int nObjects, ...);
 #ifdef MEMORY_TRACK
+    void        Memory_BeginSite(const char* file, int line);
+    void*       Memory_EndSite(void* ptr);
     void        Memory_Print(void);
 #endif
 
+// ---------------------------------------------------------------------------- Arena Functions
+
+Arena*          Arena_Make(int capacity);
+Arena*          Arena_Free(Arena* arena);
+void*           Arena_Allocate(Arena* arena, int size, E_ZeroValMode zeroValMode);
+void*           Arena_Pop(Arena* arena, void* ptr);
+void            Arena_Reset(Arena* arena);
+void            Scratch_Init(int capacity);
+void            Scratch_Close(void);
+void*           Scratch_Allocate(int size, E_ZeroValMode zeroValMode);
+void*           Scratch_Free(void* ptr);
+void            Scratch_Reset(void);
+
+// ---------------------------------------------------------------------------- Pool Functions
+
+Pool*           Pool_Make(int objectSize, int chunkN);
+Pool*           Pool_Free(Pool* pool);
+void*           Pool_Allocate(Pool* pool, E_ZeroValMode zeroValMode);
+void*           Pool_Deallocate(Pool* pool, void* ptr);
+bool            Pool_Owns(const Pool* pool, const void* ptr);
+int             Pool_GetNumUsed(const Pool* pool);
+
 // ---------------------------------------------------------------------------- Math Functions
 
 int             Math_RandomInt(int minV, int maxV);
+void            Math_SetRandomSeed(unsigned int seed);
+unsigned int    Math_RandomSeed(void);
+int             Math_SeededRandomInt(unsigned int* state, int minV, int maxV);
 float           Math_RandomFloat(float minV, float maxV);
 bool            Math_FloatsAreEqual(float num1, float num2, float precision);
 float           Math_Sqrt(float num);
@@ -66,6 +94,7 @@ int             Math_AngleQuarter(float angle);
 float           Math_Sin(float angle);
 float           Math_Cos(float angle);
 float           Math_Tan(float angle);
+unsigned int    Math_Hash(unsigned int hash, const void* data, int size);
 
 // ---------------------------------------------------------------------------- Bytes Functions
 
@@ -100,6 +129,17 @@ char*           String_Copy(char* dst, const char* src);
 char*           String_Concat(char* dst, int nStrings, ...);
 char*           String_FromInt(char* dst, int num);
 char*           String_Pad(char* str, int minLength, char padChar);
+int             String_WriteInt(char* dst, int size, int num);
+
+// ---------------------------------------------------------------------------- StrBuf Functions
+
+StrBuf          StrBuf_Make(char* buffer, int capacity);
+StrBuf          StrBuf_MakeInScratch(int capacity);
+void            StrBuf_Clear(StrBuf* sb);
+void            StrBuf_Append(StrBuf* sb, const char* str);
+void            StrBuf_AppendChar(StrBuf* sb, char c);
+void            StrBuf_AppendInt(StrBuf* sb, int num, int minDigits);
+void            StrBuf_AppendTime(StrBuf* sb, Time t);
 
 // ---------------------------------------------------------------------------- Geometry Functions
 
@@ -200,6 +240,7 @@ Time            Time_Shift(Time t, int dt);
 int             Time_ToInt(Time t);
 Time            Time_FromInt(int secs);
 char*           Time_ToString(char* dst, Time t);
+int             Time_Write(char* dst, int size, Time t);
 #ifdef DEBUG_MODE
     void        Time_Print(Time t, bool withNewLine);
 #endif
@@ -207,14 +248,75 @@ char*           Time_ToString(char* dst, Time t);
 // ---------------------------------------------------------------------------- Window Functions
 
 void            Window_Init(void);
+void            Window_InitHidden(Size size);
 Size            Window_GetSize(void);
 void            Window_UpdateWinSize(void);
+void            Window_SkipFrame(double seconds);
+double          Window_GetTime(void);
+void            Window_SetFixedTime(double t);
 void            Window_Close(void);
 #ifdef DEBUG_MODE
     void        Window_PrintSize(bool withNewLine);
     void        Window_PrintAppInfo(void);
 #endif
 
+// ---------------------------------------------------------------------------- Trace Functions
+
+void            Trace_Init(void);
+void            Trace_Close(void);
+void            Trace_Begin(const char* name, int arg);
+void            Trace_End(void);
+void            Trace_Instant(const char* name, int arg);
+bool            Trace_Flush(void);
+void            Trace_WriteRecent(FILE* file, int n);
+
+// ---------------------------------------------------------------------------- Counter Functions
+
+void            Counter_Add(E_CounterID id, long long n);
+void            Counter_Set(E_CounterID id, long long value);
+long long       Counter_Get(E_CounterID id);
+long long       Counter_GetFrameValue(E_CounterID id);
+const char*     Counter_GetName(E_CounterID id);
+void            Counter_BeginFrame(void);
+bool            Counter_WriteToFile(const char* path);
+void            Counter_Dump(void);
+#ifdef DEBUG_MODE
+    void        Counter_Print(void);
+#endif
+
+// ============================================================================ MEMORY TRACK MACROS
+
+// With MEMORY_TRACK, the calls of the functions that allocate memory record 
+// their file and line, so every allocation is reported at the outermost call 
+// in the source, even through these functions. The files that define them 
+// undefine the macros
+#ifdef MEMORY_TRACK
+    #define MEMORY_SITE(gArg) \
+        (Memory_BeginSite(__FILE__, __LINE__), (gArg))
+
+    #define Memory_Allocate(gPtr, ...) \
+        Memory_EndSite(Memory_Allocate(MEMORY_SITE(gPtr), __VA_ARGS__))
+    #define Memory_Copy(gDst, ...) \
+        Memory_EndSite(Memory_Copy(MEMORY_SITE(gDst), __VA_ARGS__))
+    #define Arena_Allocate(gArena, ...) \
+        Memory_EndSite(Arena_Allocate(MEMORY_SITE(gArena), __VA_ARGS__))
+    #define Scratch_Allocate(gSize, ...) \
+        Memory_EndSite(Scratch_Allocate(MEMORY_SITE(gSize), __VA_ARGS__))
+    #define Pool_Allocate(gPool, ...) \
+        Memory_EndSite(Pool_Allocate(MEMORY_SITE(gPool), __VA_ARGS__))
+    #define String_Copy(gDst, ...) \
+        ((char*) Memory_EndSite(String_Copy(MEMORY_SITE(gDst), __VA_ARGS__)))
+    #define String_Concat(gDst, ...) \
+        ((char*) Memory_EndSite(String_Concat(MEMORY_SITE(gDst), __VA_ARGS__)))
+    #define String_FromInt(gDst, ...) \
+        ((char*) Memory_EndSite(String_FromInt(MEMORY_SITE(gDst), __VA_ARGS__)))
+    #define String_Pad(gStr, ...) \
+        ((char*) Memory_EndSite(String_Pad(MEMORY_SITE(gStr), __VA_ARGS__)))
+    #define Time_ToString(gDst, ...) \
+        ((char*) Memory_EndSite(Time_ToString(MEMORY_SITE(gDst), __VA_ARGS__)))
+#endif
+
+
 #endif // FUND_GUARD
 
 
@@ -24,16 +24,22 @@
 #include "Fund.h"
 
 
+// ============================================================================ PRIVATE VARIABLES
+
+// The random generator is seeded from the clock at the first use, unless it 
+// was seeded by Math_SetRandomSeed
+static bool mathIsSeeded = false;
+
+
 // ============================================================================ FUNC DEF
 
 // **************************************************************************** Math_RandomInt
 
 // Return a random integer between and including the limits
 int Math_RandomInt(int minV, int maxV){
-    static bool isSeeded = false;
-    if (!isSeeded){
+    if (!mathIsSeeded){
         srand(time(NULL));
-        isSeeded = true;
+        mathIsSeeded = true;
     }
 
     int range = maxV - minV + 1;
@@ -43,6 +49,47 @@ int Math_RandomInt(int minV, int maxV){
 }
 
 
+// **************************************************************************** Math_SetRandomSeed
+
+// Seed the random generator of Math_RandomInt, so it gives the same sequence 
+// at every run
+void Math_SetRandomSeed(unsigned int seed){
+    srand(seed);
+    mathIsSeeded = true;
+}
+
+
+// **************************************************************************** Math_RandomSeed
+
+// Return a random seed for Math_SeededRandomInt
+unsigned int Math_RandomSeed(void){
+    unsigned int seed = (unsigned int) Math_RandomInt(0, 0x7FFF);
+    seed = (seed << 15) ^ (unsigned int) Math_RandomInt(0, 0x7FFF);
+    seed = (seed << 15) ^ (unsigned int) Math_RandomInt(0, 0x7FFF);
+
+    return seed;
+}
+
+
+// **************************************************************************** Math_SeededRandomInt
+
+// Return a random integer between and including the limits, from the 
+// generator with the given state. The same seed always gives the same sequence
+int Math_SeededRandomInt(unsigned int* state, int minV, int maxV){
+    // Xorshift32. The state must not be 0
+    unsigned int x = (*state != 0) ? *state : 0x9E3779B9u;
+    x ^= (x << 13);
+    x ^= (x >> 17);
+    x ^= (x << 5);
+    *state = x;
+
+    int range = maxV - minV + 1;
+    range = MAX(1, range);
+
+    return (int) (x % (unsigned int) range) + minV;
+}
+
+
 // **************************************************************************** Math_RandomFloat
 
 // Return a random float between and including the limits. The limits must be 
@@ -284,3 +331,20 @@ float Math_Tan(float angle){
 
 
 
+
+
+// **************************************************************************** Math_Hash
+
+// The FNV-1a hash of the data, continued from the given hash. Start from 0, 
+// to hash the data from the beginning
+unsigned int Math_Hash(unsigned int hash, const void* data, int size){
+    const unsigned char* bytes = data;
+
+    if (hash == 0) {hash = 0x811C9DC5u;}
+    for (int i = 0; i < size; i++){
+        hash ^= bytes[i];
+        hash *= 0x01000193u;
+    }
+
+    return hash;
+}
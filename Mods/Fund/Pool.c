@@ -0,0 +1,227 @@
+// ============================================================================
+// RODS
+// Pool
+// by Andreas Socratous
+// Jan 2023
+// ============================================================================
+
+
+// ============================================================================ INFO
+/*
+    Functions for the pools, the allocators of small objects of a fixed
+    size.
+
+    A pool takes its objects from chunks of chunkN objects, allocated on the
+    heap when the pool is empty and freed only with the pool. A given back
+    object is kept in a list of free objects, linked through the objects
+    themselves, and is the first to be taken again. So making and freeing
+    objects of the pool, once it has grown to their peak number, makes no
+    heap calls.
+*/
+
+
+// ============================================================================ DEPENDENCIES
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <raylib.h>
+
+#include "../Public/Public.h"
+#include "Fund.h"
+
+
+// Defined here, not the call site macro of Fund.h
+#ifdef MEMORY_TRACK
+    #undef Pool_Allocate
+#endif
+
+
+// ============================================================================ PRIVATE MACROS
+
+// The size rounded up to the alignment of the objects
+#define POOL_ALIGN(gSize) \
+    (((gSize) + POOL_ALIGNMENT - 1) & ~(POOL_ALIGNMENT - 1))
+
+
+// ============================================================================ PRIVATE CONSTANTS
+
+#define POOL_ALIGNMENT                      16
+#define POOL_HEADER_SIZE                    POOL_ALIGN((int) sizeof(PoolChunk))
+
+
+// ============================================================================ PRIVATE STRUCTURES
+
+// **************************************************************************** PoolChunk
+
+// The header of a chunk of objects, that follow it
+typedef struct PoolChunk{
+    struct PoolChunk* next;
+}PoolChunk;
+
+
+// **************************************************************************** PoolObject
+
+// A free object of the pool
+typedef struct PoolObject{
+    struct PoolObject* next;
+}PoolObject;
+
+
+// ============================================================================ OPAQUE STRUCTURES
+
+// **************************************************************************** Pool
+
+// The object size is the size of the objects as requested and the block size
+// is their size in the chunks
+struct Pool{
+    int objectSize;
+    int blockSize;
+    int chunkN;
+
+    PoolChunk* chunks;
+    PoolObject* freeObjects;
+
+    int nUsed;
+};
+
+
+// ============================================================================ PRIVATE FUNC DECL
+
+static void     Pool_AddChunk(Pool* pool);
+
+
+
+
+
+
+// ============================================================================ FUNC DEF
+
+// **************************************************************************** Pool_Make
+
+// Make an empty pool for objects of the given size, taken from chunks of
+// chunkN objects
+Pool* Pool_Make(int objectSize, int chunkN){
+    Err_Assert(objectSize > 0 && chunkN > 0, "Invalid pool size");
+
+    Pool* pool = Memory_Allocate(NULL, sizeof(Pool), ZEROVAL_ALL);
+
+    pool->objectSize = objectSize;
+    pool->blockSize = POOL_ALIGN(MAX(objectSize, (int) sizeof(PoolObject)));
+    pool->chunkN = chunkN;
+
+    return pool;
+}
+
+
+// **************************************************************************** Pool_Free
+
+// Free the pool and all its chunks, with the objects that are not given back.
+// Return NULL
+Pool* Pool_Free(Pool* pool){
+    if (pool == NULL) {return NULL;}
+
+    while (pool->chunks != NULL){
+        PoolChunk* next = pool->chunks->next;
+        Memory_Free(pool->chunks);
+        pool->chunks = next;
+    }
+
+    return Memory_Free(pool);
+}
+
+
+// **************************************************************************** Pool_Allocate
+
+// Take an object from the pool, adding a chunk if it is empty. Eventually set
+// the values to 0 according to the zero values mode
+void* Pool_Allocate(Pool* pool, E_ZeroValMode zeroValMode){
+    if (pool->freeObjects == NULL){
+        Pool_AddChunk(pool);
+    }
+
+    PoolObject* object = pool->freeObjects;
+    pool->freeObjects = object->next;
+    pool->nUsed++;
+
+    switch(zeroValMode){
+        case ZEROVAL_ALL:{
+            Memory_Set(object, pool->objectSize, 0);
+            break;
+        }
+
+        case ZEROVAL_LAST:{
+            *((unsigned char*) object + pool->objectSize - 1) = 0;
+            break;
+        }
+
+        default: {break;}
+    }
+
+    return object;
+}
+
+
+// **************************************************************************** Pool_Deallocate
+
+// Give back the object to the pool. Return NULL
+void* Pool_Deallocate(Pool* pool, void* ptr){
+    if (ptr == NULL) {return NULL;}
+
+    PoolObject* object = ptr;
+    object->next = pool->freeObjects;
+    pool->freeObjects = object;
+    pool->nUsed--;
+
+    return NULL;
+}
+
+
+// **************************************************************************** Pool_Owns
+
+// Return true if the pointer is an object of the pool
+bool Pool_Owns(const Pool* pool, const void* ptr){
+    if (pool == NULL || ptr == NULL) {return false;}
+
+    uintptr_t address = (uintptr_t) ptr;
+    for (const PoolChunk* chunk = pool->chunks; chunk != NULL; chunk = chunk->next){
+        uintptr_t start = (uintptr_t) chunk + POOL_HEADER_SIZE;
+        if (address >= start && address < start + (uintptr_t) pool->blockSize * pool->chunkN){
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+// **************************************************************************** Pool_GetNumUsed
+
+// Return the number of objects taken from the pool and not given back
+int Pool_GetNumUsed(const Pool* pool){
+    return (pool == NULL) ? 0 : pool->nUsed;
+}
+
+
+
+
+
+
+// ============================================================================ PRIVATE FUNC DEF
+
+// **************************************************************************** Pool_AddChunk
+
+// Allocate a chunk of objects and add them to the free objects, in the order
+// of their address
+static void Pool_AddChunk(Pool* pool){
+    PoolChunk* chunk = Memory_Allocate(NULL, POOL_HEADER_SIZE + pool->blockSize * pool->chunkN, ZEROVAL_NONE);
+    chunk->next = pool->chunks;
+    pool->chunks = chunk;
+
+    unsigned char* objects = (unsigned char*) chunk + POOL_HEADER_SIZE;
+    for (int i = pool->chunkN - 1; i >= 0; i--){
+        PoolObject* object = (PoolObject*) (objects + pool->blockSize * i);
+        object->next = pool->freeObjects;
+        pool->freeObjects = object;
+    }
+}
@@ -0,0 +1,134 @@
+// ============================================================================
+// RODS
+// String Builder
+// by Andreas Socratous
+// Jan 2023
+// ============================================================================
+
+
+// ============================================================================ INFO
+/*
+    Functions for the string builder, for making strings in fixed buffers
+    without allocating memory.
+
+    The buffer of a builder is given by the caller, usually an array on the
+    stack, or taken from the scratch arena, for strings that live until the
+    end of the frame. The builder never grows its buffer: what does not fit
+    is cut, so the string is always valid and terminated, and the builder is
+    marked as truncated.
+*/
+
+
+// ============================================================================ DEPENDENCIES
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <raylib.h>
+
+#include "../Public/Public.h"
+#include "Fund.h"
+
+
+// ============================================================================ FUNC DEF
+
+// **************************************************************************** StrBuf_Make
+
+// Make a builder over the buffer of the given capacity, including the
+// terminating character, with an empty string
+StrBuf StrBuf_Make(char* buffer, int capacity){
+    StrBuf sb = {.str = buffer, .capacity = MAX(0, capacity)};
+
+    if (sb.capacity > 0){
+        sb.str[0] = '\0';
+    }
+
+    return sb;
+}
+
+
+// **************************************************************************** StrBuf_MakeInScratch
+
+// Make a builder over a buffer of the given capacity in the scratch arena,
+// that lives until the end of the frame
+StrBuf StrBuf_MakeInScratch(int capacity){
+    capacity = MAX(1, capacity);
+
+    return StrBuf_Make(Scratch_Allocate(capacity, ZEROVAL_NONE), capacity);
+}
+
+
+// **************************************************************************** StrBuf_Clear
+
+// Empty the string of the builder, keeping its buffer
+void StrBuf_Clear(StrBuf* sb){
+    sb->length = 0;
+    sb->isTruncated = false;
+
+    if (sb->capacity > 0){
+        sb->str[0] = '\0';
+    }
+}
+
+
+// **************************************************************************** StrBuf_Append
+
+// Append the string, or as much of it as fits
+void StrBuf_Append(StrBuf* sb, const char* str){
+    if (str == NULL) {return;}
+
+    for (; *str != '\0'; str++){
+        if (sb->length + 1 >= sb->capacity){
+            sb->isTruncated = true;
+            break;
+        }
+
+        sb->str[sb->length] = *str;
+        sb->length++;
+    }
+
+    if (sb->capacity > 0){
+        sb->str[sb->length] = '\0';
+    }
+}
+
+
+// **************************************************************************** StrBuf_AppendChar
+
+// Append the character, if it fits
+void StrBuf_AppendChar(StrBuf* sb, char c){
+    char str[2] = {c, '\0'};
+    StrBuf_Append(sb, str);
+}
+
+
+// **************************************************************************** StrBuf_AppendInt
+
+// Append the integer, padded with zeros to at least minDigits digits
+void StrBuf_AppendInt(StrBuf* sb, int num, int minDigits){
+    char digits[INT_STR_SIZE];
+    int nDigits = String_WriteInt(digits, INT_STR_SIZE, num);
+
+    const char* ptr = digits;
+    if (*ptr == '-'){
+        StrBuf_AppendChar(sb, '-');
+        ptr++;
+        nDigits--;
+    }
+
+    for (; nDigits < minDigits; nDigits++){
+        StrBuf_AppendChar(sb, '0');
+    }
+
+    StrBuf_Append(sb, ptr);
+}
+
+
+// **************************************************************************** StrBuf_AppendTime
+
+// Append the time in the form [HH:]MM:SS
+void StrBuf_AppendTime(StrBuf* sb, Time t){
+    char str[TIME_STR_SIZE];
+    Time_Write(str, TIME_STR_SIZE, t);
+
+    StrBuf_Append(sb, str);
+}
@@ -24,6 +24,16 @@
 #include "Fund.h"
 
 
+// The string functions that allocate are defined here, not their call site 
+// macros
+#ifdef MEMORY_TRACK
+    #undef String_Copy
+    #undef String_Concat
+    #undef String_FromInt
+    #undef String_Pad
+#endif
+
+
 // ============================================================================ FUNC DEF
 
 // **************************************************************************** String_Length
@@ -116,34 +126,10 @@ char* String_Concat(char* dst, int nStrings, ...){
 
 // Turn the integer to string. Save the result at dst
 char* String_FromInt(char* dst, int num){
-    // Mark if the number is negative
-    bool isNegative = (num < 0);
-    num = ABS(num);
-
-    // Determine the number of digits
-    int nDigits = 1;
-    int num2 = num;
-    while ((num2 /= 10) > 0){
-        nDigits++;
-    }
-
-    // Allocate memory for the string
-    dst = Memory_Allocate(dst, nDigits + 1, ZEROVAL_LAST);
-    char* ptr = dst + nDigits - 1;
+    char buffer[INT_STR_SIZE];
+    String_WriteInt(buffer, INT_STR_SIZE, num);
 
-    // Write each digit, starting from the last
-    do{
-        *ptr = num % 10 + '0';
-        ptr--;
-    }while ((num /= 10) > 0);
-
-    // If negative, add the minus sign
-    if (isNegative){
-        dst = String_Concat(dst, 2, "-", dst);
-    }
-
-    // Return the string
-    return dst;
+    return String_Copy(dst, buffer);
 }
 
 
@@ -170,3 +156,41 @@ char* String_Pad(char* str, int minLength, char padChar){
     return str;
 }
 
+
+// **************************************************************************** String_WriteInt
+
+// Write the integer as a string in the buffer dst of the given size, without
+// allocating memory. Return the length of the string, or INVALID if it does 
+// not fit, leaving an empty string
+int String_WriteInt(char* dst, int size, int num){
+    if (size <= 0) {return INVALID;}
+
+    // The absolute value as unsigned, since the smallest int has no opposite
+    bool isNegative = (num < 0);
+    unsigned int value = isNegative ? 0u - (unsigned int) num : (unsigned int) num;
+
+    // Determine the length
+    int length = isNegative ? 2 : 1;
+    for (unsigned int temp = value; (temp /= 10) > 0;){
+        length++;
+    }
+
+    if (length + 1 > size){
+        dst[0] = '\0';
+        return INVALID;
+    }
+
+    // Write each digit, starting from the last
+    dst[length] = '\0';
+    char* ptr = dst + length - 1;
+    do{
+        *ptr = value % 10 + '0';
+        ptr--;
+    }while ((value /= 10) > 0);
+
+    if (isNegative){
+        dst[0] = '-';
+    }
+
+    return length;
+}
@@ -9,6 +9,18 @@
 // ============================================================================ INFO
 /*
     Functions for error and memory management.
+
+    With MEMORY_TRACK, the memory functions are an allocation profiler. Every 
+    live heap block is kept in a hash table, with its size and its call site, 
+    the file and line of the outermost call that allocated it, recorded by 
+    the macros of Fund.h. For every call site the profiler counts the 
+    allocations and their bytes, and the live bytes with their peak. A 
+    reallocated block moves to the site of the reallocation. Memory_Print 
+    reports the busiest sites, a histogram of the allocation sizes and the 
+    blocks that are still live, the leaks at the end of the program.
+
+    The profiler tables are allocated with malloc, outside the profiler, and 
+    guarded by a mutex, since memory is allocated by the worker threads too.
 */
 
 
@@ -19,11 +31,99 @@
 #include <raylib.h>
 
 #include <stdarg.h>
+#include <stdint.h>
 
 #include "../Public/Public.h"
 #include "Fund.h"
 
 
+#ifdef MEMORY_TRACK
+// ============================================================================ MEMORY TRACK
+
+// The functions are defined without the macros that record their call site
+#undef Memory_Allocate
+#undef Memory_Copy
+
+#include <pthread.h>
+
+
+// ============================================================================ PRIVATE CONSTANTS
+
+#define MEMORY_SITES_N                      1024
+#define MEMORY_UNKNOWN_SITE                 0
+#define MEMORY_BLOCKS_MIN_N                 4096
+#define MEMORY_SIZE_CLASSES_N               32
+#define MEMORY_REPORT_SITES_N               25
+#define MEMORY_REPORT_BAR_LENGTH            40
+#define MEMORY_SITE_NAME_LENGTH             256
+
+
+// ============================================================================ PRIVATE STRUCTURES
+
+// **************************************************************************** MemorySite
+
+// A call site that allocates memory and its statistics
+typedef struct MemorySite{
+    const char* file;
+    int line;
+
+    long long nAllocs;
+    long long nBytes;
+    long long nLive;
+    long long liveBytes;
+    long long peakBytes;
+}MemorySite;
+
+
+// **************************************************************************** MemoryBlock
+
+// A live heap block, in the hash table of the blocks. A NULL pointer is an 
+// empty slot
+typedef struct MemoryBlock{
+    const void* ptr;
+    int size;
+    int site;
+}MemoryBlock;
+
+
+// ============================================================================ PRIVATE VARIABLES
+
+static pthread_mutex_t memoryMutex = PTHREAD_MUTEX_INITIALIZER;
+
+// The hash table of the sites. The first site is the unknown site, for the 
+// allocations without a recorded call site or when the table is full
+static MemorySite memorySites[MEMORY_SITES_N] = {{.file = "(unknown)"}};
+static int memorySitesN = 1;
+
+static MemoryBlock* memoryBlocks = NULL;
+static int memoryBlocksCapacity = 0;
+static int memoryBlocksN = 0;
+
+// The number of allocations by size, in powers of 2
+static long long memorySizeClasses[MEMORY_SIZE_CLASSES_N];
+
+// The call site of the current thread, recorded by the outermost macro
+static _Thread_local const char* memorySiteFile = NULL;
+static _Thread_local int memorySiteLine = 0;
+static _Thread_local int memorySiteDepth = 0;
+
+
+// ============================================================================ PRIVATE FUNC DECL
+
+static void     Memory_TrackBlock(const void* oldPtr, const void* ptr, int size);
+static void     Memory_UntrackBlock(const void* ptr);
+static int      Memory_GetSite(const char* file, int line);
+static int      Memory_FindBlock(const void* ptr);
+static void     Memory_InsertBlock(MemoryBlock block);
+static void     Memory_RemoveBlock(int i);
+static int      Memory_CompareSites(const void* site1, const void* site2);
+static void     Memory_PrintSites(void);
+static void     Memory_PrintSizeClasses(void);
+static void     Memory_PrintLeaks(void);
+
+#endif
+
+
 // ============================================================================ FUNC DEF
 
 // **************************************************************************** Err_FatalError
@@ -58,17 +158,25 @@ void Err_Assert(int condition, const char* errorMsg){
 void* Memory_Allocate(void* ptr, int size, E_ZeroValMode zeroValMode){
     Err_Assert(size > 0, "Invalid memory size");
 
+    #ifdef MEMORY_TRACK
+        void* oldPtr = ptr;
+    #endif
+
     if (ptr == NULL){
-        #ifdef MEMORY_TRACK
-            Glo_AllocCount++;
-        #endif
+        Counter_Add(CNT_ALLOCS, 1);
+        Counter_Add(CNT_LIVE_BLOCKS, 1);
         ptr = malloc(size);
     }else{
         ptr = realloc(ptr, size);
     }
+    Counter_Add(CNT_ALLOC_BYTES, size);
 
     Err_Assert(ptr != NULL, "Failed to allocate memory");
 
+    #ifdef MEMORY_TRACK
+        Memory_TrackBlock(oldPtr, ptr, size);
+    #endif
+
     switch(zeroValMode){
         case ZEROVAL_ALL:{
             Memory_Set(ptr, size, 0);
@@ -125,8 +233,10 @@ void Memory_Set(void* ptr, int size, unsigned char value){
 // Free the memory at the given pointer. Return NULL
 void* Memory_Free(void* ptr){
     if (ptr != NULL){
+        Counter_Add(CNT_FREES, 1);
+        Counter_Add(CNT_LIVE_BLOCKS, -1);
         #ifdef MEMORY_TRACK
-            Glo_FreeCount++;
+            Memory_UntrackBlock(ptr);
         #endif
         free(ptr);
     }
@@ -155,17 +265,281 @@ void Memory_FreeAll(int nObjects, ...){
 
 
 #ifdef MEMORY_TRACK
+// **************************************************************************** Memory_BeginSite
+
+    // Record the call site of the allocations of the current thread, if no 
+    // outer call has recorded it. Called by the macros of Fund.h
+    void Memory_BeginSite(const char* file, int line){
+        if (memorySiteDepth++ == 0){
+            memorySiteFile = file;
+            memorySiteLine = line;
+        }
+    }
+
+
+// **************************************************************************** Memory_EndSite
+
+    // End the call that recorded the call site. Return the pointer, the result 
+    // of the call. Called by the macros of Fund.h
+    void* Memory_EndSite(void* ptr){
+        if (--memorySiteDepth == 0){
+            memorySiteFile = NULL;
+            memorySiteLine = 0;
+        }
+
+        return ptr;
+    }
+
+
 // **************************************************************************** Memory_Print
 
-    // Print the total number of memory allocations and deallocations
+    // Print the allocation profile: the totals, the busiest call sites, the 
+    // histogram of the allocation sizes and the live blocks, by call site
     void Memory_Print(void){
+        pthread_mutex_lock(&memoryMutex);
+
         PRINT_LINE
         printf("MEMORY REPORT:\n");
         PRINT_LINE
-        printf("Allocations:   %d\n", Glo_AllocCount);
-        printf("Deallocations: %d\n", Glo_FreeCount);
+        printf("Allocations:   %lld\n", Counter_Get(CNT_ALLOCS));
+        printf("Deallocations: %lld\n", Counter_Get(CNT_FREES));
+        printf("Bytes:         %lld\n", Counter_Get(CNT_ALLOC_BYTES));
+        printf("Live blocks:   %d\n", memoryBlocksN);
+        printf("Frames:        %lld\n", Counter_Get(CNT_FRAMES));
+        PRINT_LINE
+        Memory_PrintSites();
+        PRINT_LINE
+        Memory_PrintSizeClasses();
         PRINT_LINE
+        Memory_PrintLeaks();
+        PRINT_LINE
+
+        pthread_mutex_unlock(&memoryMutex);
     }
 #endif
 
 
+
+
+
+
+#ifdef MEMORY_TRACK
+// ============================================================================ PRIVATE FUNC DEF
+
+// **************************************************************************** Memory_TrackBlock
+
+// Record the block, allocated at the call site of the current thread. If it 
+// is reallocated, the old block is removed first
+static void Memory_TrackBlock(const void* oldPtr, const void* ptr, int size){
+    pthread_mutex_lock(&memoryMutex);
+
+    if (oldPtr != NULL){
+        int i = Memory_FindBlock(oldPtr);
+        if (i != INVALID) {Memory_RemoveBlock(i);}
+    }
+
+    int site = (memorySiteDepth > 0) ? Memory_GetSite(memorySiteFile, memorySiteLine) : MEMORY_UNKNOWN_SITE;
+    MemorySite* s = &memorySites[site];
+    s->nAllocs++;
+    s->nBytes += size;
+    s->nLive++;
+    s->liveBytes += size;
+    s->peakBytes = MAX(s->peakBytes, s->liveBytes);
+
+    int sizeClass = 0;
+    while (sizeClass < MEMORY_SIZE_CLASSES_N - 1 && (1 << sizeClass) < size) {sizeClass++;}
+    memorySizeClasses[sizeClass]++;
+
+    Memory_InsertBlock((MemoryBlock) {.ptr = ptr, .size = size, .site = site});
+
+    pthread_mutex_unlock(&memoryMutex);
+}
+
+
+// **************************************************************************** Memory_UntrackBlock
+
+// Remove the block, before it is freed. Blocks that were not allocated by 
+// Memory_Allocate are ignored
+static void Memory_UntrackBlock(const void* ptr){
+    pthread_mutex_lock(&memoryMutex);
+
+    int i = Memory_FindBlock(ptr);
+    if (i != INVALID) {Memory_RemoveBlock(i);}
+
+    pthread_mutex_unlock(&memoryMutex);
+}
+
+
+// **************************************************************************** Memory_GetSite
+
+// Return the index of the call site, adding it if it is new. Return the 
+// unknown site if the table is full
+static int Memory_GetSite(const char* file, int line){
+    if (file == NULL) {return MEMORY_UNKNOWN_SITE;}
+
+    unsigned int hash = (unsigned int) (((uintptr_t) file >> 3) * 31u + (unsigned int) line);
+    for (int n = 0; n < MEMORY_SITES_N; n++){
+        int i = (hash + n) % MEMORY_SITES_N;
+        if (i == MEMORY_UNKNOWN_SITE) {continue;}
+
+        MemorySite* site = &memorySites[i];
+        if (site->file == file && site->line == line) {return i;}
+
+        if (site->file == NULL){
+            if (memorySitesN >= MEMORY_SITES_N / 2) {return MEMORY_UNKNOWN_SITE;}
+
+            site->file = file;
+            site->line = line;
+            memorySitesN++;
+            return i;
+        }
+    }
+
+    return MEMORY_UNKNOWN_SITE;
+}
+
+
+// **************************************************************************** Memory_FindBlock
+
+// Return the index of the block in the hash table, or INVALID
+static int Memory_FindBlock(const void* ptr){
+    if (memoryBlocksCapacity == 0) {return INVALID;}
+
+    unsigned int mask = memoryBlocksCapacity - 1;
+    for (unsigned int i = ((uintptr_t) ptr >> 4) & mask; memoryBlocks[i].ptr != NULL; i = (i + 1) & mask){
+        if (memoryBlocks[i].ptr == ptr) {return i;}
+    }
+
+    return INVALID;
+}
+
+
+// **************************************************************************** Memory_InsertBlock
+
+// Insert the block in the hash table, doubling the table when it is half full
+static void Memory_InsertBlock(MemoryBlock block){
+    if (memoryBlocksN + 1 > memoryBlocksCapacity / 2){
+        MemoryBlock* oldBlocks = memoryBlocks;
+        int oldCapacity = memoryBlocksCapacity;
+
+        memoryBlocksCapacity = MAX(MEMORY_BLOCKS_MIN_N, oldCapacity * 2);
+        memoryBlocks = calloc(memoryBlocksCapacity, sizeof(MemoryBlock));
+        Err_Assert(memoryBlocks != NULL, "Failed to allocate memory for the profiler");
+
+        memoryBlocksN = 0;
+        for (int i = 0; i < oldCapacity; i++){
+            if (oldBlocks[i].ptr != NULL) {Memory_InsertBlock(oldBlocks[i]);}
+        }
+        free(oldBlocks);
+    }
+
+    unsigned int mask = memoryBlocksCapacity - 1;
+    unsigned int i = ((uintptr_t) block.ptr >> 4) & mask;
+    while (memoryBlocks[i].ptr != NULL) {i = (i + 1) & mask;}
+
+    memoryBlocks[i] = block;
+    memoryBlocksN++;
+}
+
+
+// **************************************************************************** Memory_RemoveBlock
+
+// Remove the block at the index from the hash table and from the live bytes 
+// of its site. The blocks after it are shifted back, to keep the table 
+// without gaps
+static void Memory_RemoveBlock(int i){
+    MemorySite* site = &memorySites[memoryBlocks[i].site];
+    site->nLive--;
+    site->liveBytes -= memoryBlocks[i].size;
+
+    unsigned int mask = memoryBlocksCapacity - 1;
+    unsigned int gap = i;
+    for (unsigned int j = (gap + 1) & mask; memoryBlocks[j].ptr != NULL; j = (j + 1) & mask){
+        unsigned int home = ((uintptr_t) memoryBlocks[j].ptr >> 4) & mask;
+
+        // The block can fill the gap if its home is not between the gap and it
+        if (((j - home) & mask) >= ((j - gap) & mask)){
+            memoryBlocks[gap] = memoryBlocks[j];
+            gap = j;
+        }
+    }
+
+    memoryBlocks[gap] = (MemoryBlock) {0};
+    memoryBlocksN--;
+}
+
+
+// **************************************************************************** Memory_CompareSites
+
+// Compare the sites at the indexes, for sorting them by allocations, the most 
+// first
+static int Memory_CompareSites(const void* site1, const void* site2){
+    long long n1 = memorySites[*(const int*) site1].nAllocs;
+    long long n2 = memorySites[*(const int*) site2].nAllocs;
+
+    return (n1 < n2) - (n1 > n2);
+}
+
+
+// **************************************************************************** Memory_PrintSites
+
+// Print the call sites with the most allocations
+static void Memory_PrintSites(void){
+    int order[MEMORY_SITES_N];
+    int n = 0;
+    for (int i = 0; i < MEMORY_SITES_N; i++){
+        if (memorySites[i].nAllocs > 0) {order[n++] = i;}
+    }
+    qsort(order, n, sizeof(int), Memory_CompareSites);
+
+    long long nFrames = MAX(1, Counter_Get(CNT_FRAMES));
+
+    printf("SITES (%d of %d, by allocations):\n", MIN(n, MEMORY_REPORT_SITES_N), n);
+    printf("%-36s %10s %10s %12s %10s %10s\n", "Site", "Allocs", "Per frame", "Bytes", "Live", "Peak");
+    for (int i = 0; i < MIN(n, MEMORY_REPORT_SITES_N); i++){
+        const MemorySite* site = &memorySites[order[i]];
+        char name[MEMORY_SITE_NAME_LENGTH];
+        snprintf(name, sizeof(name), "%s:%d", site->file, site->line);
+        printf("%-36s %10lld %10.2f %12lld %10lld %10lld\n", name, site->nAllocs,
+               (double) site->nAllocs / nFrames, site->nBytes, site->liveBytes, site->peakBytes);
+    }
+}
+
+
+// **************************************************************************** Memory_PrintSizeClasses
+
+// Print the histogram of the allocation sizes, in powers of 2
+static void Memory_PrintSizeClasses(void){
+    long long maxCount = 1;
+    for (int i = 0; i < MEMORY_SIZE_CLASSES_N; i++){
+        maxCount = MAX(maxCount, memorySizeClasses[i]);
+    }
+
+    printf("SIZES:\n");
+    for (int i = 0; i < MEMORY_SIZE_CLASSES_N; i++){
+        if (memorySizeClasses[i] == 0) {continue;}
+
+        int length = (int) ((memorySizeClasses[i] * MEMORY_REPORT_BAR_LENGTH + maxCount - 1) / maxCount);
+        printf("<= %10lld B %10lld ", 1LL << i, memorySizeClasses[i]);
+        for (int j = 0; j < length; j++) {printf("#");}
+        printf("\n");
+    }
+}
+
+
+// **************************************************************************** Memory_PrintLeaks
+
+// Print the live blocks by call site. At the end of the program, these are 
+// the leaks
+static void Memory_PrintLeaks(void){
+    printf("LIVE BLOCKS (%d):\n", memoryBlocksN);
+    for (int i = 0; i < MEMORY_SITES_N; i++){
+        const MemorySite* site = &memorySites[i];
+        if (site->nLive == 0) {continue;}
+
+        char name[MEMORY_SITE_NAME_LENGTH];
+        snprintf(name, sizeof(name), "%s:%d", site->file, site->line);
+        printf("%-36s %10lld blocks %12lld bytes\n", name, site->nLive, site->liveBytes);
+    }
+}
+#endif
@@ -22,6 +22,12 @@
 #include "Fund.h"
 
 
+// Time_ToString is defined here, not its call site macro
+#ifdef MEMORY_TRACK
+    #undef Time_ToString
+#endif
+
+
 // ============================================================================ FUNC DEF
 
 // **************************************************************************** Time_Set
@@ -158,15 +164,37 @@ Time Time_FromInt(int secs){
 
 // Turn the time to a string in the form [HH:]MM:SS
 char* Time_ToString(char* dst, Time t){
-    if (!Time_IsValid(t)){
-        return String_Copy(dst, TIME_INVALID_STR);
-    }
+    char buffer[TIME_STR_SIZE];
+    Time_Write(buffer, TIME_STR_SIZE, t);
+
+    return String_Copy(dst, buffer);
+}
+
 
+// **************************************************************************** Time_Write
+
+// Write the time as a string in the form [HH:]MM:SS in the buffer dst of the 
+// given size, without allocating memory. A buffer of TIME_STR_SIZE fits any 
+// time. Return the length of the string, or INVALID if it does not fit, 
+// leaving an empty string
+int Time_Write(char* dst, int size, Time t){
+    if (size <= 0) {return INVALID;}
+
+    const char* invalidStr = TIME_INVALID_STR;
     bool form = (t.hours > 0) ? LONG_FORM : SHORT_FORM;
+    int length = !Time_IsValid(t) ? String_Length(invalidStr) : (form == SHORT_FORM) ? 5 : 8;
 
-    dst = Memory_Allocate(dst, (form == SHORT_FORM) ? 6 : 9, ZEROVAL_LAST);
-    char* ptr = dst;
+    if (length + 1 > size){
+        dst[0] = '\0';
+        return INVALID;
+    }
 
+    if (!Time_IsValid(t)){
+        Memory_Write(dst, invalidStr, length + 1);
+        return length;
+    }
+
+    char* ptr = dst;
     for (int unit = HOURS; unit <= SECONDS; unit++){
         if (unit == HOURS && form == SHORT_FORM){
             continue;
@@ -182,8 +210,9 @@ char* Time_ToString(char* dst, Time t){
             ptr++;
         }
     }
+    *ptr = '\0';
 
-    return dst;
+    return length;
 }
 
 
@@ -192,9 +221,9 @@ char* Time_ToString(char* dst, Time t){
 
     // Print the time in the form [HH:]MM:SS. Optionally with new line
     void Time_Print(Time t, bool withNewLine){
-        char* str = Time_ToString(NULL, t);
+        char str[TIME_STR_SIZE];
+        Time_Write(str, TIME_STR_SIZE, t);
         printf("%s", str);
-        str = Memory_Free(str);
 
         if (withNewLine) {printf("\n");}
     }
@@ -0,0 +1,338 @@
+// ============================================================================
+// RODS
+// Trace
+// by Andreas Socratous
+// Jan 2023
+// ============================================================================
+
+
+// ============================================================================ INFO
+/*
+    Functions for recording a timeline of the program and exporting it as a
+    Chrome trace, that can be opened in chrome://tracing or Perfetto.
+
+    Tracing is turned on by setting the environment variable TRACE_ENV_VAR
+    to the path of the trace file. Otherwise every marker is a single test
+    of Glo_TraceIsOn, through the TRACE_BEGIN, TRACE_END and TRACE_INSTANT
+    macros.
+
+    Every thread records its markers in its own buffer, taken at its first
+    marker, so the threads never wait for each other. A buffer is a ring
+    with a single writer, its thread, and a single reader, the flush. When
+    a buffer is full, its markers are dropped until the next flush. The
+    buffers are allocated by Trace_Init, so the worker threads do not
+    allocate any memory. A thread keeps its buffer to the end, so only the
+    first TRACE_THREADS_N threads are traced.
+
+    The markers are written to the file by Trace_Flush, on the main thread,
+    and the buffers are emptied. The file is closed by Trace_Close. A file
+    that is not closed is still valid, since the closing bracket of the
+    array is optional in the trace format.
+*/
+
+
+// ============================================================================ FILE STRUCTURE
+/*
+    [
+    {"name":"<name>","ph":"B","ts":<us>,"pid":1,"tid":<thread>,"args":{"id":<arg>}},
+    {"ph":"E","ts":<us>,"pid":1,"tid":<thread>},
+    {"name":"<name>","ph":"i","s":"t","ts":<us>,"pid":1,"tid":<thread>},
+    ...
+    ]
+
+    The args are written only if the argument of the marker is not
+    TRACE_NO_ARG. The first marker of every thread is preceded by its name.
+*/
+
+
+// ============================================================================ DEPENDENCIES
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <raylib.h>
+
+#include "../Public/Public.h"
+#include "Fund.h"
+
+
+// ============================================================================ PRIVATE CONSTANTS
+
+#define TRACE_ENV_VAR                       "RODS_TRACE"
+#define TRACE_THREADS_N                     16
+#define TRACE_EVENTS_N                      (1 << 15)
+#define TRACE_MAIN_THREAD                   0
+
+
+// ============================================================================ PRIVATE STRUCTURES
+
+// **************************************************************************** TraceEvent
+
+// A marker: the begin or the end of a slice, or an instant
+typedef struct TraceEvent{
+    double time;
+    const char* name;
+    int arg;
+    char phase;
+}TraceEvent;
+
+
+// **************************************************************************** TraceBuffer
+
+// The ring of the markers of a thread. The head is moved only by the thread
+// and the tail only by the flush
+typedef struct TraceBuffer{
+    TraceEvent* events;
+    atomic_uint head;
+    atomic_uint tail;
+    atomic_int nDropped;
+    bool isNamed;
+}TraceBuffer;
+
+
+// ============================================================================ PRIVATE VARIABLES
+
+static TraceBuffer* traceBuffers = NULL;
+static atomic_int traceThreadsN = 0;
+static FILE* traceFile = NULL;
+static bool traceIsFirst = true;
+
+// The buffer of the current thread, or NULL before its first marker
+static _Thread_local TraceBuffer* traceThreadBuffer = NULL;
+static _Thread_local bool traceThreadIsUntraced = false;
+
+
+// ============================================================================ PRIVATE FUNC DECL
+
+static TraceBuffer* Trace_GetThreadBuffer(void);
+static void     Trace_Record(char phase, const char* name, int arg);
+static void     Trace_WriteBuffer(TraceBuffer* buffer, int thread);
+static void     Trace_WriteEvent(const TraceEvent* event, int thread);
+
+
+
+
+
+
+// ============================================================================ FUNC DEF
+
+// **************************************************************************** Trace_Init
+
+// Turn tracing on, if the environment variable TRACE_ENV_VAR holds the path
+// of the trace file. Called on the main thread, before any other thread starts
+void Trace_Init(void){
+    const char* path = getenv(TRACE_ENV_VAR);
+    if (path == NULL || path[0] == '\0') {return;}
+
+    traceFile = fopen(path, "w");
+    if (traceFile == NULL){
+        TraceLog(LOG_WARNING, "TRACE: Cannot write the trace file %s", path);
+        return;
+    }
+    fprintf(traceFile, "[\n");
+
+    traceBuffers = Memory_Allocate(NULL, sizeof(TraceBuffer) * TRACE_THREADS_N, ZEROVAL_ALL);
+    for (int i = 0; i < TRACE_THREADS_N; i++){
+        traceBuffers[i].events = Memory_Allocate(NULL, sizeof(TraceEvent) * TRACE_EVENTS_N, ZEROVAL_NONE);
+    }
+
+    Glo_TraceIsOn = true;
+
+    // The main thread takes the first buffer
+    Trace_GetThreadBuffer();
+
+    TraceLog(LOG_INFO, "TRACE: Tracing to %s", path);
+}
+
+
+// **************************************************************************** Trace_Close
+
+// Flush the markers, close the trace file and turn tracing off. Called on the
+// main thread, after all the other threads finish
+void Trace_Close(void){
+    if (!Glo_TraceIsOn) {return;}
+
+    Trace_Flush();
+    fprintf(traceFile, "\n]\n");
+    fclose(traceFile);
+    traceFile = NULL;
+
+    Glo_TraceIsOn = false;
+
+    for (int i = 0; i < TRACE_THREADS_N; i++){
+        traceBuffers[i].events = Memory_Free(traceBuffers[i].events);
+    }
+    traceBuffers = Memory_Free(traceBuffers);
+}
+
+
+// **************************************************************************** Trace_Begin
+
+// Record the begin of a slice on the current thread. The name must be a
+// string literal. The argument is written as the id of the slice, unless
+// it is TRACE_NO_ARG
+void Trace_Begin(const char* name, int arg){
+    Trace_Record('B', name, arg);
+}
+
+
+// **************************************************************************** Trace_End
+
+// Record the end of the last begun slice on the current thread
+void Trace_End(void){
+    Trace_Record('E', NULL, TRACE_NO_ARG);
+}
+
+
+// **************************************************************************** Trace_Instant
+
+// Record an instant on the current thread. The name must be a string literal
+void Trace_Instant(const char* name, int arg){
+    Trace_Record('i', name, arg);
+}
+
+
+// **************************************************************************** Trace_Flush
+
+// Write the recorded markers of all the threads to the trace file and empty
+// the buffers. Called on the main thread. Return true if successful
+bool Trace_Flush(void){
+    if (!Glo_TraceIsOn) {return false;}
+
+    int nThreads = MIN(atomic_load(&traceThreadsN), TRACE_THREADS_N);
+    int nDropped = 0;
+    for (int i = 0; i < nThreads; i++){
+        Trace_WriteBuffer(&traceBuffers[i], i);
+        nDropped += atomic_exchange(&traceBuffers[i].nDropped, 0);
+    }
+
+    if (nDropped > 0){
+        TraceLog(LOG_WARNING, "TRACE: Dropped %d markers, the buffers were full", nDropped);
+    }
+
+    return fflush(traceFile) == 0;
+}
+
+
+// **************************************************************************** Trace_WriteRecent
+
+// Write the last n markers of the current thread to the text file, oldest
+// first, one per line, with their time in ms before now. The markers stay
+// in the buffer after a flush, until they are overwritten
+void Trace_WriteRecent(FILE* file, int n){
+    TraceBuffer* buffer = Glo_TraceIsOn ? Trace_GetThreadBuffer() : NULL;
+    if (buffer == NULL){
+        fprintf(file, "%s\n", STR_NONE);
+        return;
+    }
+
+    unsigned int head = atomic_load_explicit(&buffer->head, memory_order_relaxed);
+    n = MIN(n, (int) MIN(head, TRACE_EVENTS_N));
+
+    double now = GetTime();
+    for (unsigned int i = head - n; i != head; i++){
+        const TraceEvent* event = &buffer->events[i % TRACE_EVENTS_N];
+        fprintf(file, "%9.3f %c %s", (now - event->time) * 1000.0, event->phase,
+                (event->name != NULL) ? event->name : "");
+        if (event->arg != TRACE_NO_ARG){
+            fprintf(file, " %d", event->arg);
+        }
+        fprintf(file, "\n");
+    }
+}
+
+
+
+
+
+
+// ============================================================================ PRIVATE FUNC DEF
+
+// **************************************************************************** Trace_GetThreadBuffer
+
+// Return the buffer of the current thread, taking a free buffer at the first
+// call. Return NULL if there is no free buffer
+static TraceBuffer* Trace_GetThreadBuffer(void){
+    if (traceThreadBuffer == NULL && !traceThreadIsUntraced){
+        int i = atomic_fetch_add(&traceThreadsN, 1);
+        if (i >= TRACE_THREADS_N){
+            traceThreadIsUntraced = true;
+            return NULL;
+        }
+
+        traceThreadBuffer = &traceBuffers[i];
+    }
+
+    return traceThreadBuffer;
+}
+
+
+// **************************************************************************** Trace_Record
+
+// Record a marker in the buffer of the current thread, or drop it if the
+// buffer is full
+static void Trace_Record(char phase, const char* name, int arg){
+    TraceBuffer* buffer = Trace_GetThreadBuffer();
+    if (buffer == NULL) {return;}
+
+    unsigned int head = atomic_load_explicit(&buffer->head, memory_order_relaxed);
+    unsigned int tail = atomic_load_explicit(&buffer->tail, memory_order_acquire);
+    if (head - tail >= TRACE_EVENTS_N){
+        atomic_fetch_add_explicit(&buffer->nDropped, 1, memory_order_relaxed);
+        return;
+    }
+
+    buffer->events[head % TRACE_EVENTS_N] = (TraceEvent) {
+        .time = GetTime(), .name = name, .arg = arg, .phase = phase
+    };
+
+    atomic_store_explicit(&buffer->head, head + 1, memory_order_release);
+}
+
+
+// **************************************************************************** Trace_WriteBuffer
+
+// Write the markers of the buffer to the trace file and empty it. The thread
+// is named before its first marker
+static void Trace_WriteBuffer(TraceBuffer* buffer, int thread){
+    unsigned int head = atomic_load_explicit(&buffer->head, memory_order_acquire);
+    unsigned int tail = atomic_load_explicit(&buffer->tail, memory_order_relaxed);
+    if (head == tail) {return;}
+
+    if (!buffer->isNamed){
+        fprintf(traceFile, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+                "\"args\":{\"name\":\"%s %d\"}}", traceIsFirst ? "" : ",\n", thread + 1,
+                thread == TRACE_MAIN_THREAD ? "Main" : "Worker", thread + 1);
+        traceIsFirst = false;
+        buffer->isNamed = true;
+    }
+
+    for (; tail != head; tail++){
+        Trace_WriteEvent(&buffer->events[tail % TRACE_EVENTS_N], thread);
+    }
+
+    atomic_store_explicit(&buffer->tail, tail, memory_order_release);
+}
+
+
+// **************************************************************************** Trace_WriteEvent
+
+// Write a marker to the trace file, as an object of the array
+static void Trace_WriteEvent(const TraceEvent* event, int thread){
+    fprintf(traceFile, "%s{", traceIsFirst ? "" : ",\n");
+    traceIsFirst = false;
+
+    if (event->name != NULL){
+        fprintf(traceFile, "\"name\":\"%s\",", event->name);
+    }
+    fprintf(traceFile, "\"ph\":\"%c\",", event->phase);
+    if (event->phase == 'i'){
+        fprintf(traceFile, "\"s\":\"t\",");
+    }
+    fprintf(traceFile, "\"ts\":%.1f,\"pid\":1,\"tid\":%d", event->time * 1000000.0, thread + 1);
+    if (event->arg != TRACE_NO_ARG){
+        fprintf(traceFile, ",\"args\":{\"id\":%d}", event->arg);
+    }
+
+    fprintf(traceFile, "}");
+}
@@ -9,6 +9,10 @@
 // ============================================================================ INFO
 /*
     Functions for managing the program's window.
+
+    In headless mode the window is hidden and the frames are drawn offscreen.
+    The clock of the program is then fixed by the caller at every frame, so 
+    the same frames are drawn at every run, however long they take.
 */
 
 
@@ -18,6 +22,8 @@
 #include <stdlib.h>
 #include <raylib.h>
 
+#include <time.h>
+
 #include "../Public/Public.h"
 #include "Fund.h"
 
@@ -29,6 +35,12 @@
 #define WIN_TITLE                           APP_TITLE " v" APP_VERSION
 
 
+// ============================================================================ PRIVATE VARIABLES
+
+// The time returned by Window_GetTime, or negative for the time of raylib
+static double windowFixedTime = -1.0;
+
+
 // ============================================================================ FUNC DEF
 
 // **************************************************************************** Window_Init
@@ -44,6 +56,18 @@ void Window_Init(void){
 }
 
 
+// **************************************************************************** Window_InitHidden
+
+// Initialize the program's window for headless mode, hidden and with the 
+// given size. The frames are not limited to FPS
+void Window_InitHidden(Size size){
+    Glo_WinSize = size;
+
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(Glo_WinSize.width, Glo_WinSize.height, WIN_TITLE);
+}
+
+
 // **************************************************************************** Window_GetSize
 
 // Return the current size of the window
@@ -60,6 +84,37 @@ void Window_UpdateWinSize(void){
 }
 
 
+// **************************************************************************** Window_SkipFrame
+
+// Poll the input events and sleep for the given time, instead of drawing a 
+// frame. Unlike the frame limiter of raylib, the sleep does not busy wait
+void Window_SkipFrame(double seconds){
+    PollInputEvents();
+
+    struct timespec duration = {.tv_sec = (time_t) seconds, 
+                                .tv_nsec = (long) ((seconds - (double) (time_t) seconds) * 1.0e9)};
+    nanosleep(&duration, NULL);
+}
+
+
+// **************************************************************************** Window_GetTime
+
+// Return the time in seconds since the window was initialized, or the fixed 
+// time, if it is set
+double Window_GetTime(void){
+    return (windowFixedTime >= 0.0) ? windowFixedTime : GetTime();
+}
+
+
+// **************************************************************************** Window_SetFixedTime
+
+// Fix the time returned by Window_GetTime. A negative time returns to the 
+// time since the window was initialized
+void Window_SetFixedTime(double t){
+    windowFixedTime = t;
+}
+
+
 // **************************************************************************** Window_Close
 
 // Close the program's window
@@ -211,6 +211,16 @@ Event Event_SetAsVictory(E_GuiID source){
 }
 
 
+// **************************************************************************** Event_SetAsMinimapChanged
+
+// Set a minimap changed event. The ratios give the point of the virtual 
+// screen, that the viewport should be centered at
+Event Event_SetAsMinimapChanged(E_GadgetID source, float xRatio, float yRatio){
+    return ((Event) {.id = EVENT_MINIMAP_CHANGED, .source = source, .target = GDG_NONE, .isProcessed = false,
+                     .data.minimap.xRatio = xRatio, .data.minimap.yRatio = yRatio});
+}
+
+
 #ifdef DEBUG_MODE
 // **************************************************************************** Event_Print
 
@@ -288,6 +298,13 @@ Event Event_SetAsVictory(E_GuiID source){
                 break;
             }
 
+            case EVENT_MINIMAP_CHANGED:{
+                PRINT_DATA_SEP
+                printf("X Ratio: %.3f, ", event.data.minimap.xRatio);
+                printf("Y Ratio: %.3f", event.data.minimap.yRatio);
+                break;
+            }
+
             default: {break;}
         }
 
@@ -50,6 +50,7 @@ Event           Event_SetAsGadgetExpanded(E_GadgetID source);
 Event           Event_SetAsGadgetCollapsed(E_GadgetID source);
 Event           Event_SetAsMakeNewGrid(E_GuiID source, E_GuiID target, int nCols, int nRows);
 Event           Event_SetAsVictory(E_GuiID source);
+Event           Event_SetAsMinimapChanged(E_GadgetID source, float xRatio, float yRatio);
 #ifdef DEBUG_MODE
     void        Event_Print(Event event, bool withNewLine);
 #endif
@@ -63,6 +64,7 @@ Event           Queue_GetNext(EventQueue* queue);
 void            Queue_AddEvent(EventQueue* queue, Event event);
 void            Queue_MarkLastEventAsProcessed(EventQueue* queue);
 void            Queue_SetUserInput(EventQueue* queue, Event event);
+void            Queue_WriteToFile(const EventQueue* queue, FILE* file);
 #ifdef DEBUG_MODE
     void        Queue_Print(EventQueue* queue);
 #endif
@@ -75,9 +77,12 @@ Event           Event_GetUserInput(void);
 
 Gadget*         Gadget_Make(E_GadgetID id, E_GadgetType type, bool isSelectable, int nSubGadgets);
 Gadget*         Gadget_Free(Gadget* gadget);
+void*           Gadget_AllocateData(int size);
+void            Gadget_FreePools(void);
 void            Gadget_Resize(Gadget* gadget);
 void            Gadget_ReactToEvent(Gadget* gadget, Event event, EventQueue* queue);
 void            Gadget_Update(Gadget* gadget, EventQueue* queue);
+bool            Gadget_IsAnimating(const Gadget* gadget);
 void            Gadget_Draw(const Gadget* gadget, Vector2 shift);
 bool            Gadget_SelectNext(Gadget* gadget);
 void            Gadget_Deselect(Gadget* gadget);
@@ -89,6 +94,8 @@ void            Gadget_Deselect(Gadget* gadget);
 
 Page*           Page_Make(E_PageID id);
 Page*           Page_Free(Page* page);
+void*           Page_AllocateData(int size);
+void            Page_FreeArena(void);
 bool            Page_AddGadget(Page* page, Gadget* gadget);
 void            Page_Resize(Page* page);
 void            Page_ReactToEvent(Page* page, Event event, EventQueue* queue);
@@ -99,6 +106,7 @@ void            Page_DeselectAllGadgets(const Page* page);
 void            Page_Show(Page* page, Event event, bool withAnim);
 void            Page_Hide(Page* page, bool withAnim);
 bool            Page_IsAnimating(const Page* page);
+bool            Page_IsStill(const Page* page);
 void            Page_FinishTransitionAnim(Page* page);
 #ifdef DEBUG_MODE
     void        Page_Print(const Page* page);
@@ -112,11 +120,38 @@ void            Router_AddPage(Router* router, Page* page);
 Page*           Router_GetPage(const Router* router, E_PageID pageID);
 void            Router_ShowPage(const Router* router, Event event, E_PageID pageID, bool withAnim);
 void            Router_HidePage(const Router* router, E_PageID pageID, bool withAnim);
+bool            Router_RunFrame(const Router* router);
+void            Router_DrawFrame(const Router* router);
 void            Router_Loop(const Router* router);
 #ifdef DEBUG_MODE
     void        Router_Print(const Router* router);
 #endif
 
+// ---------------------------------------------------------------------------- Headless Functions
+
+bool            Headless_IsRequested(int argc, char** argv);
+void            Headless_Init(void);
+int             Headless_Run(const Router* router, int argc, char** argv);
+
+// ---------------------------------------------------------------------------- Profiler Functions
+
+void            Prof_Toggle(void);
+bool            Prof_IsOn(void);
+void            Prof_BeginFrame(void);
+void            Prof_EndFrame(void);
+double          Prof_Begin(void);
+double          Prof_End(E_ProfPhase phase, double start);
+void            Prof_EndGadgetUpdate(E_GadgetType type, double start);
+void            Prof_EndGadgetDraw(E_GadgetType type, double start);
+void            Prof_Draw(void);
+
+// ---------------------------------------------------------------------------- Watchdog Functions
+
+void            Watchdog_Init(RGrid* (*GetRGrid)(const Page* page));
+void            Watchdog_Close(void);
+void            Watchdog_BeginFrame(void);
+void            Watchdog_EndFrame(const Router* router);
+
 
 
 
@@ -9,6 +9,12 @@
 // ============================================================================ INFO
 /*
     Generic functions, common to all gadgets.
+
+    The gadgets and their data are taken from pools, since gadgets like the 
+    cells of tables and the contents of buttons are made and freed while the 
+    program runs. The data of a gadget is taken from the data pool if it fits 
+    in GADGET_DATA_SIZE bytes, or else from the heap. The pools are made at 
+    the first gadget and freed by Gadget_FreePools, after all the gadgets.
 */
 
 
@@ -23,13 +29,38 @@
 #include "GUI.h"
 
 
+// ============================================================================ PRIVATE CONSTANTS
+
+#define GADGET_DATA_SIZE                    128
+#define GADGET_POOL_CHUNK_N                 64
+
+
+// ============================================================================ PRIVATE VARIABLES
+
+static Pool* gadgetPool = NULL;
+static Pool* gadgetDataPool = NULL;
+
+
+// ============================================================================ PRIVATE FUNC DECL
+
+static void*    Gadget_FreeData(void* data);
+
+
+
+
+
+
 // ============================================================================ FUNC DEF
 
 // **************************************************************************** Gadget_Make
 
 // Allocate memory for the gadget
 Gadget* Gadget_Make(E_GadgetID id, E_GadgetType type, bool isSelectable, int nSubGadgets){
-    Gadget* gadget = Memory_Allocate(NULL, sizeof(Gadget), ZEROVAL_ALL);
+    if (gadgetPool == NULL){
+        gadgetPool = Pool_Make(sizeof(Gadget), GADGET_POOL_CHUNK_N);
+    }
+
+    Gadget* gadget = Pool_Allocate(gadgetPool, ZEROVAL_ALL);
 
     gadget->id = id;
     gadget->type = type;
@@ -61,9 +92,41 @@ Gadget* Gadget_Free(Gadget* gadget){
     }
     gadget->subGadgets = Memory_Free(gadget->subGadgets);
 
-    gadget->data = Memory_Free(gadget->data);
+    gadget->data = Gadget_FreeData(gadget->data);
 
-    return Memory_Free(gadget);
+    return Pool_Deallocate(gadgetPool, gadget);
+}
+
+
+// **************************************************************************** Gadget_AllocateData
+
+// Allocate memory for the data of a gadget, with all the values set to 0. 
+// The data is freed with the gadget
+void* Gadget_AllocateData(int size){
+    if (size > GADGET_DATA_SIZE){
+        return Memory_Allocate(NULL, size, ZEROVAL_ALL);
+    }
+
+    if (gadgetDataPool == NULL){
+        gadgetDataPool = Pool_Make(GADGET_DATA_SIZE, GADGET_POOL_CHUNK_N);
+    }
+
+    return Pool_Allocate(gadgetDataPool, ZEROVAL_ALL);
+}
+
+
+// **************************************************************************** Gadget_FreePools
+
+// Free the pools of the gadgets and their data. Called after all the gadgets 
+// are freed
+void Gadget_FreePools(void){
+    int nUsed = Pool_GetNumUsed(gadgetPool) + Pool_GetNumUsed(gadgetDataPool);
+    if (nUsed > 0){
+        TraceLog(LOG_WARNING, "GADGET: %d gadgets or gadget data not freed", nUsed);
+    }
+
+    gadgetPool = Pool_Free(gadgetPool);
+    gadgetDataPool = Pool_Free(gadgetDataPool);
 }
 
 
@@ -108,7 +171,9 @@ void Gadget_ReactToEvent(Gadget* gadget, Event event, EventQueue* queue){
 // Update the gadget and optionally add events to the queue
 void Gadget_Update(Gadget* gadget, EventQueue* queue){
     if (gadget->Update != NULL){
+        double start = Prof_Begin();
         gadget->Update(gadget, queue);
+        Prof_EndGadgetUpdate(gadget->type, start);
     }
 
     for (int i = 0; i < gadget->nSubGadgets; i++){
@@ -117,6 +182,24 @@ void Gadget_Update(Gadget* gadget, EventQueue* queue){
 }
 
 
+// **************************************************************************** Gadget_IsAnimating
+
+// Return true if the gadget or any of its subgadgets is animating
+bool Gadget_IsAnimating(const Gadget* gadget){
+    if (gadget->IsAnimating != NULL && gadget->IsAnimating(gadget)){
+        return true;
+    }
+
+    for (int i = 0; i < gadget->nSubGadgets; i++){
+        if (Gadget_IsAnimating(gadget->subGadgets[i])){
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
 // **************************************************************************** Gadget_Draw
 
 // Draw the gadget
@@ -126,7 +209,9 @@ void Gadget_Draw(const Gadget* gadget, Vector2 shift){
     }
 
     if (gadget->Draw != NULL){
+        double start = Prof_Begin();
         gadget->Draw(gadget, shift);
+        Prof_EndGadgetDraw(gadget->type, start);
     }
 
     for (int i = 0; i < gadget->nSubGadgets; i++){
@@ -222,6 +307,7 @@ void Gadget_Deselect(Gadget* gadget){
         printf("   ResizeAfterSubGadgets: %p\n", (void*) gadget->ResizeAfterSubgadgets);
         printf("   ReactToEvent:          %p\n", (void*) gadget->ReactToEvent);
         printf("   Update:                %p\n", (void*) gadget->Update);
+        printf("   IsAnimating:           %p\n", (void*) gadget->IsAnimating);
         printf("   ChangeShift:           %p\n", (void*) gadget->ChangeShift);
         printf("   Draw:                  %p\n", (void*) gadget->Draw);
         printf("   PrintData:             %p\n", (void*) gadget->PrintData);
@@ -237,3 +323,19 @@ void Gadget_Deselect(Gadget* gadget){
 #endif
 
 
+
+
+
+
+// ============================================================================ PRIVATE FUNC DEF
+
+// **************************************************************************** Gadget_FreeData
+
+// Free the data of a gadget, in the data pool or on the heap. Return NULL
+static void* Gadget_FreeData(void* data){
+    if (Pool_Owns(gadgetDataPool, data)){
+        return Pool_Deallocate(gadgetDataPool, data);
+    }
+
+    return Memory_Free(data);
+}
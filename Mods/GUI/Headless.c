@@ -0,0 +1,313 @@
+// ============================================================================
+// RODS
+// Headless
+// by Andreas Socratous
+// Jan 2023
+// ============================================================================
+
+
+// ============================================================================ INFO
+/*
+    Functions for running the program in headless mode, for rendering
+    benchmarks and golden image tests on machines without a visible display,
+    like a Linux box with Xvfb and a software renderer.
+
+    In headless mode the window is hidden and the router runs a script of
+    steps, without reading or writing any data file. The font and the
+    textures are generated instead of read from their cache files. Every step
+    shows a page, hiding the pages above it, and runs a number of frames. The
+    frames are drawn in the framebuffer of the hidden window, like in the
+    normal loop, so the rod cache can draw in its own render textures. The
+    last frame of every step is read back before the buffers are swapped and
+    saved as a PNG file. The time of every frame is written in a CSV file.
+
+    The random generator is seeded with a fixed seed and the clock of the
+    program advances by exactly one frame at every frame, so the same script
+    draws the same frames at every run. The timings are measured with the
+    real clock. The draw time is the time to make and submit the frame; the
+    GPU is waited for only when a frame is saved.
+
+    USAGE:
+        rods --headless <output dir> [<page>:<frames> ...]
+
+        The pages are main, game, setup, help and info. Without any step,
+        every page is shown for HEADLESS_DEF_FRAMES_N frames.
+*/
+
+
+// ============================================================================ FILE STRUCTURE
+/*
+    OUTPUT DIR:
+        <step>_<page>.png       The last frame of every step, from 01
+        timings.csv             One line per frame, after a header line
+        counters.json           The runtime counters of the run, see Counter.c
+
+    TIMINGS LINE:
+        frame,step,page,update_ms,draw_ms
+*/
+
+
+// ============================================================================ DEPENDENCIES
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <raylib.h>
+#include <rlgl.h>
+
+#include "../Public/Public.h"
+#include "../Fund/Fund.h"
+#include "../Graph/Graph.h"
+#include "GUI.h"
+
+
+// ============================================================================ PRIVATE CONSTANTS
+
+#define HEADLESS_ARG                        "--headless"
+#define HEADLESS_WIN_SIZE                   SIZE(800, 600)
+#define HEADLESS_SEED                       1
+#define HEADLESS_DEF_FRAMES_N               60
+#define HEADLESS_MAX_FRAMES_N               100000
+#define HEADLESS_MAX_STEPS_N                100
+#define HEADLESS_STEP_SEP                   ':'
+#define HEADLESS_TIMINGS_FILE_NAME          "timings.csv"
+#define HEADLESS_COUNTERS_FILE_NAME         "counters.json"
+#define HEADLESS_FRAME_NAME_SIZE            32
+
+
+// ============================================================================ PRIVATE VARIABLES
+
+// The names of the pages in the script
+static const char* headlessPageNames[PAGE_INFO + 1] = {
+    "main", "game", "setup", "help", "info"
+};
+
+
+// ============================================================================ PRIVATE STRUCTURES
+
+// **************************************************************************** HeadlessStep
+
+// A step of the script: the page that is shown and the number of frames
+typedef struct HeadlessStep{
+    E_PageID pageID;
+    int nFrames;
+}HeadlessStep;
+
+
+// ============================================================================ PRIVATE FUNC DECL
+
+static int      Headless_ParseScript(int argc, char** argv, HeadlessStep* steps);
+static bool     Headless_ParseStep(const char* arg, HeadlessStep* step);
+static void     Headless_ShowPage(const Router* router, E_PageID pageID);
+static bool     Headless_SaveFrame(const char* dir, int step, E_PageID pageID);
+
+
+
+
+
+
+// ============================================================================ FUNC DEF
+
+// **************************************************************************** Headless_IsRequested
+
+// Return true if the program is started in headless mode
+bool Headless_IsRequested(int argc, char** argv){
+    return argc >= 2 && String_IsEqual(argv[1], HEADLESS_ARG);
+}
+
+
+// **************************************************************************** Headless_Init
+
+// Initialize the hidden window, the random generator and the clock for
+// headless mode. Called instead of Window_Init
+void Headless_Init(void){
+    Window_InitHidden(HEADLESS_WIN_SIZE);
+    Math_SetRandomSeed(HEADLESS_SEED);
+    Window_SetFixedTime(0.0);
+}
+
+
+// **************************************************************************** Headless_Run
+
+// Run the script of the command line arguments, saving the frames and the
+// timings in the output directory. Return the exit code of the program
+int Headless_Run(const Router* router, int argc, char** argv){
+    HeadlessStep steps[HEADLESS_MAX_STEPS_N];
+    int nSteps = Headless_ParseScript(argc, argv, steps);
+    if (nSteps <= 0){
+        fprintf(stderr, "Usage: %s %s <output dir> [<page>:<frames> ...]\n", argv[0], HEADLESS_ARG);
+        return 1;
+    }
+
+    const char* dir = argv[2];
+    char* path = String_Concat(NULL, 3, dir, "/", HEADLESS_TIMINGS_FILE_NAME);
+    FILE* timings = fopen(path, "w");
+    path = Memory_Free(path);
+    if (timings == NULL){
+        fprintf(stderr, "Cannot write in the output directory %s\n", dir);
+        return 1;
+    }
+
+    fprintf(timings, "frame,step,page,update_ms,draw_ms\n");
+
+    bool res = true;
+
+    int frame = 0;
+    for (int step = 0; res && step < nSteps; step++){
+        Headless_ShowPage(router, steps[step].pageID);
+
+        for (int i = 0; i < steps[step].nFrames; i++, frame++){
+            Window_SetFixedTime((double) frame / (double) FPS);
+
+            Scratch_Reset();
+            Counter_BeginFrame();
+
+            double startTime = GetTime();
+            Router_RunFrame(router);
+            double updateTime = GetTime();
+
+            BeginDrawing();
+            Router_DrawFrame(router);
+            double drawTime = GetTime();
+
+            // The last frame of the step is saved before it is swapped out
+            if (i == steps[step].nFrames - 1){
+                res = Headless_SaveFrame(dir, step, steps[step].pageID);
+            }
+            EndDrawing();
+            Counter_Add(CNT_FRAMES_DRAWN, 1);
+
+            fprintf(timings, "%d,%d,%s,%.3f,%.3f\n", frame, step + 1, headlessPageNames[steps[step].pageID],
+                    (updateTime - startTime) * 1000.0, (drawTime - updateTime) * 1000.0);
+        }
+    }
+
+    res = (fclose(timings) == 0) && res;
+
+    path = String_Concat(NULL, 3, dir, "/", HEADLESS_COUNTERS_FILE_NAME);
+    res = Counter_WriteToFile(path) && res;
+    path = Memory_Free(path);
+
+    TraceLog(res ? LOG_INFO : LOG_ERROR, "HEADLESS: %s after %d frames in %d steps",
+             res ? "Finished" : "Failed", frame, nSteps);
+
+    return res ? 0 : 1;
+}
+
+
+
+
+
+
+// ============================================================================ PRIVATE FUNC DEF
+
+// **************************************************************************** Headless_ParseScript
+
+// Parse the output directory and the steps of the script from the command
+// line arguments. Without any step, show every page. Return the number of
+// steps, or 0 if the arguments are invalid
+static int Headless_ParseScript(int argc, char** argv, HeadlessStep* steps){
+    if (argc < 3 || argc - 3 > HEADLESS_MAX_STEPS_N) {return 0;}
+
+    if (argc == 3){
+        for (int pageID = 0; pageID <= PAGE_INFO; pageID++){
+            steps[pageID] = (HeadlessStep) {.pageID = pageID, .nFrames = HEADLESS_DEF_FRAMES_N};
+        }
+        return PAGE_INFO + 1;
+    }
+
+    for (int i = 3; i < argc; i++){
+        if (!Headless_ParseStep(argv[i], &steps[i - 3])){
+            fprintf(stderr, "Invalid step: %s\n", argv[i]);
+            return 0;
+        }
+    }
+
+    return argc - 3;
+}
+
+
+// **************************************************************************** Headless_ParseStep
+
+// Parse a step of the script, in the form <page>:<frames>. Return false if it
+// is invalid
+static bool Headless_ParseStep(const char* arg, HeadlessStep* step){
+    int sep = 0;
+    while (arg[sep] != '\0' && arg[sep] != HEADLESS_STEP_SEP) {sep++;}
+    if (arg[sep] != HEADLESS_STEP_SEP) {return false;}
+
+    // The page name is the part before the separator
+    bool isFound = false;
+    for (int pageID = 0; pageID <= PAGE_INFO && !isFound; pageID++){
+        const char* name = headlessPageNames[pageID];
+        if (String_Length(name) != sep) {continue;}
+
+        isFound = true;
+        for (int i = 0; i < sep && isFound; i++){
+            isFound = (name[i] == arg[i]);
+        }
+        if (isFound) {step->pageID = pageID;}
+    }
+    if (!isFound) {return false;}
+
+    // The number of frames is the part after the separator
+    const char* digits = arg + sep + 1;
+    if (*digits == '\0') {return false;}
+
+    step->nFrames = 0;
+    for (; *digits != '\0'; digits++){
+        if (!IS_IN_RANGE(*digits, '0', '9')) {return false;}
+        step->nFrames = step->nFrames * 10 + (*digits - '0');
+        if (step->nFrames > HEADLESS_MAX_FRAMES_N) {return false;}
+    }
+
+    return step->nFrames > 0;
+}
+
+
+// **************************************************************************** Headless_ShowPage
+
+// Show the page, with animation, and hide all the shown pages above it. The 
+// pages below it stay as they are
+static void Headless_ShowPage(const Router* router, E_PageID pageID){
+    for (int i = PAGES_N - 1; i > (int) pageID; i--){
+        if (router->pages[i] != NULL && router->pages[i]->isShown){
+            Queue_AddEvent(router->queue, Event_SetAsHidePage(pageID, i, WITH_ANIM));
+        }
+    }
+
+    if (router->pages[pageID] != NULL && !router->pages[pageID]->isShown){
+        Queue_AddEvent(router->queue, Event_SetAsShowPage(pageID, pageID, WITH_ANIM));
+    }
+}
+
+
+// **************************************************************************** Headless_SaveFrame
+
+// Save the frame drawn in the framebuffer as a PNG file, named after the step
+// and the page. Called before EndDrawing. Return true if successful
+static bool Headless_SaveFrame(const char* dir, int step, E_PageID pageID){
+    StrBuf path = StrBuf_MakeInScratch(String_Length(dir) + HEADLESS_FRAME_NAME_SIZE);
+    StrBuf_Append(&path, dir);
+    StrBuf_AppendChar(&path, '/');
+    StrBuf_AppendInt(&path, step + 1, 2);
+    StrBuf_AppendChar(&path, '_');
+    StrBuf_Append(&path, headlessPageNames[pageID]);
+    StrBuf_Append(&path, ".png");
+
+    // The batch is drawn first, since the framebuffer is read directly
+    rlDrawRenderBatchActive();
+    Image im = LoadImageFromScreen();
+    bool res = ExportImage(im, path.str);
+    UnloadImage(im);
+
+    if (!res){
+        TraceLog(LOG_ERROR, "HEADLESS: Failed to save %s", path.str);
+    }
+
+    path.str = Scratch_Free(path.str);
+
+    return res;
+}
+
+
+
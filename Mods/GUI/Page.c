@@ -9,6 +9,11 @@
 // ============================================================================
 /*
     Generic functions for managing pages.
+
+    The pages and their data live as long as the program, so they are taken 
+    from the page arena, that is made at the first page and freed by 
+    Page_FreeArena, after all the pages. A freed page is not given back to 
+    the arena.
 */
 
 
@@ -26,6 +31,12 @@
 // ============================================================================ PRIVATE CONSTANTS
 
 #define TRANS_ANIM_FRAMES_N                 ((FPS * 1) / 4)
+#define PAGE_ARENA_SIZE                     (16 * 1024)
+
+
+// ============================================================================ PRIVATE VARIABLES
+
+static Arena* pageArena = NULL;
 
 
 // ============================================================================ PRIVATE FUNC DECL
@@ -43,7 +54,7 @@ static void     Page_UpdateTransAnim(Page* page);
 
 // Allocate memory for a page and initialize it with the given page id
 Page* Page_Make(E_PageID id){
-    Page* page = Memory_Allocate(NULL, sizeof(Page), ZEROVAL_ALL);
+    Page* page = Page_AllocateData(sizeof(Page));
 
     page->id = id;
 
@@ -53,7 +64,8 @@ Page* Page_Make(E_PageID id){
 
 // **************************************************************************** Page_Free
 
-// Free the memory of the page
+// Free the gadgets of the page. The page and its data stay in the page arena,
+// until Page_FreeArena. Return NULL
 Page* Page_Free(Page* page){
     if (page == NULL) {return NULL;}
 
@@ -65,9 +77,30 @@ Page* Page_Free(Page* page){
         page->gadgets[i] = Gadget_Free(page->gadgets[i]);
     }
 
-    page->data = Memory_Free(page->data);
+    page->data = NULL;
+
+    return NULL;
+}
+
+
+// **************************************************************************** Page_AllocateData
+
+// Allocate memory for the data of a page in the page arena, with all the 
+// values set to 0. The data is freed with the arena
+void* Page_AllocateData(int size){
+    if (pageArena == NULL){
+        pageArena = Arena_Make(PAGE_ARENA_SIZE);
+    }
+
+    return Arena_Allocate(pageArena, size, ZEROVAL_ALL);
+}
+
+
+// **************************************************************************** Page_FreeArena
 
-    return Memory_Free(page);
+// Free the page arena. Called after all the pages are freed
+void Page_FreeArena(void){
+    pageArena = Arena_Free(pageArena);
 }
 
 
@@ -246,6 +279,24 @@ bool Page_IsAnimating(const Page* page){
 }
 
 
+// **************************************************************************** Page_IsStill
+
+// Return true if the page is hidden, or shown without transition animation 
+// and without any animating gadget
+bool Page_IsStill(const Page* page){
+    if (page == NULL || !page->isShown) {return true;}
+    if (page->shiftIncr != 0.0f)        {return false;}
+
+    for (int i = 0; i < page->nGadgets; i++){
+        if (Gadget_IsAnimating(page->gadgets[i])){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
 // **************************************************************************** Page_finishTr
 void Page_FinishTransitionAnim(Page* page){
     page->shift = VECTOR_NULL;
@@ -0,0 +1,357 @@
+// ============================================================================
+// RODS
+// Profiler
+// by Andreas Socratous
+// Jan 2023
+// ============================================================================
+
+
+// ============================================================================ INFO
+/*
+    Functions for the frame profiler and its overlay.
+
+    The profiler times the phases of every drawn frame and the update and
+    draw callbacks of the gadgets, by type, and keeps the times of the last
+    PROF_FRAMES_N frames. The overlay, toggled with WKEY_P, shows the times
+    of the frames as stacked bars, one color per phase, the p50, p95 and max
+    time of the frames and the mean time of every phase and of the slowest
+    gadget types.
+
+    The frame time is the sum of the phases, the work of the program in the
+    frame. EndDrawing is not timed, since it waits for the FPS limiter. The
+    draw times are the time to make and submit the draw calls, not the time
+    of the GPU. The frames that are skipped in idle mode are not counted.
+
+    When the profiler is off, every timer is a single test. The profiler is
+    turned on or off at the start of a frame, so no frame is timed in part.
+*/
+
+
+// ============================================================================ DEPENDENCIES
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <raylib.h>
+
+#include "../Public/Public.h"
+#include "../Fund/Fund.h"
+#include "../Graph/Graph.h"
+#include "GUI.h"
+
+
+// ============================================================================ PRIVATE CONSTANTS
+
+#define PROF_FRAMES_N                       120
+#define PROF_TOP_GADGETS_N                  3
+#define PROF_BAR_WIDTH                      2.0f
+#define PROF_GRAPH_HEIGHT                   80.0f
+#define PROF_GRAPH_MAX_MS                   (2000.0f / FPS)
+#define PROF_BUDGET_MS                      (1000.0f / FPS)
+#define PROF_FONT_SIZE                      14.0f
+#define PROF_LINE_HEIGHT                    16.0f
+#define PROF_PADDING                        8.0f
+#define PROF_LINE_LENGTH                    64
+
+#define PROF_PANEL_WIDTH                    (PROF_FRAMES_N * PROF_BAR_WIDTH + 2.0f * PROF_PADDING)
+#define PROF_LINES_N                        (1 + PROF_PHASES_N + PROF_TOP_GADGETS_N)
+#define PROF_PANEL_HEIGHT                   (PROF_GRAPH_HEIGHT + PROF_LINES_N * PROF_LINE_HEIGHT + \
+                                             3.0f * PROF_PADDING)
+
+#define COL_PROF_BG                         COLOR(0x0B, 0x0B, 0x0B, 0xD0)
+#define COL_PROF_BUDGET                     COLOR(0xBB, 0x33, 0x33, 0xFF)
+
+
+// ============================================================================ PRIVATE VARIABLES
+
+// The names of the phases and the gadget types in the overlay
+static const char* profPhaseNames[PROF_PHASES_N] = {
+    "Resize",  "MCol",       "FRects",
+    "Music",   "Events",     "Update",
+    "Draw BG", "Draw Pages", "Overlay"
+};
+
+static const char* profGadgetNames[GADGET_TYPES_N] = {
+    "Generic", "Board",     "Label",
+    "Button",  "Scrollbar", "Switch",
+    "NumBox",  "Timer",     "Icon",
+    "Table",   "Toolbar",   "Minimap"
+};
+
+// The colors of the phases in the bars
+static const Color profPhaseColors[PROF_PHASES_N] = {
+    {0x80, 0x80, 0x80, 0xFF}, {0xB0, 0x60, 0xD0, 0xFF}, {0x55, 0x88, 0xDD, 0xFF},
+    {0x40, 0xC0, 0xC0, 0xFF}, {0xF4, 0xE1, 0x5A, 0xFF}, {0xFB, 0xA5, 0x4A, 0xFF},
+    {0x60, 0x60, 0x60, 0xFF}, {0x2E, 0xA0, 0x5D, 0xFF}, {0xB6, 0xB6, 0xB6, 0xFF}
+};
+
+static bool profIsOn = false;
+static bool profIsRequested = false;
+
+// The times of the current frame, in ms
+static float profPhaseTimes[PROF_PHASES_N];
+static float profGadgetTimes[GADGET_TYPES_N][2];
+
+// The rings of the times of the last frames, in ms
+static float profPhaseRing[PROF_FRAMES_N][PROF_PHASES_N];
+static float profGadgetRing[PROF_FRAMES_N][GADGET_TYPES_N][2];
+static int profRingStart = 0;
+static int profRingN = 0;
+
+
+// ============================================================================ PRIVATE FUNC DECL
+
+static void     Prof_Clear(void);
+static float    Prof_GetFrameTime(int frame);
+static void     Prof_CalcStats(float* p50, float* p95, float* max);
+static void     Prof_DrawBars(Point pos);
+static void     Prof_DrawLegend(Point pos);
+
+
+
+
+
+
+// ============================================================================ FUNC DEF
+
+// **************************************************************************** Prof_Toggle
+
+// Turn the profiler on or off, at the start of the next frame
+void Prof_Toggle(void){
+    TOGGLE(profIsRequested)
+}
+
+
+// **************************************************************************** Prof_IsOn
+
+// Return true if the profiler is on
+bool Prof_IsOn(void){
+    return profIsOn;
+}
+
+
+// **************************************************************************** Prof_BeginFrame
+
+// Start timing a frame. Turn the profiler on or off, if requested
+void Prof_BeginFrame(void){
+    if (profIsOn != profIsRequested){
+        profIsOn = profIsRequested;
+        profRingStart = 0;
+        profRingN = 0;
+        TraceLog(LOG_INFO, "PROFILER: %s", profIsOn ? "On" : "Off");
+    }
+
+    if (profIsOn){
+        Prof_Clear();
+    }
+}
+
+
+// **************************************************************************** Prof_EndFrame
+
+// Keep the times of the frame in the rings. Called only for the drawn frames
+void Prof_EndFrame(void){
+    if (!profIsOn) {return;}
+
+    int frame = (profRingStart + profRingN) % PROF_FRAMES_N;
+    if (profRingN < PROF_FRAMES_N){
+        profRingN++;
+    }else{
+        profRingStart = (profRingStart + 1) % PROF_FRAMES_N;
+    }
+
+    Memory_Write(profPhaseRing[frame], profPhaseTimes, sizeof(profPhaseTimes));
+    Memory_Write(profGadgetRing[frame], profGadgetTimes, sizeof(profGadgetTimes));
+}
+
+
+// **************************************************************************** Prof_Begin
+
+// Return the start time of a timer, or 0 if the profiler is off
+double Prof_Begin(void){
+    return profIsOn ? GetTime() : 0.0;
+}
+
+
+// **************************************************************************** Prof_End
+
+// Add the time since the start to the phase. Return the current time, the
+// start of the next phase, or 0 if the profiler is off
+double Prof_End(E_ProfPhase phase, double start){
+    if (!profIsOn) {return 0.0;}
+
+    double now = GetTime();
+    profPhaseTimes[phase] += (float) ((now - start) * 1000.0);
+
+    return now;
+}
+
+
+// **************************************************************************** Prof_EndGadgetUpdate
+
+// Add the time since the start to the update time of the gadget type
+void Prof_EndGadgetUpdate(E_GadgetType type, double start){
+    if (!profIsOn) {return;}
+
+    profGadgetTimes[type][0] += (float) ((GetTime() - start) * 1000.0);
+}
+
+
+// **************************************************************************** Prof_EndGadgetDraw
+
+// Add the time since the start to the draw time of the gadget type
+void Prof_EndGadgetDraw(E_GadgetType type, double start){
+    if (!profIsOn) {return;}
+
+    profGadgetTimes[type][1] += (float) ((GetTime() - start) * 1000.0);
+}
+
+
+// **************************************************************************** Prof_Draw
+
+// Draw the overlay at the top right corner of the window, if the profiler is
+// on. The time of the overlay is counted in the frame
+void Prof_Draw(void){
+    if (!profIsOn) {return;}
+
+    double start = Prof_Begin();
+
+    Rect panel = RECT(Glo_WinSize.width - PROF_PANEL_WIDTH, 0, PROF_PANEL_WIDTH, PROF_PANEL_HEIGHT);
+    DrawRectangleRec(panel, COL_PROF_BG);
+
+    Prof_DrawBars(POINT(panel.x + PROF_PADDING, panel.y + PROF_PADDING));
+    Prof_DrawLegend(POINT(panel.x + PROF_PADDING, panel.y + PROF_GRAPH_HEIGHT + 2.0f * PROF_PADDING));
+
+    Prof_End(PROF_OVERLAY, start);
+}
+
+
+
+
+
+
+// ============================================================================ PRIVATE FUNC DEF
+
+// **************************************************************************** Prof_Clear
+
+// Clear the times of the current frame
+static void Prof_Clear(void){
+    Memory_Set(profPhaseTimes, sizeof(profPhaseTimes), 0);
+    Memory_Set(profGadgetTimes, sizeof(profGadgetTimes), 0);
+}
+
+
+// **************************************************************************** Prof_GetFrameTime
+
+// Return the time of the frame in the ring, the sum of its phases
+static float Prof_GetFrameTime(int frame){
+    float time = 0.0f;
+    for (int phase = 0; phase < PROF_PHASES_N; phase++){
+        time += profPhaseRing[frame][phase];
+    }
+
+    return time;
+}
+
+
+// **************************************************************************** Prof_CalcStats
+
+// Calculate the p50, p95 and max time of the frames in the ring
+static void Prof_CalcStats(float* p50, float* p95, float* max){
+    float times[PROF_FRAMES_N];
+
+    // Insertion sort, the ring is small
+    for (int i = 0; i < profRingN; i++){
+        float time = Prof_GetFrameTime((profRingStart + i) % PROF_FRAMES_N);
+        int j = i;
+        for (; j > 0 && times[j - 1] > time; j--){
+            times[j] = times[j - 1];
+        }
+        times[j] = time;
+    }
+
+    *p50 = times[(profRingN - 1) * 50 / 100];
+    *p95 = times[(profRingN - 1) * 95 / 100];
+    *max = times[profRingN - 1];
+}
+
+
+// **************************************************************************** Prof_DrawBars
+
+// Draw the frames in the ring as stacked bars, oldest first, and the line of
+// the frame budget
+static void Prof_DrawBars(Point pos){
+    float scale = PROF_GRAPH_HEIGHT / PROF_GRAPH_MAX_MS;
+    float bottom = pos.y + PROF_GRAPH_HEIGHT;
+
+    for (int i = 0; i < profRingN; i++){
+        int frame = (profRingStart + i) % PROF_FRAMES_N;
+        float x = pos.x + i * PROF_BAR_WIDTH;
+        float y = bottom;
+
+        for (int phase = 0; phase < PROF_PHASES_N && y > pos.y; phase++){
+            float height = MIN(profPhaseRing[frame][phase] * scale, y - pos.y);
+            y -= height;
+            DrawRectangleRec(RECT(x, y, PROF_BAR_WIDTH, height), profPhaseColors[phase]);
+        }
+    }
+
+    float budgetY = bottom - PROF_BUDGET_MS * scale;
+    DrawRectangleRec(RECT(pos.x, budgetY, PROF_FRAMES_N * PROF_BAR_WIDTH, 1), COL_PROF_BUDGET);
+}
+
+
+// **************************************************************************** Prof_DrawLegend
+
+// Draw the stats of the frames, the mean time of every phase and the mean
+// update and draw time of the slowest gadget types
+static void Prof_DrawLegend(Point pos){
+    if (profRingN == 0) {return;}
+
+    char line[PROF_LINE_LENGTH];
+
+    float p50, p95, max;
+    Prof_CalcStats(&p50, &p95, &max);
+    snprintf(line, sizeof(line), "Frame ms  p50 %.2f  p95 %.2f  max %.2f", p50, p95, max);
+    Font_DrawText(line, PROF_FONT_SIZE, pos, COL_UI_FG_EMPH);
+    pos.y += PROF_LINE_HEIGHT;
+
+    // The mean times of the phases and the gadget types
+    float phaseMeans[PROF_PHASES_N] = {0};
+    float gadgetMeans[GADGET_TYPES_N][2] = {{0}};
+    for (int i = 0; i < profRingN; i++){
+        int frame = (profRingStart + i) % PROF_FRAMES_N;
+        for (int phase = 0; phase < PROF_PHASES_N; phase++){
+            phaseMeans[phase] += profPhaseRing[frame][phase] / profRingN;
+        }
+        for (int type = 0; type < GADGET_TYPES_N; type++){
+            gadgetMeans[type][0] += profGadgetRing[frame][type][0] / profRingN;
+            gadgetMeans[type][1] += profGadgetRing[frame][type][1] / profRingN;
+        }
+    }
+
+    for (int phase = 0; phase < PROF_PHASES_N; phase++){
+        DrawRectangleRec(RECT(pos.x, pos.y + 3, 10, 10), profPhaseColors[phase]);
+        snprintf(line, sizeof(line), "%-10s %6.3f", profPhaseNames[phase], phaseMeans[phase]);
+        Font_DrawText(line, PROF_FONT_SIZE, POINT(pos.x + 16, pos.y), COL_UI_FG_SECONDARY);
+        pos.y += PROF_LINE_HEIGHT;
+    }
+
+    // The slowest gadget types, by update and draw time
+    bool isShown[GADGET_TYPES_N] = {0};
+    for (int i = 0; i < PROF_TOP_GADGETS_N; i++){
+        int top = -1;
+        for (int type = 0; type < GADGET_TYPES_N; type++){
+            if (isShown[type]) {continue;}
+            if (top < 0 || gadgetMeans[type][0] + gadgetMeans[type][1] > gadgetMeans[top][0] + gadgetMeans[top][1]){
+                top = type;
+            }
+        }
+        isShown[top] = true;
+
+        snprintf(line, sizeof(line), "%-10s U %6.3f  D %6.3f", profGadgetNames[top], gadgetMeans[top][0],
+                 gadgetMeans[top][1]);
+        Font_DrawText(line, PROF_FONT_SIZE, pos, COL_UI_FG_PRIMARY);
+        pos.y += PROF_LINE_HEIGHT;
+    }
+}
+
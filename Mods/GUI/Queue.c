@@ -131,8 +131,15 @@ void Queue_AddEvent(EventQueue* queue, Event event){
 
     int ind = queue->next;
 
+    // A full list drops its last event
+    Counter_Add(CNT_EVENTS_QUEUED, 1);
+    if (queue->n[ind] >= QUEUE_EVENTS_N){
+        Counter_Add(CNT_EVENTS_DROPPED, 1);
+    }
+
     queue->n[ind]++;
     queue->n[ind] = MIN(queue->n[ind], QUEUE_EVENTS_N);
+    Counter_Set(CNT_QUEUE_LENGTH, queue->n[ind]);
 
     queue->lists[ind][queue->n[ind] - 1] = event;
 }
@@ -156,6 +163,26 @@ void Queue_SetUserInput(EventQueue* queue, Event event){
 }
 
 
+// **************************************************************************** Queue_WriteToFile
+
+// Write the ids, sources and targets of the user input and of the events in 
+// both lists to the text file, one line per list
+void Queue_WriteToFile(const EventQueue* queue, FILE* file){
+    fprintf(file, "User Input: %d %d>%d\n", queue->userInput.id, queue->userInput.source, 
+            queue->userInput.target);
+
+    for (int listInd = 0; listInd < 2; listInd++){
+        int n = PUT_IN_RANGE(queue->n[listInd], 0, QUEUE_EVENTS_N);
+        fprintf(file, "%s List (%d):", (listInd == queue->current) ? "Current" : "Next", n);
+        for (int i = 0; i < n; i++){
+            const Event* event = &queue->lists[listInd][i];
+            fprintf(file, " %d %d>%d%s", event->id, event->source, event->target, event->isProcessed ? "*" : "");
+        }
+        fprintf(file, "\n");
+    }
+}
+
+
 #ifdef DEBUG_MODE
 // **************************************************************************** Queue_Print
 
@@ -9,6 +9,26 @@
 // ============================================================================ INFO
 /*
     Functions for managing the router.
+
+    IDLE MODE:
+    The frames are drawn only while something changes. After 
+    ROUTER_IDLE_DELAY seconds without any event, the magic color completes 
+    its period and pauses, and the flying rectangles fade out. Then, when no 
+    page is in transition and no gadget is animating, the loop polls the 
+    input and sleeps, instead of drawing. The first event starts the magic 
+    color and the flying rectangles again.
+
+    PROFILER:
+    WKEY_P toggles the frame profiler overlay, that is drawn over all the
+    pages. See Profiler.c.
+
+    TRACE:
+    If tracing is on, WKEY_F flushes the recorded timeline to the trace 
+    file. See Trace.c.
+
+    WATCHDOG:
+    The drawn frames that take too long are logged by the watchdog, if it 
+    was started. See Watchdog.c.
 */
 
 
@@ -27,11 +47,20 @@
 #include "GUI.h"
 
 
+// ============================================================================ PRIVATE CONSTANTS
+
+#define ROUTER_IDLE_DELAY                   10.0
+#define ROUTER_IDLE_WAIT                    0.05
+#define ROUTER_STILL_FRAMES_N               2
+
+
 // ============================================================================ PRIVATE FUNC DECL
 
 static void     Router_Resize(const Router* router);
-static void     Router_ReactToEvents(const Router* router);
+static bool     Router_ReactToEvents(const Router* router);
 static void     Router_Update(const Router* router);
+static void     Router_Settle(const Router* router, bool settle);
+static bool     Router_IsStill(const Router* router);
 static void     Router_Draw(const Router* router);
 
 
@@ -73,6 +102,9 @@ Router* Router_Free(Router* router){
 
     MCol_FreeDefault();
 
+    Gadget_FreePools();
+    Page_FreeArena();
+
     return Memory_Free(router);
 }
 
@@ -119,32 +151,119 @@ void Router_HidePage(const Router* router, E_PageID pageID, bool withAnim){
 }
 
 
+// **************************************************************************** Router_RunFrame
+
+// Resize the router if the window was resized, react to the events and 
+// update the router, without drawing the frame. Return true if there was any
+// event
+bool Router_RunFrame(const Router* router){
+    bool hasEvents = false;
+    double time = Prof_Begin();
+
+    if (IsWindowResized()){
+        TRACE_INSTANT("Resize", TRACE_NO_ARG)
+        Window_UpdateWinSize();
+        Router_Resize(router);
+        hasEvents = true;
+    }
+    time = Prof_End(PROF_RESIZE, time);
+
+    MCol_Update(Glo_MCol);
+    time = Prof_End(PROF_MCOL, time);
+    FRects_Update(router->fRects);
+    time = Prof_End(PROF_FRECTS, time);
+
+    Music_Update();
+    time = Prof_End(PROF_MUSIC, time);
+
+    hasEvents = Router_ReactToEvents(router) || hasEvents;
+    time = Prof_End(PROF_EVENTS, time);
+
+    Router_Update(router);
+    Prof_End(PROF_UPDATE, time);
+
+    return hasEvents;
+}
+
+
+// **************************************************************************** Router_DrawFrame
+
+// Draw the frame: the background, the flying rectangles and all the shown 
+// pages. Called between BeginDrawing and EndDrawing, but not inside a texture
+// mode, since the rod cache of the board draws in its own render textures
+void Router_DrawFrame(const Router* router){
+    double time = Prof_Begin();
+
+    ClearBackground(COL_BG);
+    FRects_Draw(router->fRects);
+    time = Prof_End(PROF_DRAW_BG, time);
+
+    Router_Draw(router);
+    Prof_End(PROF_DRAW_PAGES, time);
+}
+
+
 // **************************************************************************** Router_Loop
 
-// The main loop of the program
+// The main loop of the program. Skip drawing the frames while nothing changes
 void Router_Loop(const Router* router){
     Music_Start();
+
+    bool isFirstFrame = true;
+    double lastEventTime = GetTime();
+    int nStillFrames = 0;
     
     while (!WindowShouldClose()){
-        if (IsWindowResized()){
-            Window_UpdateWinSize();
-            Router_Resize(router);
+        // Give back the temporaries of the last iteration, drawn or skipped
+        Scratch_Reset();
+        Counter_BeginFrame();
+        Prof_BeginFrame();
+        Watchdog_BeginFrame();
+
+        TRACE_BEGIN("Router_RunFrame", TRACE_NO_ARG)
+        bool hasEvents = Router_RunFrame(router);
+        TRACE_END
+
+        if (hasEvents) {lastEventTime = GetTime();}
+        Router_Settle(router, GetTime() - lastEventTime >= ROUTER_IDLE_DELAY);
+
+        // The frame after the last change is drawn too, since the change may 
+        // have happened at the update of the last animated frame
+        nStillFrames = (!hasEvents && Router_IsStill(router)) ? nStillFrames + 1 : 0;
+        if (nStillFrames >= ROUTER_STILL_FRAMES_N){
+            // The music stream needs frequent updates
+            TRACE_BEGIN("Idle", TRACE_NO_ARG)
+            Window_SkipFrame(Music_IsPlaying() ? 1.0 / FPS : ROUTER_IDLE_WAIT);
+            TRACE_END
+            continue;
         }
 
-        MCol_Update(Glo_MCol);
-        FRects_Update(router->fRects);
+        // EndDrawing is not profiled, since it waits for the FPS limiter
+        TRACE_BEGIN("Router_DrawFrame", TRACE_NO_ARG)
+        BeginDrawing();
+        Router_DrawFrame(router);
+        Prof_Draw();
+        Prof_EndFrame();
+        TRACE_END
 
-        Music_Update();
+        TRACE_BEGIN("EndDrawing", TRACE_NO_ARG)
+        EndDrawing();
+        TRACE_END
+        Counter_Add(CNT_FRAMES_DRAWN, 1);
 
-        Router_ReactToEvents(router);
+        Watchdog_EndFrame(router);
 
-        Router_Update(router);
+        #ifdef DEBUG_MODE
+            if (Counter_GetFrameValue(CNT_FONT_MEASURES) > 0){
+                TraceLog(LOG_DEBUG, "ROUTER: %lld texts measured in frame", Counter_GetFrameValue(CNT_FONT_MEASURES));
+            }
+        #endif
 
-        BeginDrawing();
-        ClearBackground(COL_BG);
-        FRects_Draw(router->fRects);
-        Router_Draw(router);
-        EndDrawing();
+        // The time is counted from the creation of the window
+        if (isFirstFrame){
+            TraceLog(LOG_INFO, "ROUTER: First frame in %.1f ms", GetTime() * 1000.0);
+            isFirstFrame = false;
+        }
     }
 }
 
@@ -199,14 +318,19 @@ static void Router_Resize(const Router* router){
 // **************************************************************************** Router_ReactToEvents
 
 // Get mouse and keyboard events and let the last shown page to react to the 
-// events in the event queue
-static void Router_ReactToEvents(const Router* router){
+// events in the event queue. Return true if there was any event
+static bool Router_ReactToEvents(const Router* router){
+    bool hasEvents = false;
+
     Queue_SetUserInput(router->queue, Event_GetUserInput());
 
     for (int i = PAGES_N - 1; i >= 0; i--){
         if (router->pages[i] != NULL && router->pages[i]->isShown){
             Event event;
             while ((event = Queue_GetNext(router->queue)).id != EVENT_NONE){
+                TRACE_BEGIN("Event", event.id)
+                hasEvents = true;
+
                 if (event.id == EVENT_SHOW_PAGE){
                     Page_Show(router->pages[event.data.page.id], event, event.data.page.withAnim);
                     if (event.data.page.id == PAGE_GAME){
@@ -219,6 +343,12 @@ static void Router_ReactToEvents(const Router* router){
                     Page_Hide(router->pages[event.data.page.id], event.data.page.withAnim);
                 }
 
+                if (event.id == EVENT_KEY_PRESSED && event.data.key == WKEY_P){
+                    Prof_Toggle();
+                }
+                if (event.id == EVENT_KEY_PRESSED && event.data.key == WKEY_F){
+                    Trace_Flush();
+                }
                 if (event.id == EVENT_KEY_PRESSED && event.data.key == WKEY_M){
                     Sound_Toggle();
                     Queue_AddEvent(router->queue, Event_SetAsUpdateSwitch(PAGE_GAME, GDG_SWITCH_SOUND, 
@@ -233,10 +363,13 @@ static void Router_ReactToEvents(const Router* router){
                 }
 
                 Page_ReactToEvent(router->pages[i], event, router->queue);
+                TRACE_END
             }
             break;
         }
     }
+
+    return hasEvents;
 }
 
 
@@ -250,6 +383,41 @@ static void Router_Update(const Router* router){
 }
 
 
+// **************************************************************************** Router_Settle
+
+// Stop the magic color and the flying rectangles, so they eventually remain 
+// still, or start them again
+static void Router_Settle(const Router* router, bool settle){
+    if (settle){
+        MCol_Stop(Glo_MCol);
+        FRects_Stop(router->fRects);
+    }else{
+        MCol_Start(Glo_MCol);
+        FRects_Start(router->fRects);
+    }
+}
+
+
+// **************************************************************************** Router_IsStill
+
+// Return true if nothing changes in the next frame without any event: the 
+// magic color is paused, the flying rectangles are faded out and all the pages 
+// are still
+static bool Router_IsStill(const Router* router){
+    if (MCol_IsChanging(Glo_MCol) || FRects_IsVisible(router->fRects)){
+        return false;
+    }
+
+    for (int i = 0; i < PAGES_N; i++){
+        if (!Page_IsStill(router->pages[i])){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
 // **************************************************************************** Router_Draw
 
 // Draw all the shown pages in the router
@@ -0,0 +1,225 @@
+// ============================================================================
+// RODS
+// Watchdog
+// by Andreas Socratous
+// Jan 2023
+// ============================================================================
+
+
+// ============================================================================ INFO
+/*
+    Functions for the frame stall watchdog.
+
+    The watchdog measures the wall time of every drawn frame, from the start
+    of the loop to the end of EndDrawing. When a frame takes more than
+    WATCHDOG_THRESHOLD seconds, it writes a snapshot of the state of the
+    program to the stall log, in the app folder: the shown pages, the event
+    queue, the rod grid of the game page, the counters and the last trace
+    markers, if tracing is on.
+
+    In every frame the watchdog only reads the clock and compares, and it
+    never allocates memory; the paths of the logs are made by Watchdog_Init.
+    The first frame, that loads the GPU resources, is not watched, and at
+    most one snapshot is written every WATCHDOG_INTERVAL seconds. When the
+    stall log grows over WATCHDOG_LOG_MAX_SIZE bytes, it replaces the old
+    stall log and a new one is started.
+*/
+
+
+// ============================================================================ FILE STRUCTURE
+/*
+    SNAPSHOT:
+        === STALL <date> <time>, frame <n>: <ms> ms
+        Pages: <id> <name>, ..., top <name>
+        User Input: <id> <source>><target>
+        Current List (<n>): <id> <source>><target>[*] ...
+        Next List (<n>): <id> <source>><target>[*] ...
+        RGrid: <cols> x <rows>, electrified <n> / <total>, animating <n>
+        Counters: <name> <value> (frame <value>) ...
+        Trace:
+        <ms ago> <phase> <name> [<id>]
+        ...
+*/
+
+
+// ============================================================================ DEPENDENCIES
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <raylib.h>
+
+#include "../Public/Public.h"
+#include "../Fund/Fund.h"
+#include "../Logic/Logic.h"
+#include "../Store/Store.h"
+#include "GUI.h"
+
+
+// ============================================================================ PRIVATE CONSTANTS
+
+#define WATCHDOG_THRESHOLD                  0.1
+#define WATCHDOG_INTERVAL                   5.0
+#define WATCHDOG_LOG_MAX_SIZE               (256 * 1024)
+#define WATCHDOG_TRACE_MARKERS_N            32
+#define WATCHDOG_DATE_LENGTH                32
+
+
+// ============================================================================ PRIVATE VARIABLES
+
+// The names of the pages in the snapshot
+static const char* watchdogPageNames[PAGES_N] = {
+    "Main", "Game", "Setup", "Help", "Info"
+};
+
+static char* watchdogLogPath = NULL;
+static char* watchdogOldLogPath = NULL;
+
+// Returns the rod grid of the game page. It is asked for every snapshot, since
+// the game page replaces its grid when the slot changes
+static RGrid* (*watchdogGetRGrid)(const Page* page) = NULL;
+
+static double watchdogFrameStart = 0.0;
+static double watchdogLastSnapshot = 0.0;
+static bool watchdogIsFirstFrame = true;
+
+
+// ============================================================================ PRIVATE FUNC DECL
+
+static void     Watchdog_WriteSnapshot(const Router* router, double frameTime);
+static FILE*    Watchdog_OpenLog(void);
+
+
+
+
+
+
+// ============================================================================ FUNC DEF
+
+// **************************************************************************** Watchdog_Init
+
+// Start the watchdog, with the function that returns the rod grid of the game
+// page. Make the paths of the logs
+void Watchdog_Init(RGrid* (*GetRGrid)(const Page* page)){
+    watchdogGetRGrid = GetRGrid;
+    watchdogLogPath = Path_GetStallLogFile();
+    watchdogOldLogPath = Path_GetStallLogOldFile();
+}
+
+
+// **************************************************************************** Watchdog_Close
+
+// Stop the watchdog and free the paths of the logs
+void Watchdog_Close(void){
+    watchdogGetRGrid = NULL;
+    watchdogLogPath = Memory_Free(watchdogLogPath);
+    watchdogOldLogPath = Memory_Free(watchdogOldLogPath);
+}
+
+
+// **************************************************************************** Watchdog_BeginFrame
+
+// Start measuring a frame. Called at the start of every frame
+void Watchdog_BeginFrame(void){
+    watchdogFrameStart = GetTime();
+}
+
+
+// **************************************************************************** Watchdog_EndFrame
+
+// End measuring a drawn frame and write a snapshot if it took too long.
+// Called after EndDrawing
+void Watchdog_EndFrame(const Router* router){
+    if (watchdogLogPath == NULL) {return;}
+
+    double now = GetTime();
+    double frameTime = now - watchdogFrameStart;
+
+    if (watchdogIsFirstFrame){
+        watchdogIsFirstFrame = false;
+        return;
+    }
+
+    if (frameTime < WATCHDOG_THRESHOLD || now - watchdogLastSnapshot < WATCHDOG_INTERVAL) {return;}
+
+    watchdogLastSnapshot = now;
+    Watchdog_WriteSnapshot(router, frameTime);
+}
+
+
+
+
+
+
+// ============================================================================ PRIVATE FUNC DEF
+
+// **************************************************************************** Watchdog_WriteSnapshot
+
+// Write the snapshot of the state of the program to the stall log
+static void Watchdog_WriteSnapshot(const Router* router, double frameTime){
+    FILE* file = Watchdog_OpenLog();
+    if (file == NULL) {return;}
+
+    char date[WATCHDOG_DATE_LENGTH] = "";
+    time_t t = time(NULL);
+    strftime(date, sizeof(date), "%Y-%m-%d %H:%M:%S", localtime(&t));
+
+    fprintf(file, "=== STALL %s, frame %lld: %.1f ms\n", date, Counter_Get(CNT_FRAMES), frameTime * 1000.0);
+
+    // The shown pages, the last shown on top
+    int top = INVALID;
+    fprintf(file, "Pages:");
+    for (int i = 0; i < PAGES_N; i++){
+        if (router->pages[i] != NULL && router->pages[i]->isShown){
+            fprintf(file, " %d %s,", i, watchdogPageNames[i]);
+            top = i;
+        }
+    }
+    fprintf(file, " top %s\n", (top == INVALID) ? STR_NONE : watchdogPageNames[top]);
+
+    Queue_WriteToFile(router->queue, file);
+
+    const Page* gamePage = router->pages[PAGE_GAME];
+    const RGrid* rGrid = (watchdogGetRGrid != NULL && gamePage != NULL) ? watchdogGetRGrid(gamePage) : NULL;
+    if (rGrid != NULL){
+        Grid size = RGrid_GetSize(rGrid);
+        fprintf(file, "RGrid: %d x %d, electrified %d / %d, animating %d\n", size.nCols, size.nRows,
+                RGrid_GetNumElectrified(rGrid), RGrid_GetTotal(rGrid), RGrid_GetNumAnimating(rGrid));
+    }
+
+    fprintf(file, "Counters:");
+    for (int id = 0; id < COUNTERS_N; id++){
+        fprintf(file, " %s %lld (frame %lld)", Counter_GetName(id), Counter_Get(id), Counter_GetFrameValue(id));
+    }
+    fprintf(file, "\n");
+
+    fprintf(file, "Trace:\n");
+    Trace_WriteRecent(file, WATCHDOG_TRACE_MARKERS_N);
+    fprintf(file, "\n");
+
+    bool res = (fclose(file) == 0);
+
+    TraceLog(res ? LOG_WARNING : LOG_ERROR, "WATCHDOG: Frame took %.1f ms, %s", frameTime * 1000.0,
+             res ? "snapshot written to the stall log" : "failed to write the stall log");
+}
+
+
+// **************************************************************************** Watchdog_OpenLog
+
+// Open the stall log for appending. If it is too large, replace the old stall
+// log with it and start a new one. Return NULL if it fails
+static FILE* Watchdog_OpenLog(void){
+    FILE* file = fopen(watchdogLogPath, "a");
+    if (file == NULL) {return NULL;}
+
+    if (fseek(file, 0, SEEK_END) != 0 || ftell(file) < WATCHDOG_LOG_MAX_SIZE){
+        return file;
+    }
+
+    // The old log is removed first, since rename does not replace on Windows
+    fclose(file);
+    remove(watchdogOldLogPath);
+    rename(watchdogLogPath, watchdogOldLogPath);
+
+    return fopen(watchdogLogPath, "w");
+}
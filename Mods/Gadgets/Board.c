@@ -13,6 +13,10 @@
 
     The board gadget manages the rod grid. It emits the victory event when 
     completed.
+
+    The rods are drawn through a rod cache, so only the changed tiles are 
+    redrawn. The source and the selection box are drawn on top of the cache 
+    every frame.
 */
 
 
@@ -26,6 +30,7 @@
 #include "../Fund/Fund.h"
 #include "../Logic/Logic.h"
 #include "../Graph/Graph.h"
+#include "../Store/Store.h"
 #include "../GUI/GUI.h"
 #include "../Sound/Sound.h"
 #include "Gadgets.h"
@@ -61,6 +66,13 @@
     (BDATA->rodModel)
 
 
+// **************************************************************************** RCACHE
+
+// Pointer to the rod cache
+#define RCACHE \
+    (BDATA->rCache)
+
+
 // ============================================================================ PRIVATE CONSTANTS
 
 #define BOARD_MOVE_DIST_RATIO               0.07f
@@ -76,6 +88,7 @@ typedef struct BoardData{
     RGrid* rGrid;
     SGraph* sg;
     RodModel* rodModel;
+    RCache* rCache;
     GNode selBox;
     bool isReactive;
     GNode pressedRod;
@@ -89,10 +102,12 @@ static void     Board_PrepareToFree(Gadget* board);
 static void     Board_Resize(Gadget* board);
 static void     Board_ReactToEvent(Gadget* board, Event event, EventQueue* queue);
 static void     Board_Update(Gadget* board, EventQueue* queue);
+static bool     Board_IsAnimating(const Gadget* board);
 static void     Board_Draw(const Gadget* board, Vector2 shift);
 static Grid     Board_CalcVisiblePart(const Gadget* board);
 static GNode    Board_FirstVisibleRod(const Gadget* board);
 static float    Board_CalcTileSize(const Gadget* board);
+static void     Board_ResetView(Gadget* board);
 static void     Board_MoveSelBox(Gadget* board, E_Direction dir, EventQueue* queue);
 static void     Board_FocusOnSource(Gadget* board);
 static void     Board_Zoom(Gadget* board, float zoom);
@@ -122,6 +137,7 @@ Gadget* Board_Make(E_GadgetID id, const PData* pData){
     board->Resize        = Board_Resize;
     board->ReactToEvent  = Board_ReactToEvent;
     board->Update        = Board_Update;
+    board->IsAnimating   = Board_IsAnimating;
     board->Draw          = Board_Draw;
     #ifdef DEBUG_MODE
         board->PrintData = Board_PrintData;
@@ -129,7 +145,7 @@ Gadget* Board_Make(E_GadgetID id, const PData* pData){
 
     board->cRect = TO_RECT(Glo_WinSize);
 
-    BoardData* data = Memory_Allocate(NULL, sizeof(BoardData), ZEROVAL_ALL);
+    BoardData* data = Gadget_AllocateData(sizeof(BoardData));
     board->data = data;
 
     if (pData != NULL && pData->rGrid != NULL){
@@ -149,12 +165,13 @@ Gadget* Board_Make(E_GadgetID id, const PData* pData){
         SGraph_SetView(data->sg, board->cRect);
     }else{
         data->sg = SGraph_MakeFromGrid(RGrid_GetSize(data->rGrid), ROD_DEF_TEXTURE_SIZE, board->cRect, 
-                                       SGRAPH_DEF_MARGIN, ROD_MIN_TEXTURE_SIZE, ROD_MAX_TEXTURE_SIZE);
+                                       SGRAPH_DEF_MARGIN, ROD_MIN_TILE_SIZE, ROD_MAX_TEXTURE_SIZE);
     }
 
     float tileSize = Board_CalcTileSize(board);
 
     data->rodModel = RGraph_MakeRodModel(tileSize);
+    data->rCache = RCache_Make();
 
     data->isReactive = true;
     data->pressedRod = GNODE_INVALID;
@@ -173,16 +190,63 @@ void Board_CreateNewRodGrid(Gadget* board, int nCols, int nRows){
     RGrid_CreateRandom(RGRID);
     RGrid_Shuffle(RGRID);
 
-    SGRAPH = SGraph_Free(SGRAPH);
-    SGRAPH = SGraph_MakeFromGrid(RGrid_GetSize(RGRID), ROD_DEF_TEXTURE_SIZE, board->cRect, 
-                                 SGRAPH_DEF_MARGIN, ROD_MIN_TEXTURE_SIZE, ROD_MAX_TEXTURE_SIZE);
+    Board_ResetView(board);
+}
 
-    float tileSize = Board_CalcTileSize(board);
-    RGraph_ResizeRodModel(RODMODEL, tileSize);
 
-    BDATA->selBox = GNODE_INVALID;
-    BDATA->pressedRod = GNODE_INVALID;
-    BDATA->victory = false;
+// **************************************************************************** Board_LoadRodGrid
+
+// Replace the rod grid with a copy of the given one
+void Board_LoadRodGrid(Gadget* board, const RGrid* rGrid){
+    RGRID = RGrid_Copy(RGRID, rGrid);
+
+    Board_ResetView(board);
+}
+
+
+// **************************************************************************** Board_LoadPackEntry
+
+// Replace the rod grid with the puzzle at the given index of the puzzle pack. 
+// Return true if successful
+bool Board_LoadPackEntry(Gadget* board, const Pack* pack, int index){
+    RGrid* rGrid = Pack_LoadRGrid(pack, index);
+    if (rGrid == NULL) {return false;}
+
+    RGRID = RGrid_Free(RGRID);
+    RGRID = rGrid;
+
+    Board_ResetView(board);
+
+    return true;
+}
+
+
+// **************************************************************************** Board_SwapGame
+
+// Swap the rod grid and the scroll graphics of the board with the given ones. 
+// The rod textures are kept. If the scroll graphics is NULL, make a default 
+// one
+void Board_SwapGame(Gadget* board, RGrid** rGrid, SGraph** sg, EventQueue* queue){
+    RGrid* tempRGrid = RGRID;
+    RGRID = *rGrid;
+    *rGrid = tempRGrid;
+
+    SGraph* tempSGraph = SGRAPH;
+    SGRAPH = *sg;
+    *sg = tempSGraph;
+
+    if (SGRAPH == NULL){
+        Board_ResetView(board);
+    }else{
+        SGraph_SetView(SGRAPH, board->cRect);
+        RGraph_ResizeRodModel(RODMODEL, Board_CalcTileSize(board));
+        RCache_Invalidate(RCACHE);
+        BDATA->selBox = GNODE_INVALID;
+        BDATA->pressedRod = GNODE_INVALID;
+        BDATA->victory = false;
+    }
+
+    Board_AddUpdateScrollbarEvents(board, queue);
 }
 
 
@@ -282,11 +346,12 @@ bool Board_IsReactive(const Gadget* board){
 
 // **************************************************************************** Board_PrepareToFree
 
-// Free the rod grid, scroll graphics and rod model
+// Free the rod grid, scroll graphics, rod model and rod cache
 static void Board_PrepareToFree(Gadget* board){
     RGRID    = RGrid_Free(RGRID);
     SGRAPH   = SGraph_Free(SGRAPH);
     RODMODEL = RGraph_FreeRodModel(RODMODEL);
+    RCACHE   = RCache_Free(RCACHE);
 }
 
 
@@ -411,6 +476,15 @@ static void Board_ReactToEvent(Gadget* board, Event event, UNUSED EventQueue* qu
             break;
         }
 
+        case EVENT_MINIMAP_CHANGED:{
+            BDATA->selBox = GNODE_INVALID;
+            Size vScreen = SGraph_GetVScreen(SGRAPH);
+            SGraph_PlaceViewport(SGRAPH, POINT(event.data.minimap.xRatio * vScreen.width,
+                                               event.data.minimap.yRatio * vScreen.height), RP_CENTER);
+            Board_AddUpdateScrollbarEvents(board, queue);
+            break;
+        }
+
         default: {break;}
     }
 }
@@ -430,16 +504,27 @@ static void Board_Update(Gadget* board, EventQueue* queue){
 }
 
 
+// **************************************************************************** Board_IsAnimating
+
+// Return true if any rod is rotating
+static bool Board_IsAnimating(const Gadget* board){
+    return RGrid_IsAnimating(RGRID);
+}
+
+
 // **************************************************************************** Board_Draw
 
-// Draw the rod grid and the selction box
+// Draw the rod grid, through the rod cache, and the selction box
 static void Board_Draw(const Gadget* board, Vector2 shift){
     float tileSize = RGraph_GetTileSize(RODMODEL);
     Grid visible = Board_CalcVisiblePart(board);
     Point origin = SGraph_ProjectPoint(Grid_NodeToPoint(visible.origin, tileSize), SGRAPH);
-    origin = Geo_TranslatePoint(origin, shift);
 
-    RGraph_DrawRGrid(RGRID, visible, origin, RODMODEL);
+    RCache_Update(RCACHE, RGRID, visible, origin, board->cRect, RODMODEL);
+    RCache_Draw(RCACHE, shift);
+
+    origin = Geo_TranslatePoint(origin, shift);
+    RGraph_DrawSource(RGRID, visible, origin, RODMODEL);
 
     if (BDATA->selBox.x != INVALID){
         Point selboxPos = SGraph_ProjectPoint(Grid_NodeToPoint(BDATA->selBox, tileSize), SGRAPH);
@@ -479,6 +564,25 @@ static float Board_CalcTileSize(const Gadget* board){
 }
 
 
+// **************************************************************************** Board_ResetView
+
+// Remake the scroll graphics and resize the rod model for the current rod 
+// grid. Clear the selection box, the pressed rod and the victory state
+static void Board_ResetView(Gadget* board){
+    SGRAPH = SGraph_Free(SGRAPH);
+    SGRAPH = SGraph_MakeFromGrid(RGrid_GetSize(RGRID), ROD_DEF_TEXTURE_SIZE, board->cRect, 
+                                 SGRAPH_DEF_MARGIN, ROD_MIN_TILE_SIZE, ROD_MAX_TEXTURE_SIZE);
+
+    float tileSize = Board_CalcTileSize(board);
+    RGraph_ResizeRodModel(RODMODEL, tileSize);
+    RCache_Invalidate(RCACHE);
+
+    BDATA->selBox = GNODE_INVALID;
+    BDATA->pressedRod = GNODE_INVALID;
+    BDATA->victory = false;
+}
+
+
 // **************************************************************************** Board_MoveSelBox
 
 // Move the selection box to the given direction
@@ -592,6 +696,7 @@ static void Board_AddUpdateScrollbarEvents(const Gadget* board, EventQueue* queu
         printf("RGrid:         %p\n", (void*) (BDATA->rGrid));
         printf("SGraph;        %p\n", (void*) (BDATA->sg));
         printf("Rod Model:     %p\n", (void*) (BDATA->rodModel));
+        printf("Rod Cache:     %p\n", (void*) (BDATA->rCache));
         printf("Selection Box: "); Grid_PrintNode(BDATA->selBox, WITH_NEW_LINE);
         printf("Is Reactive:   %s\n", Bool_ToString(BDATA->isReactive, LONG_FORM));
         printf("Pressed Rod:   "); Grid_PrintNode(BDATA->pressedRod, WITH_NEW_LINE);
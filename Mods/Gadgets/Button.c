@@ -107,7 +107,7 @@ Gadget* Button_MakeAsText(E_GadgetID id, const char* txt){
         button->PrintData = Button_PrintData;
     #endif
 
-    ButtonData* data = Memory_Allocate(NULL, sizeof(ButtonData), ZEROVAL_ALL);
+    ButtonData* data = Gadget_AllocateData(sizeof(ButtonData));
 
     data->roundness   = BTN_DEF_ROUNDNESS;
     data->thickness   = BTN_DEF_THICKNESS;
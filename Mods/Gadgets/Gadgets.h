@@ -154,6 +154,9 @@ int             Table_GetAlignment(const Gadget* table, int nCols, int nRows);
 
 Gadget*         Board_Make(E_GadgetID id, const PData* pData);
 void            Board_CreateNewRodGrid(Gadget* board, int nCols, int nRows);
+void            Board_LoadRodGrid(Gadget* board, const RGrid* rGrid);
+bool            Board_LoadPackEntry(Gadget* board, const Pack* pack, int index);
+void            Board_SwapGame(Gadget* board, RGrid** rGrid, SGraph** sg, EventQueue* queue);
 void            Board_SetAsReactive(Gadget* board);
 void            Board_SetAsNotReactive(Gadget* board);
 int             Board_GetNumElectrifiedRods(const Gadget* board);
@@ -166,6 +169,10 @@ SGraph*         Board_GetSGraph(const Gadget* board);
 RodModel*       Board_GetRodModel(const Gadget* board);
 bool            Board_IsReactive(const Gadget* board);
 
+// ---------------------------------------------------------------------------- Minimap Functions
+
+Gadget*         Minimap_Make(E_GadgetID id, const Gadget* board);
+
 
 #endif // GADGETS_GUARD
 
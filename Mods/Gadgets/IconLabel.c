@@ -79,7 +79,7 @@ Gadget* IconLabel_Make(E_GadgetID id, E_IconID icon, Color color, E_RectPointTyp
         iconLabel->PrintData = IconLabel_PrintData;
     #endif
 
-    IconLabelData* data = Memory_Allocate(NULL, sizeof(IconLabelData), ZEROVAL_ALL);
+    IconLabelData* data = Gadget_AllocateData(sizeof(IconLabelData));
 
     data->iconID = icon;
     data->color = color;
@@ -50,6 +50,7 @@
 // The data object of the label
 typedef struct LabelData{
     char* txt;
+    int txtCapacity;
     float fontSize;
     Point pos;
     E_RectPointType alignment;
@@ -87,9 +88,10 @@ Gadget* Label_Make(E_GadgetID id, const char* txt, Color color, E_RectPointType
         label->PrintData = Label_PrintData;
     #endif
 
-    LabelData* data = Memory_Allocate(NULL, sizeof(LabelData), ZEROVAL_ALL);
+    LabelData* data = Gadget_AllocateData(sizeof(LabelData));
 
     data->txt = String_Copy(NULL, txt);
+    data->txtCapacity = String_Length(txt) + 1;
     data->color = color;
     data->alignment = alignment;
 
@@ -130,9 +132,17 @@ void Label_SetColor(Gadget* label, Color color){
 
 // **************************************************************************** Label_SetText
 
-// Change the text of the label
+// Change the text of the label. The buffer of the text is reused, and only 
+// grows for a longer text
 void Label_SetText(Gadget* label, const char* txt){
-    LDATA->txt = String_Copy(LDATA->txt, txt);
+    int size = String_Length(txt) + 1;
+
+    if (size > LDATA->txtCapacity){
+        LDATA->txt = Memory_Allocate(LDATA->txt, size, ZEROVAL_NONE);
+        LDATA->txtCapacity = size;
+    }
+    Memory_Write(LDATA->txt, txt, size);
+
     Gadget_Resize(label);
 }
 
@@ -0,0 +1,445 @@
+// ============================================================================
+// RODS
+// Minimap
+// by Andreas Socratous
+// Jan 2023
+// ============================================================================
+
+
+// ============================================================================ INFO
+/*
+    Functions and definitions of structures and constants for the minimap
+    gadget.
+
+    The minimap shows the whole rod grid of the board, with 1 to
+    MINIMAP_MAX_ROD_SIZE pixels per rod, the electrified rods highlighted and
+    the viewport of the board as a rectangle. Pressing or dragging on the
+    minimap emits EVENT_MINIMAP_CHANGED, which moves the viewport of the
+    board. Like the scrollbars, it emits EVENT_GADGET_EXPANDED when the mouse
+    enters it and EVENT_GADGET_COLLAPSED when it leaves.
+
+    The minimap is drawn from a pixel map, with MINIMAP_CELL x MINIMAP_CELL
+    pixels for every rod: the center and the legs. When the rods are drawn
+    smaller than that, the texture would be scaled down and the thin legs
+    lost, so the map has a single pixel for every rod instead, in the color
+    of its electrification. The pixel map is kept on
+    the CPU, together with the legs and electrification of every rod, as they
+    were mapped. While the version of the rod grid does not change, nothing
+    is done, so the minimap costs a single quad per frame whatever the size of
+    the grid. When it changes, only the rods that differ from their mapped
+    state are remapped and only their pixels are uploaded to the texture. The
+    pixel map does not show the rotation animation.
+*/
+
+
+// ============================================================================ DEPENDENCIES
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <raylib.h>
+
+#include "../Public/Public.h"
+#include "../Fund/Fund.h"
+#include "../Logic/Logic.h"
+#include "../Graph/Graph.h"
+#include "../GUI/GUI.h"
+#include "Gadgets.h"
+
+
+// ============================================================================ PRIVATE MACROS
+
+// **************************************************************************** MMDATA
+
+// Pointer to the data object of the minimap
+#define MMDATA \
+    ((MinimapData*) minimap->data)
+
+
+// ============================================================================ PRIVATE CONSTANTS
+
+#define MINIMAP_CELL                        3
+#define MINIMAP_MAP_SIZE                    (RGRID_MAX_SIZE * MINIMAP_CELL)
+#define MINIMAP_MAX_ROD_SIZE                3
+#define MINIMAP_FULL_UPLOAD_N               64
+#define MINIMAP_MARGIN                      6.0f
+#define MINIMAP_THICKNESS                   2.0f
+
+#define MINIMAP_ELECTRIFIED                 0x10
+
+#define COL_MINIMAP_BG                      COL_UI_BG_SECONDARY
+#define COL_MINIMAP_OUTLINE                 COL_UI_FG_PRIMARY
+#define COL_MINIMAP_EMPH                    COL_UI_FG_EMPH
+#define COL_MINIMAP_ROD                     COL_ROD
+#define COL_MINIMAP_ELECTRIFIED             COL_ELECTRIC_1
+#define COL_MINIMAP_VIEWPORT                COL_UI_FG_SECONDARY
+
+
+// ============================================================================ PRIVATE STRUCTURES
+
+// **************************************************************************** MinimapData
+
+// The data object of the minimap gadget. The rod grid, its version and size
+// are the ones that were last mapped. cell is the number of pixels per side of
+// every rod in the pixel map. mapped holds the legs of every mapped rod, with
+// MINIMAP_ELECTRIFIED set if it was electrified
+typedef struct MinimapData{
+    const Gadget* board;
+
+    const RGrid* rGrid;
+    unsigned int version;
+    Grid grid;
+    int cell;
+
+    unsigned char mapped[RGRID_MAX_SIZE][RGRID_MAX_SIZE];
+    GNode dirty[MINIMAP_FULL_UPLOAD_N];
+
+    Color* map;
+    Texture2D mapTexture;
+    bool mapIsValid;
+
+    Rect frameRect;
+    Rect mapRect;
+}MinimapData;
+
+
+// ============================================================================ PRIVATE FUNC DECL
+
+static void     Minimap_PrepareToFree(Gadget* minimap);
+static void     Minimap_Resize(Gadget* minimap);
+static void     Minimap_ReactToEvent(Gadget* minimap, Event event, EventQueue* queue);
+static void     Minimap_Update(Gadget* minimap, EventQueue* queue);
+static void     Minimap_Draw(const Gadget* minimap, Vector2 shift);
+static void     Minimap_PlaceMap(Gadget* minimap);
+static void     Minimap_UpdateMap(Gadget* minimap, const RGrid* rGrid);
+static void     Minimap_MapRod(Gadget* minimap, GNode node, unsigned char state);
+static void     Minimap_UploadRod(Gadget* minimap, GNode node);
+static void     Minimap_EmitChanged(const Gadget* minimap, Point pos, EventQueue* queue);
+#ifdef DEBUG_MODE
+    static void Minimap_PrintData(const Gadget* minimap);
+#endif
+
+
+
+
+
+
+// ============================================================================ FUNC DEF
+
+// **************************************************************************** Minimap_Make
+
+// Make a minimap of the rod grid of the given board
+Gadget* Minimap_Make(E_GadgetID id, const Gadget* board){
+    Gadget* minimap = Gadget_Make(id, GT_MINIMAP, IS_NOT_SELECTABLE, 0);
+
+    minimap->PrepareToFree = Minimap_PrepareToFree;
+    minimap->Resize        = Minimap_Resize;
+    minimap->ReactToEvent  = Minimap_ReactToEvent;
+    minimap->Update        = Minimap_Update;
+    minimap->Draw          = Minimap_Draw;
+    #ifdef DEBUG_MODE
+        minimap->PrintData = Minimap_PrintData;
+    #endif
+
+    MinimapData* data = Gadget_AllocateData(sizeof(MinimapData));
+    data->board = board;
+    data->mapIsValid = false;
+
+    minimap->data = data;
+
+    return minimap;
+}
+
+
+
+
+
+
+// ============================================================================ PRIVATE FUNC DEF
+
+// **************************************************************************** Minimap_PrepareToFree
+
+// Unload the texture and free the pixel map
+static void Minimap_PrepareToFree(Gadget* minimap){
+    if (MMDATA->map != NULL){
+        UnloadTexture(MMDATA->mapTexture);
+        MMDATA->map = Memory_Free(MMDATA->map);
+    }
+}
+
+
+// **************************************************************************** Minimap_Resize
+
+// Resize the minimap within its containing rectangle. Set it as collapsed
+static void Minimap_Resize(Gadget* minimap){
+    minimap->isSelected = false;
+    minimap->isPressed = false;
+    minimap->isExpanded = false;
+
+    Minimap_PlaceMap(minimap);
+}
+
+
+// **************************************************************************** Minimap_ReactToEvent
+
+// The minimap reacts to mouse events
+static void Minimap_ReactToEvent(Gadget* minimap, Event event, EventQueue* queue){
+    switch (event.id){
+        case EVENT_MOUSE_MOVE:{
+            bool isInside = Geo_PointIsInRect(event.data.mouse.pos, MMDATA->frameRect);
+            if (isInside == minimap->isExpanded) {break;}
+
+            minimap->isExpanded = isInside;
+            minimap->isPressed = false;
+            if (isInside){
+                Queue_AddEvent(queue, Event_SetAsGadgetExpanded(minimap->id));
+            }else{
+                Queue_AddEvent(queue, Event_SetAsGadgetCollapsed(minimap->id));
+            }
+            break;
+        }
+
+        case EVENT_MOUSE_PRESSED:{
+            if (!minimap->isExpanded) {break;}
+            if (!Geo_PointIsInRect(event.data.mouse.pos, MMDATA->frameRect)) {break;}
+            minimap->isPressed = true;
+            Minimap_EmitChanged(minimap, event.data.mouse.pos, queue);
+            break;
+        }
+
+        case EVENT_MOUSE_DRAG:{
+            if (!minimap->isPressed) {break;}
+            Minimap_EmitChanged(minimap, event.data.mouse.pos, queue);
+            break;
+        }
+
+        case EVENT_MOUSE_RELEASED:{
+            minimap->isPressed = false;
+            break;
+        }
+
+        default: {break;}
+    }
+}
+
+
+// **************************************************************************** Minimap_Update
+
+// Bring the pixel map up to date with the rod grid of the board, if its
+// version has changed
+static void Minimap_Update(Gadget* minimap, UNUSED EventQueue* queue){
+    const RGrid* rGrid = Board_GetRGrid(MMDATA->board);
+
+    if (MMDATA->mapIsValid && rGrid == MMDATA->rGrid && RGrid_GetVersion(rGrid) == MMDATA->version){
+        return;
+    }
+
+    Minimap_UpdateMap(minimap, rGrid);
+}
+
+
+// **************************************************************************** Minimap_Draw
+
+// Draw the frame, the pixel map and the viewport of the board
+static void Minimap_Draw(const Gadget* minimap, Vector2 shift){
+    if (!MMDATA->mapIsValid) {return;}
+
+    Color outlineColor = minimap->isExpanded ? COL_MINIMAP_EMPH : COL_MINIMAP_OUTLINE;
+    Shape_DrawOutlinedRect(Geo_TranslateRect(MMDATA->frameRect, shift), MINIMAP_THICKNESS, COL_MINIMAP_BG,
+                           outlineColor);
+
+    Rect mapRect = Geo_TranslateRect(MMDATA->mapRect, shift);
+    Rect src = RECT(0.0f, 0.0f, MMDATA->grid.nCols * MMDATA->cell, MMDATA->grid.nRows * MMDATA->cell);
+    DrawTexturePro(MMDATA->mapTexture, src, mapRect, POINT(0.0f, 0.0f), 0.0f, WHITE);
+
+    // The viewport, in the coordinates of the minimap, clipped to the map
+    const SGraph* sg = Board_GetSGraph(MMDATA->board);
+    Size vScreen = SGraph_GetVScreen(sg);
+    Rect viewport = SGraph_GetViewport(sg);
+
+    float scaleX = mapRect.width / vScreen.width;
+    float scaleY = mapRect.height / vScreen.height;
+
+    float left   = MAX(mapRect.x, mapRect.x + viewport.x * scaleX);
+    float top    = MAX(mapRect.y, mapRect.y + viewport.y * scaleY);
+    float right  = MIN(mapRect.x + mapRect.width,  mapRect.x + (viewport.x + viewport.width) * scaleX);
+    float bottom = MIN(mapRect.y + mapRect.height, mapRect.y + (viewport.y + viewport.height) * scaleY);
+    if (right <= left || bottom <= top) {return;}
+
+    Shape_DrawRectOutline(RECT(left, top, right - left, bottom - top), 1.0f, COL_MINIMAP_VIEWPORT);
+}
+
+
+// **************************************************************************** Minimap_PlaceMap
+
+// Place the map rectangle at the bottom left corner of the containing
+// rectangle, with a whole number of pixels per rod, and the frame around it.
+// Choose the cell of the pixel map, so that the map is only scaled by whole
+// numbers
+static void Minimap_PlaceMap(Gadget* minimap){
+    Grid grid = Board_GetGridSize(MMDATA->board);
+    Rect cRect = Geo_ApplyRectMargins(minimap->cRect, MINIMAP_MARGIN);
+
+    int rodSize = (int) (MIN(cRect.width, cRect.height) / MAX(grid.nCols, grid.nRows));
+    rodSize = PUT_IN_RANGE(rodSize, 1, MINIMAP_MAX_ROD_SIZE);
+
+    int cell = (rodSize >= MINIMAP_CELL) ? MINIMAP_CELL : 1;
+    if (cell != MMDATA->cell){
+        MMDATA->cell = cell;
+        MMDATA->mapIsValid = false;
+    }
+
+    Rect mapRect = RECT(0.0f, 0.0f, grid.nCols * rodSize, grid.nRows * rodSize);
+    MMDATA->mapRect = Geo_AlignRect(mapRect, cRect, RP_BOTTOM_LEFT);
+
+    MMDATA->frameRect = RECT(MMDATA->mapRect.x - MINIMAP_MARGIN, MMDATA->mapRect.y - MINIMAP_MARGIN,
+                             MMDATA->mapRect.width + 2.0f * MINIMAP_MARGIN,
+                             MMDATA->mapRect.height + 2.0f * MINIMAP_MARGIN);
+}
+
+
+// **************************************************************************** Minimap_UpdateMap
+
+// Bring the pixel map up to date with the rod grid. Remap the whole grid if
+// the grid or its size has changed, otherwise only the rods that have
+// changed. Upload the changed pixels to the texture
+static void Minimap_UpdateMap(Gadget* minimap, const RGrid* rGrid){
+    if (MMDATA->map == NULL){
+        MMDATA->map = Memory_Allocate(NULL, sizeof(Color) * MINIMAP_MAP_SIZE * MINIMAP_MAP_SIZE, ZEROVAL_ALL);
+        Image im = {.data = MMDATA->map, .width = MINIMAP_MAP_SIZE, .height = MINIMAP_MAP_SIZE,
+                    .mipmaps = 1, .format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+        MMDATA->mapTexture = LoadTextureFromImage(im);
+        MMDATA->mapIsValid = false;
+    }
+
+    Grid grid = RGrid_GetSize(rGrid);
+    if (grid.nCols != MMDATA->grid.nCols || grid.nRows != MMDATA->grid.nRows){
+        MMDATA->mapIsValid = false;
+        MMDATA->grid = grid;
+        Minimap_PlaceMap(minimap);
+    }
+
+    MMDATA->rGrid = rGrid;
+    MMDATA->version = RGrid_GetVersion(rGrid);
+
+    if (!MMDATA->mapIsValid){
+        for (int y = 0; y < grid.nRows; y++){
+            for (int x = 0; x < grid.nCols; x++){
+                const Rod* rod = RGrid_GetRod_Fast(rGrid, GNODE(x, y));
+                Minimap_MapRod(minimap, GNODE(x, y), rod->legs | (rod->isElectrified ? MINIMAP_ELECTRIFIED : 0));
+            }
+        }
+        UpdateTexture(MMDATA->mapTexture, MMDATA->map);
+
+        MMDATA->mapIsValid = true;
+        return;
+    }
+
+    // Remap the changed rods. Upload them one by one, or the whole map if
+    // there are many
+    int nDirty = 0;
+    for (int y = 0; y < grid.nRows; y++){
+        for (int x = 0; x < grid.nCols; x++){
+            const Rod* rod = RGrid_GetRod_Fast(rGrid, GNODE(x, y));
+            unsigned char state = rod->legs | (rod->isElectrified ? MINIMAP_ELECTRIFIED : 0);
+            if (state == MMDATA->mapped[y][x]) {continue;}
+
+            Minimap_MapRod(minimap, GNODE(x, y), state);
+            if (nDirty < MINIMAP_FULL_UPLOAD_N){
+                MMDATA->dirty[nDirty] = GNODE(x, y);
+            }
+            nDirty++;
+        }
+    }
+
+    if (nDirty > MINIMAP_FULL_UPLOAD_N){
+        UpdateTexture(MMDATA->mapTexture, MMDATA->map);
+    }else{
+        for (int i = 0; i < nDirty; i++){
+            Minimap_UploadRod(minimap, MMDATA->dirty[i]);
+        }
+    }
+}
+
+
+// **************************************************************************** Minimap_MapRod
+
+// Set the pixels of the rod in the pixel map: the center and the legs, in the
+// color of its electrification, or a single pixel if the cell is that small
+static void Minimap_MapRod(Gadget* minimap, GNode node, unsigned char state){
+    const int LEG_PIXELS[4][2] = {{2, 1}, {1, 2}, {0, 1}, {1, 0}};
+
+    Color color = (state & MINIMAP_ELECTRIFIED) ? COL_MINIMAP_ELECTRIFIED : COL_MINIMAP_ROD;
+    MMDATA->mapped[node.y][node.x] = state;
+
+    if (MMDATA->cell == 1){
+        MMDATA->map[node.y * MINIMAP_MAP_SIZE + node.x] = color;
+        return;
+    }
+
+    Color* cell = MMDATA->map + node.y * MINIMAP_CELL * MINIMAP_MAP_SIZE + node.x * MINIMAP_CELL;
+
+    for (int y = 0; y < MINIMAP_CELL; y++){
+        for (int x = 0; x < MINIMAP_CELL; x++){
+            cell[y * MINIMAP_MAP_SIZE + x] = BLANK;
+        }
+    }
+
+    cell[MINIMAP_MAP_SIZE + 1] = color;
+    for (int i = 0; i < 4; i++){
+        if (state & (1 << i)){
+            cell[LEG_PIXELS[i][1] * MINIMAP_MAP_SIZE + LEG_PIXELS[i][0]] = color;
+        }
+    }
+}
+
+
+// **************************************************************************** Minimap_UploadRod
+
+// Upload the pixels of the rod to the texture of the pixel map
+static void Minimap_UploadRod(Gadget* minimap, GNode node){
+    Color block[MINIMAP_CELL * MINIMAP_CELL];
+
+    int cell = MMDATA->cell;
+    int left = node.x * cell;
+    int top = node.y * cell;
+
+    for (int y = 0; y < cell; y++){
+        for (int x = 0; x < cell; x++){
+            block[y * cell + x] = MMDATA->map[(top + y) * MINIMAP_MAP_SIZE + left + x];
+        }
+    }
+
+    UpdateTextureRec(MMDATA->mapTexture, RECT(left, top, cell, cell), block);
+}
+
+
+// **************************************************************************** Minimap_EmitChanged
+
+// Emit a minimap changed event, that centers the viewport of the board at the
+// point of the rod grid under the given position
+static void Minimap_EmitChanged(const Gadget* minimap, Point pos, EventQueue* queue){
+    float xRatio = (pos.x - MMDATA->mapRect.x) / MMDATA->mapRect.width;
+    float yRatio = (pos.y - MMDATA->mapRect.y) / MMDATA->mapRect.height;
+
+    Queue_AddEvent(queue, Event_SetAsMinimapChanged(minimap->id, PUT_IN_RANGE(xRatio, 0.0f, 1.0f),
+                                                                 PUT_IN_RANGE(yRatio, 0.0f, 1.0f)));
+}
+
+
+#ifdef DEBUG_MODE
+// **************************************************************************** Minimap_PrintData
+
+    // Multiline print of the parameters of the data object of the minimap
+    static void Minimap_PrintData(const Gadget* minimap){
+        CHECK_NULL(minimap, WITH_NEW_LINE)
+        CHECK_NULL(minimap->data, WITH_NEW_LINE)
+
+        printf("Grid:        "); Grid_Print(MMDATA->grid, WITH_NEW_LINE);
+        printf("Version:     %u\n", MMDATA->version);
+        printf("Cell:        %d\n", MMDATA->cell);
+        printf("Map Valid:   %s\n", Bool_ToString(MMDATA->mapIsValid, LONG_FORM));
+        printf("Frame Rect:  "); Geo_PrintRect(MMDATA->frameRect, WITH_NEW_LINE);
+        printf("Map Rect:    "); Geo_PrintRect(MMDATA->mapRect, WITH_NEW_LINE);
+    }
+#endif
+
@@ -83,7 +83,7 @@ typedef struct NumBoxData{
     int value;
     int minValue;
     int maxValue;
-    char* txt;
+    char txt[INT_STR_SIZE];
     Rect boxRect;
     float thickness;
     float txtFontSize;
@@ -94,7 +94,6 @@ typedef struct NumBoxData{
 
 // ============================================================================ PRIVATE FUNC DECL
 
-static void     NumBox_PrepareToFree(Gadget* numbox);
 static void     NumBox_Resize(Gadget* numbox);
 static void     NumBox_ReactToEvent(Gadget* numbox, Event event, EventQueue* queue);
 static void     NumBox_Draw(const Gadget* numbox, Vector2 shift);
@@ -124,7 +123,6 @@ Gadget* NumBox_Make(E_GadgetID id, E_GadgetID upButtonID, E_GadgetID downButtonI
     Button_SetRoundness(btnDown, NB_BTN_ROUNDNESS);
     numbox->subGadgets[1] = btnDown;
 
-    numbox->PrepareToFree = NumBox_PrepareToFree;
     numbox->Resize        = NumBox_Resize;
     numbox->ReactToEvent  = NumBox_ReactToEvent;
     numbox->Draw          = NumBox_Draw;
@@ -132,7 +130,7 @@ Gadget* NumBox_Make(E_GadgetID id, E_GadgetID upButtonID, E_GadgetID downButtonI
         numbox->PrintData = NumBox_PrintData;
     #endif
 
-    NumBoxData* data = Memory_Allocate(NULL, sizeof(NumBoxData), ZEROVAL_ALL);
+    NumBoxData* data = Gadget_AllocateData(sizeof(NumBoxData));
 
     data->minValue = NB_DEF_MIN_VALUE;
     data->maxValue = NB_DEF_MAX_VALUE;
@@ -243,14 +241,6 @@ Gadget* NumBox_GetDownButton(const Gadget* numbox){
 
 // ============================================================================ PRIVATE FUNC DEF
 
-// **************************************************************************** NumBox_PrepareToFree
-
-// Free the text in the data object
-static void NumBox_PrepareToFree(Gadget* numbox){
-    NBDATA->txt = Memory_Free(NBDATA->txt);
-}
-
-
 // **************************************************************************** NumBox_Resize
 
 // Resize the number box, within its containing rectangle
@@ -308,13 +298,12 @@ static void NumBox_Draw(const Gadget* numbox, Vector2 shift){
 // Calculate the position of the numeric text in the box
 static void NumBox_RecalcTextForValue(Gadget* numbox, bool recalcFontSize){
     if (NBDATA->txtFontSize == 0.0f || recalcFontSize){
-        char* widestString = Memory_Allocate(NULL, NB_DIGITS_MAX_N + 1, ZEROVAL_LAST);
+        char widestString[NB_DIGITS_MAX_N + 1] = "";
         Memory_Set(widestString, NB_DIGITS_MAX_N, NB_WIDEST_CHAR);
         NBDATA->txtFontSize = Font_FitTextInSize(widestString, RSIZE(NBDATA->boxRect));
-        widestString = Memory_Free(widestString);
     }
 
-    NBDATA->txt = String_FromInt(NBDATA->txt, NBDATA->value);
+    String_WriteInt(NBDATA->txt, INT_STR_SIZE, NBDATA->value);
     Point center = Geo_RectPoint(NBDATA->boxRect, RP_CENTER);
     NBDATA->txtPos = Font_CalcTextPos(NBDATA->txt, NBDATA->txtFontSize, center, RP_CENTER);
 }
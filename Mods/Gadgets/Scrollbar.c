@@ -117,7 +117,7 @@ Gadget* Scrollbar_Make(E_GadgetID id, E_Orientation orientation){
         sbar->PrintData = Scrollbar_PrintData;
     #endif
 
-    ScrollbarData* data = Memory_Allocate(NULL, sizeof(ScrollbarData), ZEROVAL_ALL);
+    ScrollbarData* data = Gadget_AllocateData(sizeof(ScrollbarData));
     data->orientation = orientation;
 
     sbar->data = data;
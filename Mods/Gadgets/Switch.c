@@ -101,12 +101,13 @@ Gadget* Switch_Make(E_GadgetID id, bool value){
     sw->Resize        = Switch_Resize;
     sw->ReactToEvent  = Switch_ReactToEvent;
     sw->Update        = Switch_Update;
+    sw->IsAnimating   = Switch_IsAnimating;
     sw->Draw          = Switch_Draw;
     #ifdef DEBUG_MODE
         sw->PrintData = Switch_PrintData;
     #endif
 
-    SwitchData* data = Memory_Allocate(NULL, sizeof(SwitchData), ZEROVAL_ALL);
+    SwitchData* data = Gadget_AllocateData(sizeof(SwitchData));
     data->value = value;
     data->alignment = RP_CENTER;
 
@@ -142,7 +142,7 @@ Gadget* Table_Make(E_GadgetID id, int nCols, int nRows, const char** strings){
         table->PrintData         = Table_PrintData;
     #endif
 
-    TableData* data = Memory_Allocate(NULL, sizeof(TableData), ZEROVAL_ALL);
+    TableData* data = Gadget_AllocateData(sizeof(TableData));
     table->data = data;
 
     nCols = MAX(nCols, 1);
@@ -56,13 +56,15 @@
 
 // **************************************************************************** TimerData
 
-// The data object of the Timer gadget
+// The data object of the Timer gadget. hasTicked is true if the current time 
+// was incremented at the last update
 typedef struct TimerData{
     Time current;
     Time record;
 
     double t;
     double dt;
+    bool hasTicked;
 
     TimDisp* currentTimDisp[2]; // Long or short form
     TimDisp* recordTimDisp;
@@ -83,6 +85,7 @@ typedef struct TimerData{
 static void     Timer_PrepareToFree(Gadget* timer);
 static void     Timer_Resize(Gadget* timer);
 static void     Timer_Update(Gadget* timer, EventQueue* queue);
+static bool     Timer_IsAnimating(const Gadget* timer);
 static void     Timer_Draw(const Gadget* timer, Vector2 shift);
 #ifdef DEBUG_MODE
     static void Timer_PrintData(const Gadget* timer);
@@ -107,16 +110,17 @@ Gadget* Timer_Make(E_GadgetID id, Time currentTime, Time recordTime){
     timer->PrepareToFree = Timer_PrepareToFree;
     timer->Resize        = Timer_Resize;
     timer->Update        = Timer_Update;
+    timer->IsAnimating   = Timer_IsAnimating;
     timer->Draw          = Timer_Draw;
     #ifdef DEBUG_MODE
         timer->PrintData = Timer_PrintData;
     #endif
 
-    TimerData* data = Memory_Allocate(NULL, sizeof(TimerData), ZEROVAL_ALL);
+    TimerData* data = Gadget_AllocateData(sizeof(TimerData));
 
     data->current = currentTime;
     data->record = recordTime;
-    data->t = GetTime();
+    data->t = Window_GetTime();
     data->dt = 0.0;
 
     data->currentTimDisp[LONG_FORM]  = TimDisp_Make(RSIZE(GDG_DEF_RECT), RP_CENTER);
@@ -136,6 +140,7 @@ Gadget* Timer_Make(E_GadgetID id, Time currentTime, Time recordTime){
 // Pause the timer
 void Timer_Pause(Gadget* timer){
     timer->Update = NULL;
+    TIMDATA->hasTicked = false;
 }
 
 
@@ -143,7 +148,7 @@ void Timer_Pause(Gadget* timer){
 
 // Resume the timer
 void Timer_Resume(Gadget* timer){
-    TIMDATA->t = GetTime();
+    TIMDATA->t = Window_GetTime();
     timer->Update = Timer_Update;
 }
 
@@ -168,7 +173,7 @@ bool Timer_Toggle(Gadget* timer){
 void Timer_SetTime(Gadget* timer, Time time){
     TIMDATA->current = Time_IsValid(time) ? time : TIME_INVALID;
     TIMDATA->dt = 0.0;
-    TIMDATA->t = GetTime();
+    TIMDATA->t = Window_GetTime();
 }
 
 
@@ -304,17 +309,28 @@ static void Timer_Resize(Gadget* timer){
 
 // Increment the current time once per second
 static void Timer_Update(Gadget* timer, UNUSED EventQueue* queue){
-    double t = GetTime();
+    double t = Window_GetTime();
     TIMDATA->dt = t - TIMDATA->t;
+    TIMDATA->hasTicked = false;
 
     if (TIMDATA->dt >= 1.0){
         TIMDATA->current = Time_Increment(TIMDATA->current);
         TIMDATA->dt -= (double) ((int) TIMDATA->dt);
         TIMDATA->t = t;
+        TIMDATA->hasTicked = true;
     }
 }
 
 
+// **************************************************************************** Timer_IsAnimating
+
+// Return true if the current time changed at the last update, so it has to be 
+// drawn again
+static bool Timer_IsAnimating(const Gadget* timer){
+    return TIMDATA->hasTicked;
+}
+
+
 // **************************************************************************** Timer_Draw
 
 // Draw the timer in collpased or expanded form
@@ -149,13 +149,14 @@ Gadget* Toolbar_Make(void){
     toolbar->ResizeAfterSubgadgets = Toolbar_ResizeAfterSubgadgets;
     toolbar->ReactToEvent          = Toolbar_ReactToEvent;
     toolbar->Update                = Toolbar_Update;
+    toolbar->IsAnimating           = Toolbar_IsAnimating;
     toolbar->ChangeShift           = Toolbar_ChangeShift;
     toolbar->Draw                  = Toolbar_Draw;
     #ifdef DEBUG_MODE
         toolbar->PrintData         = Toolbar_PrintData;
     #endif
 
-    ToolbarData* data = Memory_Allocate(NULL, sizeof(ToolbarData), ZEROVAL_ALL);
+    ToolbarData* data = Gadget_AllocateData(sizeof(ToolbarData));
     toolbar->data = data;
 
     Gadget_Resize(toolbar);
@@ -243,9 +244,9 @@ void Toolbar_SetRecordTime(Gadget* toolbar, Time time){
 
 // Set the number shown by the rods left label
 void Toolbar_SetRodsLeft(Gadget* toolbar, int rodsLeft){
-    char* tempStr = String_FromInt(NULL, rodsLeft);
-    Label_SetText(TBGDG(TB_LBL_RODS_LEFT), tempStr);
-    tempStr = Memory_Free(tempStr);
+    char str[INT_STR_SIZE];
+    String_WriteInt(str, INT_STR_SIZE, rodsLeft);
+    Label_SetText(TBGDG(TB_LBL_RODS_LEFT), str);
 }
 
 
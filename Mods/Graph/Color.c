@@ -50,7 +50,7 @@ typedef union ColVal{
 
 // The magic colors changes gradually from the first to the last color in its 
 // spectrum. Then back to the first and then it pauses. It repeats with set 
-// period.
+// period. When stopped, it completes the current period and remains paused
 struct MagicColor{
     Color spectrum[MCOL_SPECTRUM_N];
 
@@ -58,6 +58,8 @@ struct MagicColor{
     int increment;
 
     int pauseCount;
+
+    bool isStopped;
 };
 
 
@@ -187,6 +189,7 @@ void MCol_Update(MagicColor* mcol){
     switch (mcol->increment){
         // Paused -> Ascending
         case 0:{
+            if (mcol->isStopped) {break;}
             mcol->pauseCount++;
             if (mcol->pauseCount >= MCOL_PAUSE_N){
                 mcol->pauseCount = 0;
@@ -231,6 +234,31 @@ void MCol_Reset(MagicColor* mcol){
 }
 
 
+// **************************************************************************** MCol_Stop
+
+// Let the magic color complete its current period and remain paused at the 
+// first color of the spectrum
+void MCol_Stop(MagicColor* mcol){
+    mcol->isStopped = true;
+}
+
+
+// **************************************************************************** MCol_Start
+
+// Let the magic color continue after its pause
+void MCol_Start(MagicColor* mcol){
+    mcol->isStopped = false;
+}
+
+
+// **************************************************************************** MCol_IsChanging
+
+// Return true if the magic color is not paused, so it changes at every update
+bool MCol_IsChanging(const MagicColor* mcol){
+    return mcol->increment != 0;
+}
+
+
 // **************************************************************************** MCol
 
 // Return the current color of the spectrum
@@ -278,6 +306,7 @@ void MCol_FreeDefault(void){
         printf("Index:       %d\n", mcol->index);
         printf("Increment:   %d\n", mcol->increment);
         printf("Pause Count: %d\n", mcol->pauseCount);
+        printf("Stopped:     %s\n", Bool_ToString(mcol->isStopped, LONG_FORM));
     }
 #endif
 
@@ -35,6 +35,7 @@
 #define FRECT_SPEEDS_N                      15
 #define FRECT_MIN_ALPHA                     0x20
 #define FRECT_MAX_ALPHA                     0x55
+#define FRECT_FADE_FRAMES_N                 (FPS / 2)
 
 
 // ============================================================================ PRIVATE STRUCTURES
@@ -56,10 +57,14 @@ typedef struct FRect{
 // **************************************************************************** FRects
 // Flying rectangles are the semitransparent rectangles that move from left to 
 // right, at different speeds, in the background. FRects is a collection of 
-// flying rectangles.
+// flying rectangles. When stopped, they fade out in fade frames and then stop 
+// moving. When started again, they fade in
 struct FRects{
     FRect rects[FRECT_MAX_N];
     int n;
+
+    int fade;
+    bool isStopped;
 };
 
 
@@ -86,6 +91,9 @@ static void     FRect_Update(FRect* fRect);
 FRects* FRects_Make(void){
     FRects* fRects = Memory_Allocate(NULL, sizeof(FRects), ZEROVAL_ALL);
 
+    fRects->fade = FRECT_FADE_FRAMES_N;
+    fRects->isStopped = false;
+
     FRects_Resize(fRects);
 
     return fRects;
@@ -127,8 +135,14 @@ void FRects_Resize(FRects* fRects){
 
 // **************************************************************************** FRects_Update
 
-// Update all the flying rectangles in the collection
+// Update the fading and all the flying rectangles in the collection. When 
+// faded out, do nothing
 void FRects_Update(FRects* fRects){
+    fRects->fade += fRects->isStopped ? -1 : 1;
+    fRects->fade = PUT_IN_RANGE(fRects->fade, 0, FRECT_FADE_FRAMES_N);
+
+    if (fRects->fade == 0) {return;}
+
     for (int i = 0; i < fRects->n; i++){
         FRect_Update(&(fRects->rects[i]));
     }
@@ -137,14 +151,42 @@ void FRects_Update(FRects* fRects){
 
 // **************************************************************************** FRects_Draw
 
-// Draw all the flying rectangles in the collection
+// Draw all the flying rectangles in the collection, faded if needed
 void FRects_Draw(const FRects* fRects){
+    if (fRects->fade == 0) {return;}
+
     for (int i = 0; i < fRects->n; i++){
-        DrawRectangleRec(fRects->rects[i].rect, fRects->rects[i].color);
+        Color color = fRects->rects[i].color;
+        color.a = (unsigned char) ((int) color.a * fRects->fade / FRECT_FADE_FRAMES_N);
+        DrawRectangleRec(fRects->rects[i].rect, color);
     }
 }
 
 
+// **************************************************************************** FRects_Stop
+
+// Fade out the flying rectangles and then stop them
+void FRects_Stop(FRects* fRects){
+    fRects->isStopped = true;
+}
+
+
+// **************************************************************************** FRects_Start
+
+// Fade in the flying rectangles and let them move again
+void FRects_Start(FRects* fRects){
+    fRects->isStopped = false;
+}
+
+
+// **************************************************************************** FRects_IsVisible
+
+// Return true if the flying rectangles are visible, even partly faded
+bool FRects_IsVisible(const FRects* fRects){
+    return fRects->fade > 0;
+}
+
+
 #ifdef DEBUG_MODE
 // **************************************************************************** FRects_Print
 
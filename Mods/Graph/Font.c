@@ -10,6 +10,32 @@
 /*
     Functions for calculating and drawing text with the default custom font at 
     Glo_Font.
+
+    The font is a signed distance field font at a small base size, drawn with 
+    the SDF shader, so the text stays sharp at every font size. The atlas 
+    holds a single channel, the distance of every pixel to the edge of the 
+    glyph, with the edge at 0.5. The glyphs are packed in rows, in a fixed 
+    size atlas, so the atlas and the glyph metrics are kept in the font cache 
+    file, with a key made from everything they depend on, and later starts 
+    only read and upload them. FONT_DATA_VERSION must change when the 
+    generation of the atlas changes. If the SDF shader fails, the font is 
+    rasterized at FONT_DEF_SIZE instead, as a plain bitmap font.
+
+    The text is measured with the advances of the glyphs, which are kept in a 
+    table at the font size of the font, so raylib's MeasureTextEx is only 
+    needed for characters outside the loaded glyphs. The size of a text grows 
+    linearly with the font size, so a text is measured only once, at the font 
+    size of the font, and the metrics are kept in a small cache. The size of 
+    the text at any font size, and the fitting of the font size by binary 
+    search, are then calculated from the cached metrics, without going through 
+    the text again.
+
+    The number of texts that are measured character by character is counted, 
+    to check the cost of the text layout in every frame.
+
+    Text that changes only a few characters at a time, like the timer 
+    display, can keep its glyphs as glyph quads, made once, and draw them 
+    all in a single batch.
 */
 
 
@@ -18,11 +44,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <raylib.h>
+#include <rlgl.h>
 
 #include "../Assets/Assets.h"
 
 #include "../Public/Public.h"
 #include "../Fund/Fund.h"
+#include "../Store/Store.h"
 #include "Graph.h"
 
 
@@ -31,6 +59,96 @@
 #define FONT_FIRST_GLYPH                    32
 #define FONT_LAST_GLYPH                     127
 #define FONT_GLYPHS_N                       (FONT_LAST_GLYPH - FONT_FIRST_GLYPH + 1)
+#define FONT_LINE_SPACING                   1.5f
+
+#define FONT_SDF_SIZE                       48
+#define FONT_ATLAS_WIDTH                    1024
+#define FONT_ATLAS_HEIGHT                   512
+#define FONT_ATLAS_GAP                      2
+
+#define FONT_DATA_VERSION                   1
+
+// The font data is the glyph metrics followed by the atlas
+#define FONT_GLYPH_DATA_SIZE                ((int) sizeof(FontGlyph) * FONT_GLYPHS_N)
+#define FONT_ATLAS_DATA_SIZE                (FONT_ATLAS_WIDTH * FONT_ATLAS_HEIGHT)
+#define FONT_DATA_SIZE                      (FONT_GLYPH_DATA_SIZE + FONT_ATLAS_DATA_SIZE)
+
+#define FONT_CACHE_N                        128
+#define FONT_CACHE_TXT_SIZE                 48
+
+#define FONT_FIT_PRECISION                  0.01f
+#define FONT_FIT_MIN_SIZE                   1.0f
+
+
+// ============================================================================ PRIVATE STRUCTURES
+
+// **************************************************************************** FontGlyph
+// The metrics of a glyph of the SDF font and its rectangle in the atlas, as 
+// kept in the font cache file
+typedef struct FontGlyph{
+    int value;
+    int offsetX;
+    int offsetY;
+    int advanceX;
+    Rect rec;
+}FontGlyph;
+
+
+// **************************************************************************** FontMetrics
+// The metrics of a text at the font size of the font, from which its size at 
+// any font size is calculated. Width is the width of the widest line without 
+// the spacing, and maxLen the number of characters of the longest line, as 
+// in MeasureTextEx
+typedef struct FontMetrics{
+    unsigned int hash;
+    char txt[FONT_CACHE_TXT_SIZE];
+    float width;
+    int maxLen;
+    int nLines;
+}FontMetrics;
+
+
+// ============================================================================ PRIVATE VARIABLES
+
+// Fragment shader of the SDF font. The distance is in the single channel of 
+// the atlas, with the edge of the glyph at 0.5, and is smoothed over about a 
+// pixel of the screen, at every font size
+static const char* fontSdfFS =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "out vec4 finalColor;\n"
+    "void main(){\n"
+    "    float dist = texture(texture0, fragTexCoord).r;\n"
+    "    float smoothing = max(fwidth(dist) * 0.7, 0.00001);\n"
+    "    float coverage = smoothstep(0.5 - smoothing, 0.5 + smoothing, dist);\n"
+    "    finalColor = vec4(fragColor.rgb, fragColor.a * coverage) * colDiffuse;\n"
+    "}\n";
+
+// The shader of the SDF font, or an unloaded shader for the bitmap font
+static Shader fontShader = {0};
+
+
+// The advances of the loaded glyphs at the font size of the font
+static float fontAdvances[FONT_GLYPHS_N];
+
+// The metrics of the recently measured texts, by their hash
+static FontMetrics fontCache[FONT_CACHE_N];
+
+
+// ============================================================================ PRIVATE FUNC DECL
+
+static Font      Font_LoadBitmap(void);
+static bool     Font_LoadData(unsigned char* data, bool withCache);
+static unsigned int Font_MakeDataKey(void);
+static void     Font_GenerateData(unsigned char* data);
+static Font     Font_LoadSDF(const unsigned char* data);
+static void     Font_ClearCache(void);
+static void     Font_GetMetrics(const char* txt, FontMetrics* metrics);
+static void     Font_MeasureText(const char* txt, FontMetrics* metrics);
+static Size     Font_MetricsToSize(const FontMetrics* metrics, float fontSize);
 
 
 
@@ -41,29 +159,62 @@
 
 // **************************************************************************** Font_LoadDefault
 
-// Load the default custom font at the global Glo_Font
-void Font_LoadDefault(void){
-    int* glyphs = Memory_Allocate(NULL, sizeof(int) * FONT_GLYPHS_N, ZEROVAL_ALL);
+// Load the default custom font at the global Glo_Font and make the table of 
+// the advances of its glyphs. The SDF font comes from the font cache file if 
+// it is valid and the cache is used. If the SDF shader fails, load the bitmap 
+// font
+void Font_LoadDefault(bool withCache){
+    double startTime = GetTime();
+
+    fontShader = LoadShaderFromMemory(NULL, fontSdfFS);
+
+    bool withSDF = (fontShader.id != rlGetShaderIdDefault());
+    bool isCached = false;
+
+    if (withSDF){
+        unsigned char* data = Memory_Allocate(NULL, FONT_DATA_SIZE, ZEROVAL_NONE);
+        isCached = Font_LoadData(data, withCache);
+        Glo_Font = Font_LoadSDF(data);
+        data = Memory_Free(data);
+    }else{
+        UnloadShader(fontShader);
+        fontShader = (Shader) {0};
+        Glo_Font = Font_LoadBitmap();
+    }
 
+    Err_Assert(Glo_Font.baseSize > 0 && Glo_Font.texture.id != 0, "Failed to load the font");
+
+    // The same advance as in MeasureTextEx
     for (int i = 0; i < FONT_GLYPHS_N; i++){
-        glyphs[i] = FONT_FIRST_GLYPH + i;
+        int index = GetGlyphIndex(Glo_Font, FONT_FIRST_GLYPH + i);
+        fontAdvances[i] = (Glo_Font.glyphs[index].advanceX != 0) ?
+                          (float) Glo_Font.glyphs[index].advanceX :
+                          Glo_Font.recs[index].width + (float) Glo_Font.glyphs[index].offsetX;
     }
 
-    Glo_Font = LoadFontFromMemory(".ttf", Asset_Font_HeyComic, Asset_Font_HeyComic_Size, 
-                                  FONT_DEF_SIZE, glyphs, FONT_GLYPHS_N);
-
-    glyphs = Memory_Free(glyphs);
+    Font_ClearCache();
 
-    Err_Assert(Glo_Font.baseSize > 0, "Failed to load the font");
+    Texture2D atlas = Glo_Font.texture;
+    TraceLog(LOG_INFO, "FONT: Loaded the %s font in %.1f ms (%s, %d x %d atlas, %d KB)", 
+             withSDF ? "SDF" : "bitmap", (GetTime() - startTime) * 1000.0, 
+             isCached ? "from cache" : "generated", atlas.width, atlas.height, 
+             GetPixelDataSize(atlas.width, atlas.height, atlas.format) / 1024);
 }
 
 
 // **************************************************************************** Font_UnloadDefault
 
-// Unload the default custom font at the flobal Glo_Font
+// Unload the default custom font at the flobal Glo_Font and its shader
 void Font_UnloadDefault(void){
     UnloadFont(Glo_Font);
     Glo_Font = (Font) {0};
+
+    if (fontShader.id != 0){
+        UnloadShader(fontShader);
+        fontShader = (Shader) {0};
+    }
+
+    Font_ClearCache();
 }
 
 
@@ -72,8 +223,10 @@ void Font_UnloadDefault(void){
 // Calculate the size of the text, rendered with the default custom font and 
 // the given font size
 Size Font_CalcTextSize(const char* txt, float fontSize){
-    Vector2 vectorSize = MeasureTextEx(Glo_Font, txt, fontSize, FONT_SPACING);
-    return SIZE(vectorSize.x, vectorSize.y);
+    FontMetrics metrics;
+    Font_GetMetrics(txt, &metrics);
+
+    return Font_MetricsToSize(&metrics, fontSize);
 }
 
 
@@ -100,27 +253,361 @@ Point Font_CalcTextPos(const char* txt, float fontSize, Point pos, E_RectPointTy
 // **************************************************************************** Font_FitTextInSize
 
 // The maximum font size, for which the text, rendered with the default custom 
-// font, fits inside the containing size
+// font, fits inside the containing size. The width of the text grows with the 
+// font size, so the font size is found by binary search on the metrics of the 
+// text, which are measured only once
 float Font_FitTextInSize(const char* txt, Size cSize){
-    float fontSize = cSize.height;
-
-    while (Font_CalcTextSize(txt, fontSize).width > cSize.width){
-        fontSize -= 1.0f;
-        if (fontSize < 1.0f){
-            break;
+    FontMetrics metrics;
+    Font_GetMetrics(txt, &metrics);
+
+    float maxSize = cSize.height;
+    if (Font_MetricsToSize(&metrics, maxSize).width <= cSize.width) {return maxSize;}
+
+    float minSize = MIN(FONT_FIT_MIN_SIZE, maxSize);
+    if (Font_MetricsToSize(&metrics, minSize).width > cSize.width)  {return minSize;}
+
+    // The text always fits at minSize and never at maxSize
+    while (maxSize - minSize > FONT_FIT_PRECISION){
+        float fontSize = (minSize + maxSize) * 0.5f;
+        if (Font_MetricsToSize(&metrics, fontSize).width <= cSize.width){
+            minSize = fontSize;
+        }else{
+            maxSize = fontSize;
         }
     }
 
-    return fontSize;
+    return minSize;
 }
 
 
+
 // **************************************************************************** Font_DrawText
 
 // Draw the text, rendered with the default custom font
 void Font_DrawText(const char* txt, float fontSize, Point pos, Color color){
+    if (fontShader.id == 0){
+        DrawTextEx(Glo_Font, txt, pos, fontSize, FONT_SPACING, color);
+        return;
+    }
+
+    BeginShaderMode(fontShader);
     DrawTextEx(Glo_Font, txt, pos, fontSize, FONT_SPACING, color);
+    EndShaderMode();
+}
+
+
+// **************************************************************************** Font_MakeGlyphQuad
+
+// Make the glyph quad of the character, rendered with the default custom font 
+// and the given font size at the given position, the same as in DrawTextEx. 
+// The quad of a space is empty
+GlyphQuad Font_MakeGlyphQuad(char c, float fontSize, Point pos){
+    if (c == ' ' || Glo_Font.baseSize <= 0) {return (GlyphQuad) {0};}
+
+    int index = GetGlyphIndex(Glo_Font, (unsigned char) c);
+    float scale = fontSize / (float) Glo_Font.baseSize;
+    float padding = (float) Glo_Font.glyphPadding;
+    Rect rec = Glo_Font.recs[index];
+
+    GlyphQuad res;
+    res.src = RECT(rec.x - padding, rec.y - padding, rec.width + 2.0f * padding, rec.height + 2.0f * padding);
+    res.dst = RECT(pos.x + ((float) Glo_Font.glyphs[index].offsetX - padding) * scale, 
+                   pos.y + ((float) Glo_Font.glyphs[index].offsetY - padding) * scale, 
+                   res.src.width * scale, res.src.height * scale);
+
+    return res;
+}
+
+
+// **************************************************************************** Font_DrawGlyphQuads
+
+// Draw the glyph quads, translated by pos, as a single batch of quads of the 
+// font atlas
+void Font_DrawGlyphQuads(const GlyphQuad* quads, int n, Point pos, Color color){
+    float atlasW = (float) Glo_Font.texture.width;
+    float atlasH = (float) Glo_Font.texture.height;
+    if (n <= 0 || atlasW <= 0.0f || atlasH <= 0.0f) {return;}
+
+    if (fontShader.id != 0) {BeginShaderMode(fontShader);}
+
+    rlCheckRenderBatchLimit(4 * n);
+    rlSetTexture(Glo_Font.texture.id);
+    rlBegin(RL_QUADS);
+    rlColor4ub(color.r, color.g, color.b, color.a);
+    rlNormal3f(0.0f, 0.0f, 1.0f);
+
+    for (int i = 0; i < n; i++){
+        Rect src = quads[i].src;
+        Rect dst = Geo_TranslateRect(quads[i].dst, pos);
+
+        float u0 = src.x / atlasW, v0 = src.y / atlasH;
+        float u1 = (src.x + src.width) / atlasW, v1 = (src.y + src.height) / atlasH;
+
+        rlTexCoord2f(u0, v0);
+        rlVertex2f(dst.x, dst.y);
+        rlTexCoord2f(u0, v1);
+        rlVertex2f(dst.x, dst.y + dst.height);
+        rlTexCoord2f(u1, v1);
+        rlVertex2f(dst.x + dst.width, dst.y + dst.height);
+        rlTexCoord2f(u1, v0);
+        rlVertex2f(dst.x + dst.width, dst.y);
+    }
+
+    rlEnd();
+    rlSetTexture(0);
+
+    if (fontShader.id != 0) {EndShaderMode();}
+}
+
+
+
+
+
+
+// ============================================================================ PRIVATE FUNC DEF
+
+// **************************************************************************** Font_LoadBitmap
+
+// Load the bitmap font, rasterized at FONT_DEF_SIZE
+static Font Font_LoadBitmap(void){
+    int* glyphs = Memory_Allocate(NULL, sizeof(int) * FONT_GLYPHS_N, ZEROVAL_ALL);
+
+    for (int i = 0; i < FONT_GLYPHS_N; i++){
+        glyphs[i] = FONT_FIRST_GLYPH + i;
+    }
+
+    Font res = LoadFontFromMemory(".ttf", Asset_Font_HeyComic, Asset_Font_HeyComic_Size, 
+                                  FONT_DEF_SIZE, glyphs, FONT_GLYPHS_N);
+
+    glyphs = Memory_Free(glyphs);
+
+    return res;
+}
+
+
+// **************************************************************************** Font_LoadData
+
+// Read the glyph metrics and the atlas of the SDF font from the font cache 
+// file. If they are not valid, generate them and write them to the file. 
+// Without the cache, only generate them. Return true if the data was read 
+// from the file
+static bool Font_LoadData(unsigned char* data, bool withCache){
+    if (!withCache){
+        Font_GenerateData(data);
+        return false;
+    }
+
+    unsigned int key = Font_MakeDataKey();
+    char* path = Path_GetFontFile();
+
+    bool isCached = TData_ReadFromFile(path, key, data, FONT_DATA_SIZE);
+    if (!isCached){
+        Font_GenerateData(data);
+
+        // A failed write only means that the next start generates the data again
+        TData_WriteToFile(path, key, data, FONT_DATA_SIZE);
+    }
+
+    path = Memory_Free(path);
+
+    return isCached;
+}
+
+
+// **************************************************************************** Font_MakeDataKey
+
+// The key of the font data in the font cache file, from the version of the 
+// data, the layout of the atlas, the version of raylib, which makes the 
+// distance fields, and the font file itself
+static unsigned int Font_MakeDataKey(void){
+    const int layout[] = {
+        FONT_DATA_VERSION, FONT_SDF_SIZE, FONT_ATLAS_WIDTH, FONT_ATLAS_HEIGHT, FONT_ATLAS_GAP, FONT_FIRST_GLYPH, 
+        FONT_LAST_GLYPH, (int) sizeof(FontGlyph)
+    };
+
+    unsigned int key = Math_Hash(0, layout, sizeof(layout));
+    key = Math_Hash(key, RAYLIB_VERSION, String_Length(RAYLIB_VERSION));
+
+    return Math_Hash(key, Asset_Font_HeyComic, Asset_Font_HeyComic_Size);
 }
 
 
+// **************************************************************************** Font_GenerateData
+
+// Generate the distance fields of the glyphs and pack them in rows in the 
+// atlas, with FONT_ATLAS_GAP transparent pixels around every glyph
+static void Font_GenerateData(unsigned char* data){
+    int codepoints[FONT_GLYPHS_N];
+    for (int i = 0; i < FONT_GLYPHS_N; i++){
+        codepoints[i] = FONT_FIRST_GLYPH + i;
+    }
+
+    GlyphInfo* glyphs = LoadFontData(Asset_Font_HeyComic, Asset_Font_HeyComic_Size, FONT_SDF_SIZE, 
+                                     codepoints, FONT_GLYPHS_N, FONT_SDF);
+    Err_Assert(glyphs != NULL, "Failed to load the font");
+
+    FontGlyph* fontGlyphs = (FontGlyph*) data;
+    unsigned char* atlas = data + FONT_GLYPH_DATA_SIZE;
+    Memory_Set(atlas, FONT_ATLAS_DATA_SIZE, 0);
+
+    int x = FONT_ATLAS_GAP, y = FONT_ATLAS_GAP, rowHeight = 0;
+    for (int i = 0; i < FONT_GLYPHS_N; i++){
+        Image im = glyphs[i].image;
+        Err_Assert(im.data == NULL || im.format == PIXELFORMAT_UNCOMPRESSED_GRAYSCALE, 
+                   "Invalid distance field of the font");
+
+        // Start a new row
+        if (x + im.width + FONT_ATLAS_GAP > FONT_ATLAS_WIDTH){
+            x = FONT_ATLAS_GAP;
+            y += rowHeight + FONT_ATLAS_GAP;
+            rowHeight = 0;
+        }
+        Err_Assert(y + im.height + FONT_ATLAS_GAP <= FONT_ATLAS_HEIGHT, "The font atlas is too small");
+
+        if (im.data != NULL){
+            for (int row = 0; row < im.height; row++){
+                Memory_Write(atlas + (y + row) * FONT_ATLAS_WIDTH + x, 
+                             (unsigned char*) im.data + row * im.width, im.width);
+            }
+        }
+
+        fontGlyphs[i] = (FontGlyph) {
+            .value = glyphs[i].value, .offsetX = glyphs[i].offsetX, .offsetY = glyphs[i].offsetY, 
+            .advanceX = glyphs[i].advanceX, .rec = RECT(x, y, im.width, im.height)
+        };
+
+        x += im.width + FONT_ATLAS_GAP;
+        rowHeight = MAX(rowHeight, im.height);
+    }
+
+    UnloadFontData(glyphs, FONT_GLYPHS_N);
+}
+
+
+// **************************************************************************** Font_LoadSDF
+
+// Load the SDF font from the glyph metrics and the atlas of the data. The 
+// glyphs and their rectangles are allocated by raylib, since UnloadFont 
+// frees them. The distance fields are padded, so the glyph padding is 0
+static Font Font_LoadSDF(const unsigned char* data){
+    Font res = {.baseSize = FONT_SDF_SIZE, .glyphCount = FONT_GLYPHS_N, .glyphPadding = 0};
+
+    res.glyphs = MemAlloc(sizeof(GlyphInfo) * FONT_GLYPHS_N);
+    res.recs = MemAlloc(sizeof(Rectangle) * FONT_GLYPHS_N);
+
+    const FontGlyph* fontGlyphs = (const FontGlyph*) data;
+    for (int i = 0; i < FONT_GLYPHS_N; i++){
+        res.glyphs[i] = (GlyphInfo) {
+            .value = fontGlyphs[i].value, .offsetX = fontGlyphs[i].offsetX, 
+            .offsetY = fontGlyphs[i].offsetY, .advanceX = fontGlyphs[i].advanceX
+        };
+        res.recs[i] = fontGlyphs[i].rec;
+    }
+
+    Image atlas = {
+        .data = (void*) (data + FONT_GLYPH_DATA_SIZE), .width = FONT_ATLAS_WIDTH, 
+        .height = FONT_ATLAS_HEIGHT, .mipmaps = 1, .format = PIXELFORMAT_UNCOMPRESSED_GRAYSCALE
+    };
+    res.texture = LoadTextureFromImage(atlas);
+    SetTextureFilter(res.texture, TEXTURE_FILTER_BILINEAR);
+
+    return res;
+}
+
+
+
+// **************************************************************************** Font_ClearCache
+
+// Remove all the texts from the cache of the metrics
+static void Font_ClearCache(void){
+    for (int i = 0; i < FONT_CACHE_N; i++){
+        fontCache[i] = (FontMetrics) {0};
+    }
+}
+
+
+// **************************************************************************** Font_GetMetrics
+
+// Get the metrics of the text from the cache, or measure it and keep it in 
+// the cache. Texts that do not fit in the cache are measured every time
+static void Font_GetMetrics(const char* txt, FontMetrics* metrics){
+    int length = String_Length(txt);
+    unsigned int hash = Math_Hash(0, txt, length);
+    FontMetrics* cached = &fontCache[hash % FONT_CACHE_N];
+
+    if (length < FONT_CACHE_TXT_SIZE && cached->hash == hash && String_IsEqual(cached->txt, txt)){
+        *metrics = *cached;
+        return;
+    }
+
+    Counter_Add(CNT_FONT_MEASURES, 1);
+
+    Font_MeasureText(txt, metrics);
+    if (length >= FONT_CACHE_TXT_SIZE) {return;}
+
+    *cached = *metrics;
+    cached->hash = hash;
+    for (int i = 0; i <= length; i++){
+        cached->txt[i] = txt[i];
+    }
+}
+
+
+// **************************************************************************** Font_MeasureText
+
+// Measure the text at the font size of the font, character by character, 
+// with the table of the advances. A text with characters outside the loaded 
+// glyphs is measured with MeasureTextEx instead, without the spacing
+static void Font_MeasureText(const char* txt, FontMetrics* metrics){
+    *metrics = (FontMetrics) {.nLines = 1};
+
+    bool hasOnlyGlyphs = true;
+    float lineWidth = 0.0f;
+    int lineLen = 0;
+
+    for (const unsigned char* c = (const unsigned char*) txt; *c != '\0'; c++){
+        if (*c == '\n'){
+            metrics->width = MAX(metrics->width, lineWidth);
+            metrics->nLines++;
+            lineWidth = 0.0f;
+            lineLen = 0;
+            continue;
+        }
+
+        if (IS_IN_RANGE(*c, FONT_FIRST_GLYPH, FONT_LAST_GLYPH)){
+            lineWidth += fontAdvances[*c - FONT_FIRST_GLYPH];
+        }else{
+            hasOnlyGlyphs = false;
+        }
+
+        // The continuation bytes of UTF-8 are not counted as characters
+        if ((*c & 0xC0) != 0x80){
+            lineLen++;
+            metrics->maxLen = MAX(metrics->maxLen, lineLen);
+        }
+    }
+
+    metrics->width = MAX(metrics->width, lineWidth);
+
+    if (!hasOnlyGlyphs){
+        metrics->width = MeasureTextEx(Glo_Font, txt, (float) Glo_Font.baseSize, 0.0f).x;
+    }
+}
+
+
+// **************************************************************************** Font_MetricsToSize
+
+// Calculate the size of the text with the given metrics at the given font 
+// size, the same as MeasureTextEx
+static Size Font_MetricsToSize(const FontMetrics* metrics, float fontSize){
+    if (Glo_Font.baseSize <= 0) {return SIZE(0.0f, 0.0f);}
+
+    float scale = fontSize / (float) Glo_Font.baseSize;
+    float width = (metrics->maxLen == 0) ? 0.0f :
+                  metrics->width * scale + (float) (metrics->maxLen - 1) * FONT_SPACING;
+    float height = fontSize * (1.0f + FONT_LINE_SPACING * (float) (metrics->nLines - 1));
+
+    return SIZE(width, height);
+}
+
 
@@ -46,6 +46,9 @@ MagicColor*     MCol_Make(Color color1, Color color2);
 MagicColor*     MCol_Free(MagicColor* mcol);
 void            MCol_Update(MagicColor* mcol);
 void            MCol_Reset(MagicColor* mcol);
+void            MCol_Stop(MagicColor* mcol);
+void            MCol_Start(MagicColor* mcol);
+bool            MCol_IsChanging(const MagicColor* mcol);
 Color           MCol(const MagicColor* mcol);
 void            MCol_MakeDefault(void);
 void            MCol_FreeDefault(void);
@@ -60,6 +63,9 @@ FRects*         FRects_Free(FRects* fRects);
 void            FRects_Resize(FRects* fRects);
 void            FRects_Update(FRects* fRects);
 void            FRects_Draw(const FRects* fRects);
+void            FRects_Stop(FRects* fRects);
+void            FRects_Start(FRects* fRects);
+bool            FRects_IsVisible(const FRects* fRects);
 #ifdef DEBUG_MODE
     void        FRects_Print(const FRects* fRects);
 #endif
@@ -123,13 +129,15 @@ Point           SGraph_GetOrigin(const SGraph* sg);
 
 // ---------------------------------------------------------------------------- Font Functions
 
-void            Font_LoadDefault(void);
+void            Font_LoadDefault(bool withCache);
 void            Font_UnloadDefault(void);
 Size            Font_CalcTextSize(const char* txt, float fontSize);
 Rect            Font_CalcTextRect(const char* txt, float fontSize, Point pos, E_RectPointType pointType);
 Point           Font_CalcTextPos(const char* txt, float fontSize, Point pos, E_RectPointType pointType);
 float           Font_FitTextInSize(const char* txt, Size cSize);
 void            Font_DrawText(const char* txt, float fontSize, Point pos, Color color);
+GlyphQuad       Font_MakeGlyphQuad(char c, float fontSize, Point pos);
+void            Font_DrawGlyphQuads(const GlyphQuad* quads, int n, Point pos, Color color);
 
 // ---------------------------------------------------------------------------- Shape Functions
 
@@ -144,10 +152,12 @@ void            Shape_DrawCircleInImage(Image* im, Point center, float radius, C
 void            Shape_DrawRodInImage(Image* im, int legs, Color color);
 void            Shape_DrawSource(Point pos, float tileSize, Color color);
 void            Shape_DrawSelBoxInImage(Image* im, Color color);
+float           Shape_GetLegWidthRatio(void);
+unsigned int    Shape_HashImageGeometry(unsigned int hash);
 
 // ---------------------------------------------------------------------------- Texture Functions
 
-void            Texture_LoadAll(void);
+void            Texture_LoadAll(bool withCache);
 void            Texture_UnloadAll(void);
 #ifdef DEBUG_MODE
     void        Texture_PrintAll(void);
@@ -163,10 +173,27 @@ float           RGraph_GetScaleF(const RodModel* rodModel);
 float           RGraph_GetAngle(const RodModel* rodModel, int frame);
 Vector2         RGraph_GetShift(const RodModel* rodModel, int frame);
 void            RGraph_DrawRod(const Rod* rod, Point pos, const RodModel* rodModel);
+void            RGraph_DrawColoredRod(const Rod* rod, Point pos, Color color, const RodModel* rodModel);
 void            RGraph_DrawRGrid(const RGrid* rGrid, Grid visible, Point pos, const RodModel* rodModel);
+void            RGraph_DrawSource(const RGrid* rGrid, Grid visible, Point pos, const RodModel* rodModel);
 void            RGraph_DrawSelBox(Point pos, const RodModel* rodModel);
+void            RGraph_BeginRodMode(void);
+void            RGraph_EndRodMode(void);
 #ifdef DEBUG_MODE
     void        RGraph_PrintRodModel(RodModel* rodModel);
+    void        RGraph_CompareRodRenderers(const RGrid* rGrid);
+#endif
+
+// ---------------------------------------------------------------------------- Rod Cache Functions
+
+RCache*         RCache_Make(void);
+RCache*         RCache_Free(RCache* rCache);
+void            RCache_Invalidate(RCache* rCache);
+void            RCache_Update(RCache* rCache, const RGrid* rGrid, Grid visible, Point pos, Rect area, 
+                              const RodModel* rodModel);
+void            RCache_Draw(const RCache* rCache, Vector2 shift);
+#ifdef DEBUG_MODE
+    void        RCache_Print(const RCache* rCache);
 #endif
 
 // ---------------------------------------------------------------------------- Timer Display Functions
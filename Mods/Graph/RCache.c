@@ -0,0 +1,547 @@
+// ============================================================================
+// RODS
+// Rod Cache
+// by Andreas Socratous
+// Jan 2023
+// ============================================================================
+
+
+// ============================================================================ INFO
+/*
+    Functions for managing the rod cache.
+
+    The rod cache keeps the visible part of the rod grid in render textures,
+    so an unchanged board is drawn with a single blit of each texture, instead
+    of a quad for every rod.
+
+    The cache remembers the state of every rod, as it was drawn. At every
+    update, the rods are compared to their drawn state and only the tiles of
+    the rods that were rotated, are animating or changed electrification are
+    cleared and redrawn. A change of the view redraws the whole cache.
+
+    The electrified rods are drawn in white in a separate layer, which serves
+    as a tint mask. It is tinted with the magic color when blitted, so the
+    cycling of the magic color does not require any redraw.
+
+    The layers store their colors premultiplied by alpha, so the antialiased
+    edges of the rods look the same as when drawn directly on the screen.
+
+    LEVEL OF DETAIL:
+    When the tiles are smaller than RCACHE_LOD_TILE_SIZE, the scaled rod
+    textures would only alias, so the rods are drawn from a pixel map
+    instead. The board zooms out down to ROD_MIN_TILE_SIZE, so that the
+    pixel map is never scaled down, and every draw from the pixel map is
+    counted by CNT_LOD_DRAWS. The pixel map has RCACHE_MAP_CELL x RCACHE_MAP_CELL pixels for
+    every rod of the grid: the center and the legs. Like the render 
+    textures, it has a plain and an electrified layer, side by side. It is 
+    kept on the CPU and only the pixels of the changed rods are uploaded to 
+    its texture. The whole visible part is drawn as two quads of the same 
+    texture. The pixel map does not show the rotation animation.
+*/
+
+
+// ============================================================================ DEPENDENCIES
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <raylib.h>
+#include <rlgl.h>
+
+#include "../Public/Public.h"
+#include "../Fund/Fund.h"
+#include "../Logic/Logic.h"
+#include "Graph.h"
+
+
+// ============================================================================ PRIVATE CONSTANTS
+
+#define RCACHE_LAYER_PLAIN                  0
+#define RCACHE_LAYER_ELECTRIFIED            1
+#define RCACHE_LAYERS_N                     2
+
+#define RCACHE_FULL_REDRAW_RATIO            0.5f
+
+#define RCACHE_LOD_TILE_SIZE                8.0f
+#define RCACHE_MAP_CELL                     3
+#define RCACHE_MAP_LAYER_WIDTH              (RGRID_MAX_SIZE * RCACHE_MAP_CELL)
+#define RCACHE_MAP_WIDTH                    (RCACHE_MAP_LAYER_WIDTH * RCACHE_LAYERS_N)
+#define RCACHE_MAP_HEIGHT                   (RGRID_MAX_SIZE * RCACHE_MAP_CELL)
+#define RCACHE_MAP_FULL_UPLOAD_N            64
+
+_Static_assert((int) RCACHE_LOD_TILE_SIZE > (int) ROD_MIN_TILE_SIZE, "The board never zooms out to the pixel map");
+
+
+// ============================================================================ OPAQUE STRUCTURES
+
+// **************************************************************************** RCache
+
+// The render textures of the plain and the electrified rods, the view they
+// were drawn for and the drawn state of every rod. pos is the top left corner
+// of the visible part in the render textures. The pixel map of the grid, its
+// texture and the mapped state of every rod, for the lower level of detail
+struct RCache{
+    RenderTexture2D layers[RCACHE_LAYERS_N];
+    int width;
+    int height;
+    Point areaPos;
+
+    bool isValid;
+    Grid visible;
+    Point pos;
+    float tileSize;
+
+    Rod drawn[RGRID_MAX_SIZE][RGRID_MAX_SIZE];
+    GNode dirty[RGRID_MAX_SIZE * RGRID_MAX_SIZE];
+    int nRedrawn;
+
+    bool isLod;
+    Color* map;
+    Texture2D mapTexture;
+    bool mapIsValid;
+    Grid mapGrid;
+    Rod mapped[RGRID_MAX_SIZE][RGRID_MAX_SIZE];
+};
+
+
+// ============================================================================ PRIVATE FUNC DECL
+
+static void     RCache_UnloadLayers(RCache* rCache);
+static void     RCache_RedrawAll(RCache* rCache, const RGrid* rGrid, const RodModel* rodModel);
+static void     RCache_RedrawDirty(RCache* rCache, const RGrid* rGrid, int nDirty,
+                                   const RodModel* rodModel);
+static void     RCache_UpdateMap(RCache* rCache, const RGrid* rGrid);
+static void     RCache_MapRod(RCache* rCache, GNode node, const Rod* rod);
+static void     RCache_UploadRod(RCache* rCache, GNode node);
+static Point    RCache_TilePos(const RCache* rCache, GNode node);
+static bool     RCache_RodIsEqual(const Rod* rod1, const Rod* rod2);
+static Color    RCache_LayerColor(int layer);
+static void     RCache_BeginWriteBlend(void);
+static void     RCache_BeginClearBlend(void);
+
+
+
+
+
+
+// ============================================================================ FUNC DEF
+
+// **************************************************************************** RCache_Make
+
+// Make an empty rod cache. The render textures are loaded at the first update
+RCache* RCache_Make(void){
+    return Memory_Allocate(NULL, sizeof(RCache), ZEROVAL_ALL);
+}
+
+
+// **************************************************************************** RCache_Free
+
+// Unload the render textures and free the memory of the rod cache. Return NULL
+RCache* RCache_Free(RCache* rCache){
+    if (rCache == NULL) {return NULL;}
+
+    RCache_UnloadLayers(rCache);
+
+    if (rCache->map != NULL){
+        UnloadTexture(rCache->mapTexture);
+        rCache->map = Memory_Free(rCache->map);
+    }
+
+    return Memory_Free(rCache);
+}
+
+
+// **************************************************************************** RCache_Invalidate
+
+// Redraw the whole cache at the next update
+void RCache_Invalidate(RCache* rCache){
+    rCache->isValid = false;
+    rCache->mapIsValid = false;
+}
+
+
+// **************************************************************************** RCache_Update
+
+// Bring the cache up to date with the visible part of the rod grid, with top
+// left corner at pos, inside the given area of the screen. Reload the render
+// textures if the size of the area has changed
+void RCache_Update(RCache* rCache, const RGrid* rGrid, Grid visible, Point pos, Rect area,
+                   const RodModel* rodModel){
+    int width = (int) area.width;
+    int height = (int) area.height;
+    if (width <= 0 || height <= 0) {return;}
+
+    if (width != rCache->width || height != rCache->height){
+        RCache_UnloadLayers(rCache);
+        for (int i = 0; i < RCACHE_LAYERS_N; i++){
+            rCache->layers[i] = LoadRenderTexture(width, height);
+        }
+        rCache->width = width;
+        rCache->height = height;
+        rCache->isValid = false;
+    }
+
+    rCache->areaPos = POINT(area.x, area.y);
+    pos = Geo_MovePoint(pos, -area.x, -area.y);
+    float tileSize = RGraph_GetTileSize(rodModel);
+
+    // Small tiles are drawn from the pixel map. The render textures are 
+    // redrawn when the tiles grow back
+    rCache->isLod = tileSize < RCACHE_LOD_TILE_SIZE;
+    if (rCache->isLod){
+        rCache->visible = visible;
+        rCache->pos = pos;
+        rCache->tileSize = tileSize;
+        rCache->isValid = false;
+
+        RCache_UpdateMap(rCache, rGrid);
+        return;
+    }
+
+    // A change of the view redraws everything
+    if (!rCache->isValid ||
+        !Grid_NodesAreEqual(visible.origin, rCache->visible.origin) ||
+        visible.nCols != rCache->visible.nCols || visible.nRows != rCache->visible.nRows ||
+        !FEQ(pos.x, rCache->pos.x) || !FEQ(pos.y, rCache->pos.y) || !FEQ(tileSize, rCache->tileSize)){
+        rCache->visible = visible;
+        rCache->pos = pos;
+        rCache->tileSize = tileSize;
+
+        RCache_RedrawAll(rCache, rGrid, rodModel);
+        rCache->isValid = true;
+        return;
+    }
+
+    // Find the rods that have changed since drawn
+    int nDirty = 0;
+    for (int y = visible.origin.y; y < visible.origin.y + visible.nRows; y++){
+        for (int x = visible.origin.x; x < visible.origin.x + visible.nCols; x++){
+            if (!RCache_RodIsEqual(RGrid_GetRod_Fast(rGrid, GNODE(x, y)), &rCache->drawn[y][x])){
+                rCache->dirty[nDirty] = GNODE(x, y);
+                nDirty++;
+            }
+        }
+    }
+
+    if (nDirty == 0){
+        rCache->nRedrawn = 0;
+    }else if ((float) nDirty > (float) Grid_N(visible) * RCACHE_FULL_REDRAW_RATIO){
+        RCache_RedrawAll(rCache, rGrid, rodModel);
+    }else{
+        RCache_RedrawDirty(rCache, rGrid, nDirty, rodModel);
+    }
+}
+
+
+// **************************************************************************** RCache_Draw
+
+// Blit the layers of the cache at their area, moved by shift, or draw the 
+// visible part of the pixel map. Tint the layer of the electrified rods with 
+// the magic color
+void RCache_Draw(const RCache* rCache, Vector2 shift){
+    if (rCache->isLod){
+        if (!rCache->mapIsValid) {return;}
+
+        Grid visible = rCache->visible;
+        Rect src = RECT(visible.origin.x * RCACHE_MAP_CELL, visible.origin.y * RCACHE_MAP_CELL,
+                        visible.nCols * RCACHE_MAP_CELL, visible.nRows * RCACHE_MAP_CELL);
+        Point pos = Geo_TranslatePoint(Geo_TranslatePoint(rCache->areaPos, rCache->pos), shift);
+        Rect dst = RECT(pos.x, pos.y, visible.nCols * rCache->tileSize, visible.nRows * rCache->tileSize);
+
+        BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+        DrawTexturePro(rCache->mapTexture, src, dst, POINT(0.0f, 0.0f), 0.0f, WHITE);
+        src.x += RCACHE_MAP_LAYER_WIDTH;
+        DrawTexturePro(rCache->mapTexture, src, dst, POINT(0.0f, 0.0f), 0.0f, MCol(Glo_MCol));
+        EndBlendMode();
+
+        Counter_Add(CNT_LOD_DRAWS, 1);
+        return;
+    }
+
+    if (!rCache->isValid) {return;}
+
+    Rectangle src = {0.0f, 0.0f, (float) rCache->width, (float) -rCache->height};
+    Point pos = Geo_TranslatePoint(rCache->areaPos, shift);
+
+    BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+    DrawTextureRec(rCache->layers[RCACHE_LAYER_PLAIN].texture, src, pos, WHITE);
+    DrawTextureRec(rCache->layers[RCACHE_LAYER_ELECTRIFIED].texture, src, pos, MCol(Glo_MCol));
+    EndBlendMode();
+}
+
+
+#ifdef DEBUG_MODE
+// **************************************************************************** RCache_Print
+
+    // Multiline print of the parameters of the rod cache
+    void RCache_Print(const RCache* rCache){
+        CHECK_NULL(rCache, WITH_NEW_LINE)
+
+        printf("Size:      %d x %d\n", rCache->width, rCache->height);
+        printf("Is Valid:  %s\n", Bool_ToString(rCache->isValid, LONG_FORM));
+        printf("Visible:   "); Grid_Print(rCache->visible, WITH_NEW_LINE);
+        printf("Pos:       "); Geo_PrintPoint(rCache->pos, WITH_NEW_LINE);
+        printf("Tile Size: %.3f\n", rCache->tileSize);
+        printf("Redrawn:   %d\n", rCache->nRedrawn);
+        printf("Is LOD:    %s\n", Bool_ToString(rCache->isLod, LONG_FORM));
+        printf("Map Grid:  "); Grid_Print(rCache->mapGrid, WITH_NEW_LINE);
+    }
+#endif
+
+
+
+
+
+
+// ============================================================================ PRIVATE FUNC DEF
+
+// **************************************************************************** RCache_UnloadLayers
+
+// Unload the render textures, if loaded
+static void RCache_UnloadLayers(RCache* rCache){
+    if (rCache->width == 0) {return;}
+
+    for (int i = 0; i < RCACHE_LAYERS_N; i++){
+        UnloadRenderTexture(rCache->layers[i]);
+    }
+
+    Memory_Set(rCache->layers, sizeof(rCache->layers), 0);
+    rCache->width = 0;
+    rCache->height = 0;
+    rCache->isValid = false;
+}
+
+
+// **************************************************************************** RCache_RedrawAll
+
+// Clear the layers and draw every visible rod in its layer
+static void RCache_RedrawAll(RCache* rCache, const RGrid* rGrid, const RodModel* rodModel){
+    Grid visible = rCache->visible;
+
+    for (int layer = 0; layer < RCACHE_LAYERS_N; layer++){
+        BeginTextureMode(rCache->layers[layer]);
+        ClearBackground(BLANK);
+
+        RCache_BeginWriteBlend();
+        RGraph_BeginRodMode();
+        Color color = RCache_LayerColor(layer);
+        for (int y = visible.origin.y; y < visible.origin.y + visible.nRows; y++){
+            for (int x = visible.origin.x; x < visible.origin.x + visible.nCols; x++){
+                const Rod* rod = RGrid_GetRod_Fast(rGrid, GNODE(x, y));
+                if (rod->isElectrified != (layer == RCACHE_LAYER_ELECTRIFIED)) {continue;}
+                RGraph_DrawColoredRod(rod, RCache_TilePos(rCache, GNODE(x, y)), color, rodModel);
+            }
+        }
+        RGraph_EndRodMode();
+        EndBlendMode();
+
+        EndTextureMode();
+    }
+
+    for (int y = visible.origin.y; y < visible.origin.y + visible.nRows; y++){
+        for (int x = visible.origin.x; x < visible.origin.x + visible.nCols; x++){
+            rCache->drawn[y][x] = *RGrid_GetRod_Fast(rGrid, GNODE(x, y));
+        }
+    }
+
+    rCache->nRedrawn = Grid_N(visible);
+}
+
+
+// **************************************************************************** RCache_RedrawDirty
+
+// Clear the tiles of the dirty rods in both layers and redraw every dirty rod
+// in its layer
+static void RCache_RedrawDirty(RCache* rCache, const RGrid* rGrid, int nDirty,
+                               const RodModel* rodModel){
+    for (int layer = 0; layer < RCACHE_LAYERS_N; layer++){
+        BeginTextureMode(rCache->layers[layer]);
+
+        RCache_BeginClearBlend();
+        for (int i = 0; i < nDirty; i++){
+            Point pos = RCache_TilePos(rCache, rCache->dirty[i]);
+            DrawRectangleRec(RECT(pos.x, pos.y, rCache->tileSize, rCache->tileSize), BLANK);
+        }
+        EndBlendMode();
+
+        RCache_BeginWriteBlend();
+        RGraph_BeginRodMode();
+        Color color = RCache_LayerColor(layer);
+        for (int i = 0; i < nDirty; i++){
+            const Rod* rod = RGrid_GetRod_Fast(rGrid, rCache->dirty[i]);
+            if (rod->isElectrified != (layer == RCACHE_LAYER_ELECTRIFIED)) {continue;}
+            RGraph_DrawColoredRod(rod, RCache_TilePos(rCache, rCache->dirty[i]), color, rodModel);
+        }
+        RGraph_EndRodMode();
+        EndBlendMode();
+
+        EndTextureMode();
+    }
+
+    for (int i = 0; i < nDirty; i++){
+        GNode node = rCache->dirty[i];
+        rCache->drawn[node.y][node.x] = *RGrid_GetRod_Fast(rGrid, node);
+    }
+
+    rCache->nRedrawn = nDirty;
+}
+
+
+// **************************************************************************** RCache_UpdateMap
+
+// Bring the pixel map up to date with the rod grid. Remap the whole grid if
+// its size has changed, otherwise only the rods that have changed. Upload the
+// changed pixels to the texture
+static void RCache_UpdateMap(RCache* rCache, const RGrid* rGrid){
+    if (rCache->map == NULL){
+        rCache->map = Memory_Allocate(NULL, sizeof(Color) * RCACHE_MAP_WIDTH * RCACHE_MAP_HEIGHT, 
+                                      ZEROVAL_ALL);
+        Image im = {.data = rCache->map, .width = RCACHE_MAP_WIDTH, .height = RCACHE_MAP_HEIGHT,
+                    .mipmaps = 1, .format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+        rCache->mapTexture = LoadTextureFromImage(im);
+        rCache->mapIsValid = false;
+    }
+
+    Grid grid = RGrid_GetSize(rGrid);
+    if (grid.nCols != rCache->mapGrid.nCols || grid.nRows != rCache->mapGrid.nRows){
+        rCache->mapIsValid = false;
+    }
+
+    if (!rCache->mapIsValid){
+        Memory_Set(rCache->map, sizeof(Color) * RCACHE_MAP_WIDTH * RCACHE_MAP_HEIGHT, 0);
+        for (int y = 0; y < grid.nRows; y++){
+            for (int x = 0; x < grid.nCols; x++){
+                RCache_MapRod(rCache, GNODE(x, y), RGrid_GetRod_Fast(rGrid, GNODE(x, y)));
+            }
+        }
+        UpdateTexture(rCache->mapTexture, rCache->map);
+
+        rCache->mapGrid = grid;
+        rCache->mapIsValid = true;
+        return;
+    }
+
+    // Remap the changed rods. Upload them one by one, or the whole map if 
+    // there are many
+    int nDirty = 0;
+    for (int y = 0; y < grid.nRows; y++){
+        for (int x = 0; x < grid.nCols; x++){
+            const Rod* rod = RGrid_GetRod_Fast(rGrid, GNODE(x, y));
+            const Rod* mapped = &rCache->mapped[y][x];
+            if (rod->legs == mapped->legs && rod->isElectrified == mapped->isElectrified) {continue;}
+
+            RCache_MapRod(rCache, GNODE(x, y), rod);
+            if (nDirty < RCACHE_MAP_FULL_UPLOAD_N){
+                rCache->dirty[nDirty] = GNODE(x, y);
+            }
+            nDirty++;
+        }
+    }
+
+    if (nDirty > RCACHE_MAP_FULL_UPLOAD_N){
+        UpdateTexture(rCache->mapTexture, rCache->map);
+    }else{
+        for (int i = 0; i < nDirty; i++){
+            RCache_UploadRod(rCache, rCache->dirty[i]);
+        }
+    }
+}
+
+
+// **************************************************************************** RCache_MapRod
+
+// Set the pixels of the rod in the pixel map: the center and the legs in its
+// layer and nothing in the other layer
+static void RCache_MapRod(RCache* rCache, GNode node, const Rod* rod){
+    const int LEG_PIXELS[4][2] = {{2, 1}, {1, 2}, {0, 1}, {1, 0}};
+
+    for (int layer = 0; layer < RCACHE_LAYERS_N; layer++){
+        Color* cell = rCache->map + node.y * RCACHE_MAP_CELL * RCACHE_MAP_WIDTH +
+                      layer * RCACHE_MAP_LAYER_WIDTH + node.x * RCACHE_MAP_CELL;
+
+        for (int y = 0; y < RCACHE_MAP_CELL; y++){
+            for (int x = 0; x < RCACHE_MAP_CELL; x++){
+                cell[y * RCACHE_MAP_WIDTH + x] = BLANK;
+            }
+        }
+
+        if (rod->isElectrified != (layer == RCACHE_LAYER_ELECTRIFIED)) {continue;}
+
+        Color color = RCache_LayerColor(layer);
+        cell[RCACHE_MAP_WIDTH + 1] = color;
+        for (int i = 0; i < 4; i++){
+            if (rod->legs & (1 << i)){
+                cell[LEG_PIXELS[i][1] * RCACHE_MAP_WIDTH + LEG_PIXELS[i][0]] = color;
+            }
+        }
+    }
+
+    rCache->mapped[node.y][node.x] = *rod;
+}
+
+
+// **************************************************************************** RCache_UploadRod
+
+// Upload the pixels of the rod, in both layers, to the texture of the pixel 
+// map
+static void RCache_UploadRod(RCache* rCache, GNode node){
+    Color block[RCACHE_MAP_CELL * RCACHE_MAP_CELL];
+
+    for (int layer = 0; layer < RCACHE_LAYERS_N; layer++){
+        int left = layer * RCACHE_MAP_LAYER_WIDTH + node.x * RCACHE_MAP_CELL;
+        int top = node.y * RCACHE_MAP_CELL;
+
+        for (int y = 0; y < RCACHE_MAP_CELL; y++){
+            for (int x = 0; x < RCACHE_MAP_CELL; x++){
+                block[y * RCACHE_MAP_CELL + x] = rCache->map[(top + y) * RCACHE_MAP_WIDTH + left + x];
+            }
+        }
+
+        UpdateTextureRec(rCache->mapTexture, RECT(left, top, RCACHE_MAP_CELL, RCACHE_MAP_CELL), block);
+    }
+}
+
+
+// **************************************************************************** RCache_TilePos
+
+// The top left corner of the tile of the node in the render textures
+static Point RCache_TilePos(const RCache* rCache, GNode node){
+    return Geo_MovePoint(rCache->pos, (float) (node.x - rCache->visible.origin.x) * rCache->tileSize,
+                                      (float) (node.y - rCache->visible.origin.y) * rCache->tileSize);
+}
+
+
+// **************************************************************************** RCache_RodIsEqual
+
+// Return true if the rods are drawn the same way
+static bool RCache_RodIsEqual(const Rod* rod1, const Rod* rod2){
+    return rod1->legs == rod2->legs && rod1->frame == rod2->frame &&
+           rod1->isElectrified == rod2->isElectrified;
+}
+
+
+// **************************************************************************** RCache_LayerColor
+
+// The color of the rods in the layer. The electrified rods are white, to be
+// tinted when blitted
+static Color RCache_LayerColor(int layer){
+    return (layer == RCACHE_LAYER_ELECTRIFIED) ? WHITE : COL_ROD;
+}
+
+
+// **************************************************************************** RCache_BeginWriteBlend
+
+// Blend the rods into the layers with their colors premultiplied by alpha
+static void RCache_BeginWriteBlend(void){
+    rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA,
+                              RL_FUNC_ADD, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+}
+
+
+// **************************************************************************** RCache_BeginClearBlend
+
+// Replace the pixels of anything drawn with transparent ones
+static void RCache_BeginClearBlend(void){
+    rlSetBlendFactorsSeparate(RL_ZERO, RL_ZERO, RL_ZERO, RL_ZERO, RL_FUNC_ADD, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+}
@@ -231,4 +231,24 @@ void Shape_DrawSelBoxInImage(Image* im, Color color){
 }
 
 
+// **************************************************************************** Shape_GetLegWidthRatio
 
+// The width of the rod legs and the diameter of the rod hub, as a ratio of the
+// tile size
+float Shape_GetLegWidthRatio(void){
+    return ROD_LEG_WIDTH_RATIO;
+}
+
+
+// **************************************************************************** Shape_HashImageGeometry
+
+// Continue the hash with the constants that shape the rods and the selection 
+// box in the images, so images made with different constants can be told apart
+unsigned int Shape_HashImageGeometry(unsigned int hash){
+    const float geometry[] = {
+        ROD_LEG_WIDTH_RATIO, SELBOX_CORNER_SIZE_RATIO, SELBOX_CORNER_RADIUS_RATIO, SELBOX_EDGE_RATIO,
+        SELBOX_THICKNESS_RATIO, SELBOX_MIN_THICKNESS, SELBOX_MAX_THICKNESS
+    };
+
+    return Math_Hash(hash, geometry, sizeof(geometry));
+}
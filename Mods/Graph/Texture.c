@@ -9,7 +9,37 @@
 // ============================================================================ INFO
 /*
     Functions for managing the icon, rod and selection box textures as well as 
-    drawing the rod textures.
+    drawing the rods.
+
+    The rod grid is drawn as a single batch of rotated and tinted quads, one
+    for every rod. The rod shader draws every rod from the signed distance 
+    field of its hub and legs, so the rods are sharp at every tile size and 
+    need no texture. The legs are passed in the integer part of the texture
+    coordinates and the rotation in the corners of the quad. The shader uses
+    only GLSL 330 and derivatives, so it runs on software renderers too.
+
+    If the rod shader fails, the rods are drawn from the rod atlas instead. 
+    The rod textures of all the 16 leg combinations are packed in the atlas, 
+    in a 4 x 4 layout. Every cell is padded with transparent pixels, so the 
+    filtering does not pick up the neighbouring rods.
+
+    All the textures have full mipmap chains and trilinear filtering, so they
+    are sampled from the mipmap level that matches the size they are drawn 
+    at. Before making the mipmaps of the icons, the fully transparent pixels
+    take the average color of the visible ones, so the smaller levels do not
+    darken at the edges. The atlas cells are 320 pixels, divisible by 64, so 
+    the first 6 levels never mix two cells.
+
+    The rod atlas and the selection box are drawn in a single color, so only
+    their coverage is stored, in a single channel texture. They are drawn 
+    with the coverage shader, that takes the color from the tint and the alpha
+    from the coverage.
+
+    The coverage of the rods and the selection box is drawn by worker threads,
+    every one in its own part of the data, and only uploaded on the main 
+    thread. The data is kept in the texture cache file, with a key made from 
+    the constants that shape it, so later starts only read and upload it. 
+    TEXTURE_DATA_VERSION must change when the drawing code changes.
 */
 
 
@@ -18,20 +48,106 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <raylib.h>
+#include <rlgl.h>
+
+#include <pthread.h>
 
 #include "../Assets/Assets.h"
 
 #include "../Public/Public.h"
 #include "../Fund/Fund.h"
 #include "../Logic/Logic.h"
+#include "../Store/Store.h"
 #include "Graph.h"
 
 
+// ============================================================================ PRIVATE CONSTANTS
+
+#define TEXTURE_ATLAS_COLS                  4
+#define TEXTURE_ATLAS_PADDING               10.0f
+#define TEXTURE_ATLAS_CELL_SIZE             (ROD_DEF_TEXTURE_SIZE + 2.0f * TEXTURE_ATLAS_PADDING)
+#define TEXTURE_ATLAS_SIZE                  (TEXTURE_ATLAS_COLS * TEXTURE_ATLAS_CELL_SIZE)
+
+#define TEXTURE_DATA_VERSION                1
+#define TEXTURE_THREADS_N                   4
+
+// The jobs of the workers are the 16 rods and the selection box
+#define TEXTURE_JOBS_N                      (0x10 + 1)
+#define TEXTURE_JOB_SELBOX                  0x10
+
+// The coverage data is the rod atlas followed by the selection box
+#define TEXTURE_ATLAS_DATA_SIZE             ((int) (TEXTURE_ATLAS_SIZE * TEXTURE_ATLAS_SIZE))
+#define TEXTURE_SELBOX_DATA_SIZE            ((int) (ROD_DEF_TEXTURE_SIZE * ROD_DEF_TEXTURE_SIZE))
+#define TEXTURE_DATA_SIZE                   (TEXTURE_ATLAS_DATA_SIZE + TEXTURE_SELBOX_DATA_SIZE)
+
+
+// ============================================================================ PRIVATE VARIABLES
+
+// Fragment shader of the single channel textures. The color is the tint and 
+// the alpha is the coverage, from the texture
+static const char* textureCoverageFS =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "out vec4 finalColor;\n"
+    "void main(){\n"
+    "    float coverage = texture(texture0, fragTexCoord).r;\n"
+    "    finalColor = vec4(fragColor.rgb, fragColor.a * coverage) * colDiffuse;\n"
+    "}\n";
+
+// Fragment shader of the rod mode. The integer part of the texture coordinate
+// u is the legs of the rod and the fractional parts run from 0.25 to 0.75 
+// across the rod. The coverage is the signed distance to the hub and the legs,
+// in pixels. The legs go past the edge of the tile, so the neighbouring legs
+// meet without a seam
+static const char* textureRodFS =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "uniform vec4 colDiffuse;\n"
+    "uniform float legWidth;\n"
+    "out vec4 finalColor;\n"
+    "float boxDist(vec2 p, vec2 center, vec2 halfSize){\n"
+    "    vec2 d = abs(p - center) - halfSize;\n"
+    "    return length(max(d, 0.0)) + min(max(d.x, d.y), 0.0);\n"
+    "}\n"
+    "void main(){\n"
+    "    vec2 cell = floor(fragTexCoord);\n"
+    "    vec2 p = (fragTexCoord - cell) * 2.0 - 1.0;\n"
+    "    int legs = int(cell.x);\n"
+    "    float r = legWidth * 0.5;\n"
+    "    float d = length(p) - r;\n"
+    "    if ((legs & 1) != 0) d = min(d, boxDist(p, vec2( 0.5,  0.0), vec2(0.5, r)));\n"
+    "    if ((legs & 2) != 0) d = min(d, boxDist(p, vec2( 0.0,  0.5), vec2(r, 0.5)));\n"
+    "    if ((legs & 4) != 0) d = min(d, boxDist(p, vec2(-0.5,  0.0), vec2(0.5, r)));\n"
+    "    if ((legs & 8) != 0) d = min(d, boxDist(p, vec2( 0.0, -0.5), vec2(r, 0.5)));\n"
+    "    float coverage = clamp(0.5 - d / max(fwidth(d), 0.00001), 0.0, 1.0);\n"
+    "    finalColor = vec4(fragColor.rgb, fragColor.a * coverage) * colDiffuse;\n"
+    "}\n";
+
+
+// ============================================================================ PRIVATE STRUCTURES
+
+// **************************************************************************** TextureWorker
+
+// A worker thread that draws the coverage of every TEXTURE_THREADS_N-th job,
+// starting from first
+typedef struct TextureWorker{
+    pthread_t thread;
+    int first;
+    unsigned char* data;
+}TextureWorker;
+
+
 // ============================================================================ OPAQUE STRUCTURES
 
 // **************************************************************************** RodModel
 
-// Structure that contains precalculated values for drawing the rod textures
+// Structure that contains precalculated values for drawing the rod textures.
+// The corners of every frame are the top left, bottom left, bottom right and 
+// top right corner of the rotated rod, relative to the center of the tile
 struct RodModel{
     float tileSize;
     float scaleF;
@@ -40,6 +156,8 @@ struct RodModel{
         float angle;
         Vector2 unitShift;
         Vector2 shift;
+        Vector2 unitCorners[4];
+        Vector2 corners[4];
     }frames[ROD_ROT_FRAMES_N];
 };
 
@@ -47,8 +165,19 @@ struct RodModel{
 // ============================================================================ PRIVATE FUNC DECL
 
 static Texture2D Texture_LoadIcon(E_IconID id);
-static Texture2D Texture_LoadRod(int legs);
-static Texture2D Texture_LoadSelBox(void);
+static bool     Texture_LoadData(unsigned char* data, bool withCache);
+static Texture2D Texture_LoadRodAtlas(unsigned char* data);
+static unsigned int Texture_MakeDataKey(void);
+static void     Texture_DrawCoverage(unsigned char* data);
+static void*    Texture_DrawWork(void* arg);
+static Texture2D Texture_LoadCoverage(unsigned char* coverage, int width, int height);
+static Texture2D Texture_LoadMipmapped(Image* im);
+static void     Texture_BleedAlpha(Image* im);
+#ifdef DEBUG_MODE
+    static int  Texture_CalcMemory(Texture2D texture, bool withMipmaps);
+#endif
+static unsigned int RGraph_GetRodTextureID(void);
+static void     RGraph_AddRodQuad(const Rod* rod, Point center, Color color, const RodModel* rodModel);
 
 
 
@@ -61,21 +190,52 @@ static Texture2D Texture_LoadSelBox(void);
 
 // **************************************************************************** Texture_LoadAll
 
-// Load all the icon textures and make the rod and selection box textures. 
-// Store them in the global Glo_Textures
-void Texture_LoadAll(void){
+// Load all the icon textures, the selection box texture and the shaders. If 
+// the rod shader fails, make the rod atlas. The coverage data comes from the 
+// texture cache file if it is valid and the cache is used. Store them in the 
+// global Glo_Textures
+void Texture_LoadAll(bool withCache){
+    double startTime = GetTime();
+    TRACE_BEGIN("Texture_LoadAll", TRACE_NO_ARG)
+
     // Load the icons
     for (int iconID = 0; iconID < ICONS_N; iconID++){
         Glo_Textures.icons[iconID] = Texture_LoadIcon(iconID);
     }
 
-    // Make the rod textures
-    for (int legs = 0x0; legs <= 0xF; legs++){
-        Glo_Textures.rods[legs] = Texture_LoadRod(legs);
+    // Load the shaders
+    Glo_Textures.coverageShader = LoadShaderFromMemory(NULL, textureCoverageFS);
+    Glo_Textures.rodShader = LoadShaderFromMemory(NULL, textureRodFS);
+
+    bool withAtlas = (Glo_Textures.rodShader.id == rlGetShaderIdDefault());
+    if (!withAtlas){
+        float legWidth = Shape_GetLegWidthRatio();
+        SetShaderValue(Glo_Textures.rodShader, GetShaderLocation(Glo_Textures.rodShader, "legWidth"), 
+                       &legWidth, SHADER_UNIFORM_FLOAT);
+    }
+
+    // Read or draw the coverage of the rod atlas and the selection box
+    unsigned char* data = Memory_Allocate(NULL, TEXTURE_DATA_SIZE, ZEROVAL_NONE);
+    bool isCached = Texture_LoadData(data, withCache);
+
+    // Make the rod atlas, only if the rods cannot be drawn by the rod shader
+    if (withAtlas){
+        Glo_Textures.rodAtlas = Texture_LoadRodAtlas(data);
     }
 
     // Make the selection box texture
-    Glo_Textures.selBox = Texture_LoadSelBox();
+    Glo_Textures.selBox = Texture_LoadCoverage(data + TEXTURE_ATLAS_DATA_SIZE, ROD_DEF_TEXTURE_SIZE, 
+                                               ROD_DEF_TEXTURE_SIZE);
+    Err_Assert(FEQ(Glo_Textures.selBox.width, ROD_DEF_TEXTURE_SIZE) && 
+               FEQ(Glo_Textures.selBox.height, ROD_DEF_TEXTURE_SIZE), "Failed to load selection box texture");
+
+    data = Memory_Free(data);
+
+    TraceLog(LOG_INFO, "TEXTURE: Loaded all textures in %.1f ms (coverage %s, rods drawn with the %s)", 
+             (GetTime() - startTime) * 1000.0, isCached ? "from cache" : "drawn", 
+             withAtlas ? "rod atlas" : "rod shader");
+
+    TRACE_END
 }
 
 
@@ -88,14 +248,18 @@ void Texture_UnloadAll(void){
         UnloadTexture(Glo_Textures.icons[iconID]);
     }
 
-    // Unload the rod textures
-    for (int legs = 0x0; legs <= 0xF; legs++){
-        UnloadTexture(Glo_Textures.rods[legs]);
+    // Unload the rod atlas, if it was made
+    if (Glo_Textures.rodAtlas.id != 0){
+        UnloadTexture(Glo_Textures.rodAtlas);
     }
 
     // Unload the selection box texture
     UnloadTexture(Glo_Textures.selBox);
 
+    // Unload the shaders
+    UnloadShader(Glo_Textures.rodShader);
+    UnloadShader(Glo_Textures.coverageShader);
+
     Memory_Set(&Glo_Textures, sizeof(Textures), 0);
 }
 
@@ -103,23 +267,36 @@ void Texture_UnloadAll(void){
 #ifdef DEBUG_MODE
 // **************************************************************************** Texture_PrintAll
 
-    // Multiline print of the parameters of the Textures structure
+    // Multiline print of the parameters of the Textures structure and the 
+    // texture memory, with and without the mipmaps
     void Texture_PrintAll(void){
+        int total = 0, totalBase = 0;
+
         printf("Icon Textures (%d):\n", ICONS_N);
         for (int iconID = 0; iconID < ICONS_N; iconID++){
+            Texture2D icon = Glo_Textures.icons[iconID];
             printf("   %s: ", IconID_ToString(iconID));
-            printf("%d x %d\n", Glo_Textures.icons[iconID].width, Glo_Textures.icons[iconID].height);
+            printf("%d x %d, %d mipmaps\n", icon.width, icon.height, icon.mipmaps);
+            total += Texture_CalcMemory(icon, true);
+            totalBase += Texture_CalcMemory(icon, false);
         }
         printf("\n");
 
-        printf("Rod Textures:\n");
-        for (int legs = 0x0; legs <= 0xF; legs++){
-            printf("   %2d) ", legs);
-            printf("%d x %d\n", Glo_Textures.rods[legs].width, Glo_Textures.rods[legs].height);
+        Texture2D atlas = Glo_Textures.rodAtlas;
+        if (atlas.id != 0){
+            printf("Rod Atlas Texture: %d x %d, %d mipmaps\n", atlas.width, atlas.height, atlas.mipmaps);
+            total += Texture_CalcMemory(atlas, true);
+            totalBase += Texture_CalcMemory(atlas, false);
+        }else{
+            printf("Rod Atlas Texture: Not loaded, the rods are drawn by the rod shader\n");
         }
-        printf("\n");
 
-        printf("Selection Box Texture: %d x %d\n", Glo_Textures.selBox.width, Glo_Textures.selBox.height);
+        Texture2D selBox = Glo_Textures.selBox;
+        printf("Selection Box Texture: %d x %d, %d mipmaps\n", selBox.width, selBox.height, selBox.mipmaps);
+        total += Texture_CalcMemory(selBox, true);
+        totalBase += Texture_CalcMemory(selBox, false);
+
+        printf("\nTexture Memory: %d KB (%d KB without mipmaps)\n", total / 1024, totalBase / 1024);
     }
 #endif
 
@@ -148,6 +325,15 @@ RodModel* RGraph_MakeRodModel(float tileSize){
         rodModel->frames[i].unitShift.x =  a * Math_Cos(b);
         rodModel->frames[i].unitShift.y = -a * Math_Sin(b);
 
+        // The corners of the unit tile, rotated around its center
+        const Vector2 unrotated[4] = {{-0.5f, -0.5f}, {-0.5f, 0.5f}, {0.5f, 0.5f}, {0.5f, -0.5f}};
+        float cosR = Math_Cos(radians);
+        float sinR = Math_Sin(radians);
+        for (int k = 0; k < 4; k++){
+            rodModel->frames[i].unitCorners[k].x = unrotated[k].x * cosR - unrotated[k].y * sinR;
+            rodModel->frames[i].unitCorners[k].y = unrotated[k].x * sinR + unrotated[k].y * cosR;
+        }
+
         radians -= RAD_INCR;
     }
 
@@ -174,6 +360,9 @@ void RGraph_ResizeRodModel(RodModel* rodModel, float tileSize){
 
     for (int i = 0; i < ROD_ROT_FRAMES_N; i++){
         rodModel->frames[i].shift = Geo_ScalePoint(rodModel->frames[i].unitShift, tileSize);
+        for (int k = 0; k < 4; k++){
+            rodModel->frames[i].corners[k] = Geo_ScalePoint(rodModel->frames[i].unitCorners[k], tileSize);
+        }
     }
 }
 
@@ -212,36 +401,79 @@ Vector2 RGraph_GetShift(const RodModel* rodModel, int frame){
 }
 
 
-// **************************************************************************** RGraph_ResizeRodModel
+// **************************************************************************** RGraph_DrawRod
 
-// Draw the rod using the appropriate texture in Glo_Textures and the 
-// precalculated values in rodModel
+// Draw the rod in rod mode, using the precalculated values in rodModel
 void RGraph_DrawRod(const Rod* rod, Point pos, const RodModel* rodModel){
-    DrawTextureEx(Glo_Textures.rods[rod->legs],                                 // Texture
-                  Geo_TranslatePoint(pos, rodModel->frames[rod->frame].shift),  // Position
-                  rodModel->frames[rod->frame].angle,                           // Rotation
-                  rodModel->scaleF,                                             // Scale
-                  rod->isElectrified ? MCol(Glo_MCol) : COL_ROD);               // Color
+    RGraph_BeginRodMode();
+    RGraph_DrawColoredRod(rod, pos, rod->isElectrified ? MCol(Glo_MCol) : COL_ROD, rodModel);
+    RGraph_EndRodMode();
+}
+
+
+// **************************************************************************** RGraph_DrawColoredRod
+
+// Draw the rod in the given color. Called in rod mode. Consecutive rods are 
+// added to the same render batch
+void RGraph_DrawColoredRod(const Rod* rod, Point pos, Color color, const RodModel* rodModel){
+    float half = rodModel->tileSize * 0.5f;
+
+    rlCheckRenderBatchLimit(4);
+    rlSetTexture(RGraph_GetRodTextureID());
+    rlBegin(RL_QUADS);
+    RGraph_AddRodQuad(rod, Geo_MovePoint(pos, half, half), color, rodModel);
+    rlEnd();
+    rlSetTexture(0);
 }
 
 
 // **************************************************************************** RGraph_DrawGrid
 
-// Draw the visible part of the rod grid, with top left corner at pos
+// Draw the visible part of the rod grid, with top left corner at pos. All the 
+// rods are added to the render batch as quads of the same texture, so they 
+// are drawn together, without texture changes
 void RGraph_DrawRGrid(const RGrid* rGrid, Grid visible, Point pos, const RodModel* rodModel){
-    Point cursor = pos;
+    const Color elecColor = MCol(Glo_MCol);
+    float half = rodModel->tileSize * 0.5f;
+
+    RGraph_BeginRodMode();
+
+    Point center = Geo_MovePoint(pos, half, half);
     for (int y = visible.origin.y; y < visible.origin.y + visible.nRows; y++){
+        // A full batch is drawn and reset, along with its texture, between 
+        // the rows
+        rlCheckRenderBatchLimit(4 * visible.nCols);
+        rlSetTexture(RGraph_GetRodTextureID());
+        rlBegin(RL_QUADS);
+
         for (int x = visible.origin.x; x < visible.origin.x + visible.nCols; x++){
-            Rod* rod = RGrid_GetRod(rGrid, GNODE(x, y));
-            RGraph_DrawRod(rod, cursor, rodModel);
+            const Rod* rod = RGrid_GetRod_Fast(rGrid, GNODE(x, y));
+            RGraph_AddRodQuad(rod, center, rod->isElectrified ? elecColor : COL_ROD, rodModel);
             
-            cursor.x += rodModel->tileSize;
+            center.x += rodModel->tileSize;
         }
 
-        cursor.x = pos.x;
-        cursor.y += rodModel->tileSize;
+        rlEnd();
+
+        center.x = pos.x + half;
+        center.y += rodModel->tileSize;
     }
+    rlSetTexture(0);
+
+    RGraph_EndRodMode();
+
+    Counter_Add(CNT_ROD_BATCHES, visible.nRows);
+    Counter_Add(CNT_ROD_QUADS, visible.nRows * visible.nCols);
 
+    RGraph_DrawSource(rGrid, visible, pos, rodModel);
+}
+
+
+// **************************************************************************** RGraph_DrawSource
+
+// Draw the source, if it is in the visible part of the rod grid, with top 
+// left corner at pos
+void RGraph_DrawSource(const RGrid* rGrid, Grid visible, Point pos, const RodModel* rodModel){
     GNode source = RGrid_GetSource(rGrid);
     if (Grid_NodeIsInGrid(source, visible)){
         Point sourcePos = Geo_MovePoint(pos, (float) (source.x - visible.origin.x) * rodModel->tileSize, 
@@ -255,7 +487,26 @@ void RGraph_DrawRGrid(const RGrid* rGrid, Grid visible, Point pos, const RodMode
 
 // Draw the selection box at the given position
 void RGraph_DrawSelBox(Point pos, const RodModel* rodModel){
+    BeginShaderMode(Glo_Textures.coverageShader);
     DrawTextureEx(Glo_Textures.selBox, pos, 0.0f, rodModel->scaleF, COL_SELBOX);
+    EndShaderMode();
+}
+
+
+// **************************************************************************** RGraph_BeginRodMode
+
+// Begin drawing the rods, tinted with their color, with the rod shader or 
+// from the rod atlas
+void RGraph_BeginRodMode(void){
+    BeginShaderMode((Glo_Textures.rodAtlas.id != 0) ? Glo_Textures.coverageShader : Glo_Textures.rodShader);
+}
+
+
+// **************************************************************************** RGraph_EndRodMode
+
+// End drawing the rod textures
+void RGraph_EndRodMode(void){
+    EndShaderMode();
 }
 
 
@@ -279,6 +530,65 @@ void RGraph_DrawSelBox(Point pos, const RodModel* rodModel){
 #endif
 
 
+#ifdef DEBUG_MODE
+// **************************************************************************** RGraph_CompareRodRenderers
+
+    // Print the time per frame of drawing the rod grid with the rod shader 
+    // and with the rod atlas, at several tile sizes. The frames are drawn in
+    // a render texture, that is read back at the end, to wait for the GPU
+    void RGraph_CompareRodRenderers(const RGrid* rGrid){
+        const float tileSizes[] = {4.0f, 8.0f, 16.0f, 32.0f, 64.0f, 128.0f};
+        const int TILE_SIZES_N = sizeof(tileSizes) / sizeof(tileSizes[0]);
+        const int FRAMES_N = 100;
+        const int TARGET_SIZE = 1024;
+
+        if (Glo_Textures.rodAtlas.id != 0){
+            printf("The rod shader is not available\n");
+            return;
+        }
+
+        unsigned char* data = Memory_Allocate(NULL, TEXTURE_DATA_SIZE, ZEROVAL_NONE);
+        Texture_LoadData(data, WITH_CACHE);
+        Texture2D atlas = Texture_LoadRodAtlas(data);
+        data = Memory_Free(data);
+
+        RenderTexture2D target = LoadRenderTexture(TARGET_SIZE, TARGET_SIZE);
+        Grid size = RGrid_GetSize(rGrid);
+
+        printf("Tile Size | Rods  | Shader (ms) | Atlas (ms)\n");
+        for (int i = 0; i < TILE_SIZES_N; i++){
+            RodModel* rodModel = RGraph_MakeRodModel(tileSizes[i]);
+            int n = (int) ((float) TARGET_SIZE / tileSizes[i]);
+            Grid visible = GRID0(MIN(n, size.nCols), MIN(n, size.nRows));
+
+            double ms[2];
+            for (int k = 0; k < 2; k++){
+                Glo_Textures.rodAtlas = (k == 0) ? (Texture2D) {0} : atlas;
+
+                double startTime = GetTime();
+                BeginTextureMode(target);
+                for (int frame = 0; frame < FRAMES_N; frame++){
+                    ClearBackground(COL_NULL);
+                    RGraph_DrawRGrid(rGrid, visible, POINT_NULL, rodModel);
+                }
+                EndTextureMode();
+
+                Image im = LoadImageFromTexture(target.texture);
+                UnloadImage(im);
+                ms[k] = (GetTime() - startTime) * 1000.0 / FRAMES_N;
+            }
+
+            printf("%9.0f | %5d | %11.3f | %10.3f\n", tileSizes[i], Grid_N(visible), ms[0], ms[1]);
+            rodModel = RGraph_FreeRodModel(rodModel);
+        }
+
+        Glo_Textures.rodAtlas = (Texture2D) {0};
+        UnloadRenderTexture(target);
+        UnloadTexture(atlas);
+    }
+#endif
+
+
 #ifdef DEBUG_MODE
 // **************************************************************************** AppIcon_Create
 
@@ -328,7 +638,8 @@ static Texture2D Texture_LoadIcon(E_IconID id){
     Err_Assert(FEQ(im.width, ICON_DEF_TEXTURE_SIZE) && FEQ(im.height, ICON_DEF_TEXTURE_SIZE), 
                "Failed to load icon from memory");
 
-    Texture2D res = LoadTextureFromImage(im);
+    Texture_BleedAlpha(&im);
+    Texture2D res = Texture_LoadMipmapped(&im);
     Err_Assert(FEQ(res.width, ICON_DEF_TEXTURE_SIZE) && FEQ(res.height, ICON_DEF_TEXTURE_SIZE), 
                "Failed to load icon as texture");
 
@@ -338,43 +649,255 @@ static Texture2D Texture_LoadIcon(E_IconID id){
 }
 
 
-// **************************************************************************** Texture_LoadRod
+// **************************************************************************** Texture_LoadData
 
-// Make a rod texture
-static Texture2D Texture_LoadRod(int legs){
-    legs = PUT_IN_RANGE(legs, 0x0, 0xF);
+// Read the coverage data of the rod atlas and the selection box from the 
+// texture cache file. If it is not valid, draw the data and write it to the 
+// file. Without the cache, only draw it. Return true if the data was read 
+// from the file
+static bool Texture_LoadData(unsigned char* data, bool withCache){
+    if (!withCache){
+        TRACE_BEGIN("Texture_DrawCoverage", TRACE_NO_ARG)
+        Texture_DrawCoverage(data);
+        TRACE_END
+        return false;
+    }
 
-    Image im = GenImageColor(ROD_DEF_TEXTURE_SIZE, ROD_DEF_TEXTURE_SIZE, COL_NULL);
-    Err_Assert(FEQ(im.width, ROD_DEF_TEXTURE_SIZE) && FEQ(im.height, ROD_DEF_TEXTURE_SIZE), 
-               "Failed to create rod image");
+    unsigned int key = Texture_MakeDataKey();
+    char* path = Path_GetTextureFile();
 
-    Shape_DrawRodInImage(&im, legs, WHITE);
+    TRACE_BEGIN("TData_ReadFromFile", TRACE_NO_ARG)
+    bool isCached = TData_ReadFromFile(path, key, data, TEXTURE_DATA_SIZE);
+    TRACE_END
 
-    Texture2D res = LoadTextureFromImage(im);
-    Err_Assert(FEQ(res.width, ROD_DEF_TEXTURE_SIZE) && FEQ(res.height, ROD_DEF_TEXTURE_SIZE), 
-               "Failed to load rod texture");
+    if (!isCached){
+        TRACE_BEGIN("Texture_DrawCoverage", TRACE_NO_ARG)
+        Texture_DrawCoverage(data);
+        TRACE_END
 
-    UnloadImage(im);
+        // A failed write only means that the next start draws the data again
+        TData_WriteToFile(path, key, data, TEXTURE_DATA_SIZE);
+    }
+
+    path = Memory_Free(path);
+
+    return isCached;
+}
+
+
+// **************************************************************************** Texture_LoadRodAtlas
+
+// Make the rod atlas from the coverage data
+static Texture2D Texture_LoadRodAtlas(unsigned char* data){
+    Texture2D res = Texture_LoadCoverage(data, TEXTURE_ATLAS_SIZE, TEXTURE_ATLAS_SIZE);
+    Err_Assert(FEQ(res.width, TEXTURE_ATLAS_SIZE) && FEQ(res.height, TEXTURE_ATLAS_SIZE), 
+               "Failed to load rod atlas texture");
 
     return res;
 }
 
 
-// **************************************************************************** Texture_LoadSelBox
+// **************************************************************************** Texture_MakeDataKey
 
-// Make a selection box texture
-static Texture2D Texture_LoadSelBox(void){
-    Image im = GenImageColor(ROD_DEF_TEXTURE_SIZE, ROD_DEF_TEXTURE_SIZE, COL_NULL);
-    Err_Assert(FEQ(im.width, ROD_DEF_TEXTURE_SIZE) && FEQ(im.height, ROD_DEF_TEXTURE_SIZE), 
-               "Failed to create selection box image");
+// The key of the coverage data in the texture cache file, from the version 
+// of the data, the layout of the atlas and the geometry of the shapes
+static unsigned int Texture_MakeDataKey(void){
+    const float layout[] = {
+        TEXTURE_DATA_VERSION, ROD_DEF_TEXTURE_SIZE, TEXTURE_ATLAS_COLS, TEXTURE_ATLAS_PADDING
+    };
+
+    unsigned int key = Math_Hash(0, layout, sizeof(layout));
+
+    return Shape_HashImageGeometry(key);
+}
+
+
+// **************************************************************************** Texture_DrawCoverage
+
+// Draw the coverage of the rod atlas and the selection box in the data, on 
+// TEXTURE_THREADS_N worker threads. The rod with the given legs is at the 
+// cell (legs % TEXTURE_ATLAS_COLS, legs / TEXTURE_ATLAS_COLS) of the atlas
+static void Texture_DrawCoverage(unsigned char* data){
+    // The padding of the atlas cells stays transparent
+    Memory_Set(data, TEXTURE_DATA_SIZE, 0);
+
+    TextureWorker workers[TEXTURE_THREADS_N];
+    bool isRunning[TEXTURE_THREADS_N];
+
+    for (int i = 0; i < TEXTURE_THREADS_N; i++){
+        workers[i] = (TextureWorker) {.first = i, .data = data};
+        isRunning[i] = (pthread_create(&workers[i].thread, NULL, Texture_DrawWork, &workers[i]) == 0);
+
+        // Draw on this thread, if the worker cannot start
+        if (!isRunning[i]){
+            Texture_DrawWork(&workers[i]);
+        }
+    }
+
+    for (int i = 0; i < TEXTURE_THREADS_N; i++){
+        if (isRunning[i]){
+            pthread_join(workers[i].thread, NULL);
+        }
+    }
+}
+
+
+// **************************************************************************** Texture_DrawWork
+
+// The worker thread. Draw its share of the jobs and copy the alpha to its own
+// part of the data. It does not touch the GPU or the tracked memory
+static void* Texture_DrawWork(void* arg){
+    TextureWorker* worker = arg;
+    TRACE_BEGIN("Texture_DrawWork", worker->first)
 
-    Shape_DrawSelBoxInImage(&im, WHITE);
+    Image im = GenImageColor(ROD_DEF_TEXTURE_SIZE, ROD_DEF_TEXTURE_SIZE, COL_NULL);
+    const Color* pixels = im.data;
+
+    for (int job = worker->first; job < TEXTURE_JOBS_N; job += TEXTURE_THREADS_N){
+        ImageClearBackground(&im, COL_NULL);
+
+        unsigned char* dst;
+        int stride;
+        if (job == TEXTURE_JOB_SELBOX){
+            Shape_DrawSelBoxInImage(&im, WHITE);
+            dst = worker->data + TEXTURE_ATLAS_DATA_SIZE;
+            stride = im.width;
+        }else{
+            Shape_DrawRodInImage(&im, job, WHITE);
+            int x = (int) ((float) (job % TEXTURE_ATLAS_COLS) * TEXTURE_ATLAS_CELL_SIZE + TEXTURE_ATLAS_PADDING);
+            int y = (int) ((float) (job / TEXTURE_ATLAS_COLS) * TEXTURE_ATLAS_CELL_SIZE + TEXTURE_ATLAS_PADDING);
+            stride = (int) TEXTURE_ATLAS_SIZE;
+            dst = worker->data + y * stride + x;
+        }
 
-    Texture2D res = LoadTextureFromImage(im);
-    Err_Assert(FEQ(res.width, ROD_DEF_TEXTURE_SIZE) && FEQ(res.height, ROD_DEF_TEXTURE_SIZE), 
-               "Failed to load selection box texture");
+        for (int y = 0; y < im.height; y++){
+            for (int x = 0; x < im.width; x++){
+                dst[y * stride + x] = pixels[y * im.width + x].a;
+            }
+        }
+    }
 
     UnloadImage(im);
 
+    TRACE_END
+    return NULL;
+}
+
+
+// **************************************************************************** Texture_LoadCoverage
+
+// Load the coverage as a single channel texture, with a full mipmap chain
+static Texture2D Texture_LoadCoverage(unsigned char* coverage, int width, int height){
+    Image gray = {.data = coverage, .width = width, .height = height, .mipmaps = 1,
+                  .format = PIXELFORMAT_UNCOMPRESSED_GRAYSCALE};
+
+    return Texture_LoadMipmapped(&gray);
+}
+
+
+// **************************************************************************** Texture_LoadMipmapped
+
+// Load the image as a texture with a full mipmap chain and trilinear 
+// filtering
+static Texture2D Texture_LoadMipmapped(Image* im){
+    Texture2D res = LoadTextureFromImage(*im);
+    GenTextureMipmaps(&res);
+    SetTextureFilter(res, TEXTURE_FILTER_TRILINEAR);
+
     return res;
 }
+
+
+// **************************************************************************** Texture_BleedAlpha
+
+// Set the color of the fully transparent pixels to the average color of the 
+// visible ones, weighted by their alpha. The alpha is kept
+static void Texture_BleedAlpha(Image* im){
+    ImageFormat(im, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+    Color* pixels = im->data;
+    int n = im->width * im->height;
+
+    long long sumR = 0, sumG = 0, sumB = 0, sumA = 0;
+    for (int i = 0; i < n; i++){
+        sumR += pixels[i].r * pixels[i].a;
+        sumG += pixels[i].g * pixels[i].a;
+        sumB += pixels[i].b * pixels[i].a;
+        sumA += pixels[i].a;
+    }
+    if (sumA == 0) {return;}
+
+    Color avg = COLOR((unsigned char) (sumR / sumA), (unsigned char) (sumG / sumA), 
+                      (unsigned char) (sumB / sumA), 0);
+    for (int i = 0; i < n; i++){
+        if (pixels[i].a == 0) {pixels[i] = avg;}
+    }
+}
+
+
+#ifdef DEBUG_MODE
+// **************************************************************************** Texture_CalcMemory
+
+    // The memory of the texture in bytes, with or without its mipmaps
+    static int Texture_CalcMemory(Texture2D texture, bool withMipmaps){
+        int nLevels = withMipmaps ? MAX(1, texture.mipmaps) : 1;
+        int res = 0;
+
+        for (int i = 0; i < nLevels; i++){
+            res += GetPixelDataSize(MAX(1, texture.width >> i), MAX(1, texture.height >> i), 
+                                    texture.format);
+        }
+
+        return res;
+    }
+#endif
+
+
+// **************************************************************************** RGraph_GetRodTextureID
+
+// The texture of the rod quads, the rod atlas if it is loaded, or else the
+// default texture, that the rod shader does not sample
+static unsigned int RGraph_GetRodTextureID(void){
+    return (Glo_Textures.rodAtlas.id != 0) ? Glo_Textures.rodAtlas.id : rlGetTextureIdDefault();
+}
+
+
+// **************************************************************************** RGraph_AddRodQuad
+
+// Add the rotated quad of the rod, around the given center, to the render 
+// batch. Called between rlBegin(RL_QUADS) and rlEnd, in rod mode, with the 
+// texture of RGraph_GetRodTextureID set
+static void RGraph_AddRodQuad(const Rod* rod, Point center, Color color, const RodModel* rodModel){
+    const float CELL_UV = TEXTURE_ATLAS_CELL_SIZE / TEXTURE_ATLAS_SIZE;
+    const float PADDING_UV = TEXTURE_ATLAS_PADDING / TEXTURE_ATLAS_SIZE;
+    const float ROD_UV = ROD_DEF_TEXTURE_SIZE / TEXTURE_ATLAS_SIZE;
+
+    float u0, v0, u1, v1;
+    if (Glo_Textures.rodAtlas.id != 0){
+        u0 = (float) (rod->legs % TEXTURE_ATLAS_COLS) * CELL_UV + PADDING_UV;
+        v0 = (float) (rod->legs / TEXTURE_ATLAS_COLS) * CELL_UV + PADDING_UV;
+        u1 = u0 + ROD_UV;
+        v1 = v0 + ROD_UV;
+    }else{
+        // The legs for the rod shader, away from the wrap of the fractional 
+        // part
+        u0 = (float) rod->legs + 0.25f;
+        v0 = 0.25f;
+        u1 = u0 + 0.5f;
+        v1 = 0.75f;
+    }
+
+    const Vector2* corners = rodModel->frames[rod->frame].corners;
+
+    rlColor4ub(color.r, color.g, color.b, color.a);
+    rlNormal3f(0.0f, 0.0f, 1.0f);
+
+    rlTexCoord2f(u0, v0);
+    rlVertex2f(center.x + corners[0].x, center.y + corners[0].y);
+    rlTexCoord2f(u0, v1);
+    rlVertex2f(center.x + corners[1].x, center.y + corners[1].y);
+    rlTexCoord2f(u1, v1);
+    rlVertex2f(center.x + corners[2].x, center.y + corners[2].y);
+    rlTexCoord2f(u1, v0);
+    rlVertex2f(center.x + corners[3].x, center.y + corners[3].y);
+}
@@ -9,6 +9,12 @@
 // ============================================================================ INFO
 /*
     Functions for calculating and drawing the Timer Display.
+
+    The characters of the last drawn time are kept as a glyph run, the glyph 
+    quads of the characters, which is drawn as a single batch. When the time 
+    changes, only the quads of the characters that changed are made again, so
+    usually only the last digit every second. A change of the form or a resize
+    makes all of them again.
 */
 
 
@@ -44,6 +50,9 @@
                                                        TD_WIDEST_CHAR, TD_WIDEST_CHAR, TIME_SEP_CHAR, \
                                                        TD_WIDEST_CHAR, TD_WIDEST_CHAR, '\0'})
 
+// The characters of the long form, HH:MM:SS
+#define TD_RUN_MAX_N                        8
+
 
 // ============================================================================ OPAQUE STRUCTURES
 
@@ -62,9 +71,23 @@ struct TimDisp{
         float charShift[10];
         float invalidShift;
     }forms[2];
+
+    struct{
+        bool form;
+        int n;
+        char chars[TD_RUN_MAX_N];
+        GlyphQuad quads[TD_RUN_MAX_N];
+    }run;
 };
 
 
+// ============================================================================ PRIVATE FUNC DECL
+
+static void     TimDisp_UpdateRun(TimDisp* td, Time t);
+static void     TimDisp_SetRunChar(TimDisp* td, int i, char c, Point pos);
+static void     TimDisp_ClearRun(TimDisp* td);
+
+
 
 
 
@@ -125,6 +148,8 @@ void TimDisp_Resize(TimDisp* td, Size cSize){
         float w = Font_CalcTextSize(TIME_INVALID_CHAR_STR, TD(form).fontSize).width;
         TD(form).invalidShift = (TD(form).charW - w) * 0.5f;
     }
+
+    TimDisp_ClearRun(td);
 }
 
 
@@ -140,36 +165,10 @@ void TimDisp_SetAlignment(TimDisp* td, E_RectPointType alignment){
 
 // **************************************************************************** TimDisp_DrawTime
 
-// Drawv the time in the form [HH:]MM:SS
+// Draw the time in the form [HH:]MM:SS, as a single batch of glyph quads
 void TimDisp_DrawTime(Time t, Point pos, TimDisp* td, Color color){
-    bool isValid = Time_IsValid(t);
-
-    bool form = (isValid && t.hours > 0) ? LONG_FORM : SHORT_FORM;
-
-    char tempStr[2] = {0};
-    Point cursor = Geo_TranslatePoint(pos, TD(form).origin);
-    for (int unit = HOURS; unit <= SECONDS; unit++){
-        if (unit == HOURS && form == SHORT_FORM){
-            continue;
-        }
-
-        int digit = t.values[unit] / 10;
-        tempStr[0] = isValid ? digit + '0' : TIME_INVALID_CHAR;
-        float shift = isValid ? TD(form).charShift[digit] : TD(form).invalidShift;
-        Font_DrawText(tempStr, TD(form).fontSize, Geo_MovePoint(cursor, shift, 0.0f), color);
-        cursor.x += TD(form).charW;
-
-        digit = t.values[unit] % 10;
-        tempStr[0] = isValid ? digit + '0' : TIME_INVALID_CHAR;
-        shift = isValid ? TD(form).charShift[digit] : TD(form).invalidShift;
-        Font_DrawText(tempStr, TD(form).fontSize, Geo_MovePoint(cursor, shift, 0.0f), color);
-        cursor.x += TD(form).charW;
-
-        if (unit != SECONDS){
-            Font_DrawText(TIME_SEP_CHAR_STR, TD(form).fontSize, cursor, color);
-            cursor.x += TD(form).sepW;
-        }
-    }
+    TimDisp_UpdateRun(td, t);
+    Font_DrawGlyphQuads(td->run.quads, td->run.n, pos, color);
 }
 
 
@@ -199,9 +198,82 @@ void TimDisp_DrawTime(Time t, Point pos, TimDisp* td, Color color){
             printf("\n");
             printf("   Invalid Shift: %.3f\n", TD(form).invalidShift);
         }
+
+        printf("Glyph Run: \"%.*s\" (%s form)\n", td->run.n, td->run.chars, 
+               (td->run.form == SHORT_FORM) ? "short" : "long");
     }
 #endif
 
 
 
 
+
+
+// ============================================================================ PRIVATE FUNC DEF
+
+// **************************************************************************** TimDisp_UpdateRun
+
+// Update the glyph run for the time. Only the quads of the characters that 
+// changed are made again
+static void TimDisp_UpdateRun(TimDisp* td, Time t){
+    bool isValid = Time_IsValid(t);
+
+    bool form = (isValid && t.hours > 0) ? LONG_FORM : SHORT_FORM;
+    if (form != td->run.form){
+        TimDisp_ClearRun(td);
+        td->run.form = form;
+    }
+
+    int n = 0;
+    Point cursor = TD(form).origin;
+    for (int unit = HOURS; unit <= SECONDS; unit++){
+        if (unit == HOURS && form == SHORT_FORM){
+            continue;
+        }
+
+        int digit = t.values[unit] / 10;
+        char c = isValid ? digit + '0' : TIME_INVALID_CHAR;
+        float shift = isValid ? TD(form).charShift[digit] : TD(form).invalidShift;
+        TimDisp_SetRunChar(td, n++, c, Geo_MovePoint(cursor, shift, 0.0f));
+        cursor.x += TD(form).charW;
+
+        digit = t.values[unit] % 10;
+        c = isValid ? digit + '0' : TIME_INVALID_CHAR;
+        shift = isValid ? TD(form).charShift[digit] : TD(form).invalidShift;
+        TimDisp_SetRunChar(td, n++, c, Geo_MovePoint(cursor, shift, 0.0f));
+        cursor.x += TD(form).charW;
+
+        if (unit != SECONDS){
+            TimDisp_SetRunChar(td, n++, TIME_SEP_CHAR, cursor);
+            cursor.x += TD(form).sepW;
+        }
+    }
+
+    td->run.n = n;
+}
+
+
+// **************************************************************************** TimDisp_SetRunChar
+
+// Set the i-th character of the glyph run and make its quad, if it changed
+static void TimDisp_SetRunChar(TimDisp* td, int i, char c, Point pos){
+    if (td->run.chars[i] == c){
+        return;
+    }
+
+    td->run.chars[i] = c;
+    td->run.quads[i] = Font_MakeGlyphQuad(c, TD(td->run.form).fontSize, pos);
+}
+
+
+// **************************************************************************** TimDisp_ClearRun
+
+// Clear the characters of the glyph run, so all its quads are made again
+static void TimDisp_ClearRun(TimDisp* td){
+    Memory_Set(td->run.chars, TD_RUN_MAX_N, 0);
+    td->run.n = 0;
+}
+
+
+
+
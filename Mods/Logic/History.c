@@ -0,0 +1,319 @@
+// ============================================================================
+// RODS
+// History
+// by Andreas Socratous
+// Jan 2023
+// ============================================================================
+
+
+// ============================================================================ INFO
+/*
+    Functions for managing the History structure.
+
+    The history is an append-only log of all the completed games. Next to the
+    log, an index keeps the sorted times of every grid size that has been
+    played. It is updated with every new game, so the count, the best and the
+    median time of a grid size are read at a constant cost, without scanning
+    the log.
+*/
+
+
+// ============================================================================ DEPENDENCIES
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <raylib.h>
+
+#include <time.h>
+
+#include "../Public/Public.h"
+#include "../Fund/Fund.h"
+#include "Logic.h"
+
+
+// ============================================================================ PRIVATE CONSTANTS
+
+#define HISTORY_DIM_SIZE                    (RGRID_MAX_SIZE - RGRID_MIN_SIZE + 1)
+#define HISTORY_DEF_CAPACITY                64
+
+
+// ============================================================================ PRIVATE STRUCTURES
+
+// **************************************************************************** HistorySize
+
+// The times, in seconds, of the completed games of a single grid size, sorted
+// in ascending order
+typedef struct HistorySize{
+    int* secs;
+    int count;
+    int capacity;
+}HistorySize;
+
+
+// ============================================================================ OPAQUE STRUCTURES
+
+// **************************************************************************** History
+
+// Log of all the completed games. The first nSaved entries are already stored
+// in the history file. sizeIndex holds the position + 1 of each grid size in
+// sizes, or 0 if the grid size has not been played
+struct History{
+    HistoryEntry* entries;
+    int n;
+    int capacity;
+    int nSaved;
+
+    short sizeIndex[HISTORY_DIM_SIZE][HISTORY_DIM_SIZE];
+    HistorySize* sizes;
+    int nSizes;
+    int sizesCapacity;
+};
+
+
+// ============================================================================ PRIVATE FUNC DECL
+
+static void     History_AddToIndex(History* history, int nCols, int nRows, int secs);
+
+
+
+
+
+
+// ============================================================================ FUNC DEF
+
+// **************************************************************************** History_Make
+
+// Make an empty History structure
+History* History_Make(void){
+    return Memory_Allocate(NULL, sizeof(History), ZEROVAL_ALL);
+}
+
+
+// **************************************************************************** History_Free
+
+// Free the memory of the History structure. Return NULL
+History* History_Free(History* history){
+    if (history == NULL) {return NULL;}
+
+    History_Clear(history);
+
+    return Memory_Free(history);
+}
+
+
+// **************************************************************************** History_Clear
+
+// Remove all the entries and free the memory of the log and the index
+void History_Clear(History* history){
+    for (int i = 0; i < history->nSizes; i++){
+        history->sizes[i].secs = Memory_Free(history->sizes[i].secs);
+    }
+    history->sizes = Memory_Free(history->sizes);
+    history->entries = Memory_Free(history->entries);
+
+    Memory_Set(history, sizeof(History), 0);
+}
+
+
+// **************************************************************************** History_Add
+
+// Add the entry at the end of the log and update the index. Return false if
+// the grid size or the time are invalid
+bool History_Add(History* history, HistoryEntry entry){
+    if (!IS_IN_RANGE(entry.nCols, RGRID_MIN_SIZE, RGRID_MAX_SIZE) ||
+        !IS_IN_RANGE(entry.nRows, RGRID_MIN_SIZE, RGRID_MAX_SIZE) ||
+        !Time_IsValid(entry.time)){
+        return false;
+    }
+
+    if (history->n == history->capacity){
+        history->capacity = MAX(HISTORY_DEF_CAPACITY, history->capacity * 2);
+        history->entries = Memory_Allocate(history->entries,
+                                           sizeof(HistoryEntry) * history->capacity, ZEROVAL_NONE);
+    }
+
+    history->entries[history->n] = entry;
+    history->n++;
+
+    History_AddToIndex(history, entry.nCols, entry.nRows, Time_ToInt(entry.time));
+
+    return true;
+}
+
+
+// **************************************************************************** History_AddGame
+
+// Add a game that was completed now. Return false if the grid size or the time
+// are invalid
+bool History_AddGame(History* history, int nCols, int nRows, Time t, int clicks){
+    HistoryEntry entry;
+    entry.nCols = nCols;
+    entry.nRows = nRows;
+    entry.time = t;
+    entry.clicks = MAX(0, clicks);
+    entry.date = (long long) time(NULL);
+
+    return History_Add(history, entry);
+}
+
+
+// **************************************************************************** History_N
+
+// The number of entries in the log
+int History_N(const History* history){
+    return history->n;
+}
+
+
+// **************************************************************************** History_NSizes
+
+// The number of different grid sizes in the log
+int History_NSizes(const History* history){
+    return history->nSizes;
+}
+
+
+// **************************************************************************** History_GetEntry
+
+// Get the entry at the given position of the log. If the index is invalid,
+// return an entry with zero size
+HistoryEntry History_GetEntry(const History* history, int index){
+    if (!IS_IN_RANGE(index, 0, history->n - 1)){
+        return (HistoryEntry) {.time = TIME_INVALID};
+    }
+
+    return history->entries[index];
+}
+
+
+// **************************************************************************** History_GetStats
+
+// Get the count, the best and the median time of the given grid size. For an
+// even count, the median is the smaller of the two middle times
+HistoryStats History_GetStats(const History* history, int nCols, int nRows){
+    HistoryStats stats = {.count = 0, .best = TIME_INVALID, .median = TIME_INVALID};
+
+    if (!IS_IN_RANGE(nCols, RGRID_MIN_SIZE, RGRID_MAX_SIZE) ||
+        !IS_IN_RANGE(nRows, RGRID_MIN_SIZE, RGRID_MAX_SIZE)){
+        return stats;
+    }
+
+    int index = history->sizeIndex[nCols - RGRID_MIN_SIZE][nRows - RGRID_MIN_SIZE];
+    if (index == 0) {return stats;}
+
+    const HistorySize* size = &history->sizes[index - 1];
+    stats.count = size->count;
+    stats.best = Time_FromInt(size->secs[0]);
+    stats.median = Time_FromInt(size->secs[(size->count - 1) / 2]);
+
+    return stats;
+}
+
+
+// **************************************************************************** History_GetNumSaved
+
+// The number of entries, at the start of the log, that are already stored in
+// the history file
+int History_GetNumSaved(const History* history){
+    return history->nSaved;
+}
+
+
+// **************************************************************************** History_SetAllSaved
+
+// Mark all the entries as stored in the history file
+void History_SetAllSaved(History* history){
+    history->nSaved = history->n;
+}
+
+
+// **************************************************************************** History_MakeDefault
+
+// Make the History structure at Glo_History
+void History_MakeDefault(void){
+    History_FreeDefault();
+    Glo_History = History_Make();
+}
+
+
+// **************************************************************************** History_FreeDefault
+
+// Free the memory of the History structure at Glo_History
+void History_FreeDefault(void){
+    Glo_History = History_Free(Glo_History);
+}
+
+
+#ifdef DEBUG_MODE
+// **************************************************************************** History_Print
+
+    // Multiline print of the statistics of every grid size in the history
+    void History_Print(const History* history){
+        CHECK_NULL(history, WITH_NEW_LINE)
+
+        printf("History (%d games, %d saved, %d sizes):\n", history->n, history->nSaved,
+               history->nSizes);
+
+        for (int y = RGRID_MIN_SIZE; y <= RGRID_MAX_SIZE; y++){
+            for (int x = RGRID_MIN_SIZE; x <= RGRID_MAX_SIZE; x++){
+                HistoryStats stats = History_GetStats(history, x, y);
+                if (stats.count == 0) {continue;}
+                printf(" %3d x %3d: %5d | Best: ", x, y, stats.count);
+                Time_Print(stats.best, WITHOUT_NEW_LINE);
+                printf(" | Median: ");
+                Time_Print(stats.median, WITH_NEW_LINE);
+            }
+        }
+    }
+#endif
+
+
+
+
+
+
+// ============================================================================ PRIVATE FUNC DEF
+
+// **************************************************************************** History_AddToIndex
+
+// Insert the time in the sorted times of the grid size. Add the grid size to
+// the index, if it is new
+static void History_AddToIndex(History* history, int nCols, int nRows, int secs){
+    short* index = &history->sizeIndex[nCols - RGRID_MIN_SIZE][nRows - RGRID_MIN_SIZE];
+
+    if (*index == 0){
+        if (history->nSizes == history->sizesCapacity){
+            history->sizesCapacity = MAX(HISTORY_DEF_CAPACITY, history->sizesCapacity * 2);
+            history->sizes = Memory_Allocate(history->sizes,
+                                             sizeof(HistorySize) * history->sizesCapacity,
+                                             ZEROVAL_NONE);
+        }
+        history->sizes[history->nSizes] = (HistorySize) {.secs = NULL, .count = 0, .capacity = 0};
+        history->nSizes++;
+        *index = history->nSizes;
+    }
+
+    HistorySize* size = &history->sizes[*index - 1];
+
+    if (size->count == size->capacity){
+        size->capacity = MAX(4, size->capacity * 2);
+        size->secs = Memory_Allocate(size->secs, sizeof(int) * size->capacity, ZEROVAL_NONE);
+    }
+
+    // Binary search for the first time greater than secs
+    int low = 0, high = size->count;
+    while (low < high){
+        int mid = (low + high) / 2;
+        if (size->secs[mid] <= secs){
+            low = mid + 1;
+        }else{
+            high = mid;
+        }
+    }
+
+    for (int i = size->count; i > low; i--){
+        size->secs[i] = size->secs[i - 1];
+    }
+    size->secs[low] = secs;
+    size->count++;
+}
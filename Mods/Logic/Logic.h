@@ -13,7 +13,7 @@
 // ============================================================================ INFO
 /*
     Functions for managing Rods and the Rod Grid as well as the Records, that 
-    store record times.
+    store record times, and the History of the completed games.
 */
 
 
@@ -37,6 +37,7 @@ bool            Rod_IsAnimating(const Rod* rod);
 void            Rod_Rotate(Rod* rod, int times, bool withAnim);
 bool            Rod_Update(Rod* rod);
 bool            Rod_FinishAnim(Rod* rod);
+int             Rod_CalcRotationsToSolve(const Rod* rod);
 #ifdef DEBUG_MODE
     void        Rod_Print(const Rod* rod, bool withNewLine);
 #endif
@@ -48,8 +49,10 @@ RGrid*          RGrid_Copy(RGrid* dst, const RGrid* src);
 RGrid*          RGrid_Free(RGrid* rGrid);
 void            RGrid_Clear(RGrid* rGrid);
 void            RGrid_CreateRandom(RGrid* rGrid);
+void            RGrid_CreateFromSeed(RGrid* rGrid, unsigned int seed);
 void            RGrid_SetSize(RGrid* rGrid, int nCols, int nRows);
 void            RGrid_Shuffle(RGrid* rGrid);
+void            RGrid_ShuffleFromSeed(RGrid* rGrid, unsigned int seed);
 void            RGrid_Electrify(RGrid* rGrid, GNode start);
 void            RGrid_Deelectrify(RGrid* rGrid);
 void            RGrid_Reelectrify(RGrid* rGrid);
@@ -62,10 +65,15 @@ Rod*            RGrid_GetRod(const RGrid* rGrid, GNode node);
 Rod*            RGrid_GetRod_Fast(const RGrid* rGrid, GNode node);
 void            RGrid_SetRod(RGrid* rGrid, GNode node, int legs);
 void            RGrid_SetSource(RGrid* rGrid, GNode source);
+int             RGrid_GetSeeds(const RGrid* rGrid, unsigned int* genSeed, unsigned int* shuffleSeed);
+int             RGrid_GetNumClicks(const RGrid* rGrid);
+int             RGrid_CalcPar(const RGrid* rGrid);
 bool            RGrid_IsAnimating(const RGrid* rGrid);
+int             RGrid_GetNumAnimating(const RGrid* rGrid);
 int             RGrid_GetTotal(const RGrid* rGrid);
 int             RGrid_GetNumElectrified(const RGrid* rGrid);
 int             RGrid_GetNumUnelectrified(const RGrid* rGrid);
+unsigned int    RGrid_GetVersion(const RGrid* rGrid);
 bool            RGrid_IsCompleted(const RGrid* rGrid);
 #ifdef DEBUG_MODE
     void        RGrid_Print(const RGrid* rGrid);
@@ -86,6 +94,25 @@ void            Records_FreeDefault(void);
     void        Records_Print(const Records* records);
 #endif
 
+// ---------------------------------------------------------------------------- History Functions
+
+History*        History_Make(void);
+History*        History_Free(History* history);
+void            History_Clear(History* history);
+bool            History_Add(History* history, HistoryEntry entry);
+bool            History_AddGame(History* history, int nCols, int nRows, Time t, int clicks);
+int             History_N(const History* history);
+int             History_NSizes(const History* history);
+HistoryEntry    History_GetEntry(const History* history, int index);
+HistoryStats    History_GetStats(const History* history, int nCols, int nRows);
+int             History_GetNumSaved(const History* history);
+void            History_SetAllSaved(History* history);
+void            History_MakeDefault(void);
+void            History_FreeDefault(void);
+#ifdef DEBUG_MODE
+    void        History_Print(const History* history);
+#endif
+
 
 #endif // LOGIC_GUARD
 
@@ -16,6 +16,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdatomic.h>
 #include <raylib.h>
 
 #include "../Public/Public.h"
@@ -35,10 +36,22 @@
 #define RGRID_UPDATABLE_N                   5
 
 
+// ============================================================================ PRIVATE VARIABLES
+
+// The last version given to any rod grid. Atomic, since the rod grids of the
+// Packer and the thumbnail worker are touched in other threads
+static atomic_uint rgridLastVersion = 0;
+
+
 // ============================================================================ OPAQUE STRUCTURES
 
 // A grid of rods of which one is the source. The rods can be rotated until all 
-// are connected to the source
+// are connected to the source. nSeeds is the number of seeds (generation, 
+// shuffle) that reproduce the grid, apart from the rotations of the player. 
+// Setting a rod or the source resets it to 0. nClicks is the number of 
+// rotations by the player since the grid was cleared. version changes at 
+// every change of the legs, the electrification or the source, and is unique 
+// among all the rod grids
 struct RGrid{
     Grid size;
     GNode source;
@@ -50,6 +63,14 @@ struct RGrid{
 
     int nElectrified;
     int nTotal;
+
+    unsigned int genSeed;
+    unsigned int shuffleSeed;
+    int nSeeds;
+
+    int nClicks;
+
+    unsigned int version;
 };
 
 
@@ -57,6 +78,7 @@ struct RGrid{
 
 static void     RGrid_AddToUpdatable(RGrid* rGrid, GNode node);
 static bool     RGrid_RodCanBeElectrified(const RGrid* rGrid, GNode node);
+static void     RGrid_Touch(RGrid* rGrid);
 
 
 
@@ -111,6 +133,8 @@ void RGrid_Clear(RGrid* rGrid){
     }
 
     rGrid->nTotal = Grid_N(rGrid->size);
+
+    RGrid_Touch(rGrid);
 }
 
 
@@ -118,6 +142,15 @@ void RGrid_Clear(RGrid* rGrid){
 
 // Create a random rod grid
 void RGrid_CreateRandom(RGrid* rGrid){
+    RGrid_CreateFromSeed(rGrid, Math_RandomSeed());
+}
+
+
+// **************************************************************************** RGrid_CreateFromSeed
+
+// Create a random rod grid from the given seed. The same seed and size always 
+// give the same rod grid
+void RGrid_CreateFromSeed(RGrid* rGrid, unsigned int seed){
     /*
         DEPTH-FIRST SEARCH ALGORITHM:
         1) Choose a random rod in the grid, electrify it, and make it the 
@@ -135,11 +168,14 @@ void RGrid_CreateRandom(RGrid* rGrid){
     RGrid_Clear(rGrid);
 
     // Make an array to hold the track
-    GNode* track = Memory_Allocate(NULL, sizeof(GNode) * rGrid->nTotal, ZEROVAL_ALL);
+    GNode* track = Scratch_Allocate(sizeof(GNode) * rGrid->nTotal, ZEROVAL_ALL);
     int n = 0;
 
+    unsigned int state = seed;
+
     // Choose a random rod and make it the source
-    rGrid->source = Grid_RandomNode(rGrid->size);
+    rGrid->source.x = Math_SeededRandomInt(&state, 0, rGrid->size.nCols - 1);
+    rGrid->source.y = Math_SeededRandomInt(&state, 0, rGrid->size.nRows - 1);
     RON(rGrid->source).isElectrified = true;
     rGrid->nElectrified++;
 
@@ -156,7 +192,7 @@ void RGrid_CreateRandom(RGrid* rGrid){
         GNode next = GNODE_INVALID;
 
         // Check all 4 directions for an unelectrified adjacent rod
-        E_Direction dir = Direction_Random(INCLUDE_NOT_NONE);
+        E_Direction dir = Math_SeededRandomInt(&state, DIR_RIGHT, DIR_UP);
         for (int i = 0; i < 4; i++){
             GNode temp = Grid_MoveNodeToDir(current, dir, 1);
             if (Grid_NodeIsInGrid(temp, rGrid->size) && !RON(temp).isElectrified){
@@ -185,10 +221,15 @@ void RGrid_CreateRandom(RGrid* rGrid){
     }
 
     // Clean up
-    track = Memory_Free(track);
+    track = Scratch_Free(track);
 
     // Validate
     Err_Assert(rGrid->nElectrified == rGrid->nTotal, "Failed to create a valid rod grid");
+
+    rGrid->genSeed = seed;
+    rGrid->nSeeds = 1;
+
+    RGrid_Touch(rGrid);
 }
 
 
@@ -210,13 +251,28 @@ void RGrid_SetSize(RGrid* rGrid, int nCols, int nRows){
 
 // Rotate all the rods in the grid randomly 0-3 times
 void RGrid_Shuffle(RGrid* rGrid){
+    RGrid_ShuffleFromSeed(rGrid, Math_RandomSeed());
+}
+
+
+// **************************************************************************** RGrid_ShuffleFromSeed
+
+// Rotate all the rods in the grid 0-3 times, as given by the seed
+void RGrid_ShuffleFromSeed(RGrid* rGrid, unsigned int seed){
+    unsigned int state = seed;
+
     GNode temp = GNODE_NULL;
     do{
-        Rod_Rotate(&RON(temp), Math_RandomInt(0, 3), WITHOUT_ANIM);
+        Rod_Rotate(&RON(temp), Math_SeededRandomInt(&state, 0, 3), WITHOUT_ANIM);
         temp = Grid_NextNode(temp, rGrid->size);
     }while (!Grid_NodesAreEqual(temp, GNODE_NULL));
 
     RGrid_Reelectrify(rGrid);
+
+    rGrid->shuffleSeed = seed;
+    rGrid->nSeeds = (rGrid->nSeeds == 1) ? 2 : 0;
+
+    RGrid_Touch(rGrid);
 }
 
 
@@ -233,8 +289,12 @@ void RGrid_Electrify(RGrid* rGrid, GNode start){
         return;
     }
 
+    TRACE_BEGIN("RGrid_Electrify", rGrid->nTotal)
+
+    RGrid_Touch(rGrid);
+
     // Make an array to hold the electrified rods
-    GNode* list = Memory_Allocate(NULL, sizeof(GNode) * rGrid->nTotal, ZEROVAL_NONE);
+    GNode* list = Scratch_Allocate(sizeof(GNode) * rGrid->nTotal, ZEROVAL_NONE);
     int n = 0;
 
     // Electrify the start and add it to the list
@@ -264,8 +324,12 @@ void RGrid_Electrify(RGrid* rGrid, GNode start){
         }
     }
 
+    Counter_Add(CNT_ELECTRIFY_NODES, n);
+
     // Clean up
-    list = Memory_Free(list);
+    list = Scratch_Free(list);
+
+    TRACE_END
 }
 
 
@@ -280,6 +344,8 @@ void RGrid_Deelectrify(RGrid* rGrid){
     }while (!Grid_NodesAreEqual(temp, GNODE_NULL));
 
     rGrid->nElectrified = 0;
+
+    RGrid_Touch(rGrid);
 }
 
 
@@ -287,6 +353,8 @@ void RGrid_Deelectrify(RGrid* rGrid){
 
 // Deelectrify and reelectrify the rod grid
 void RGrid_Reelectrify(RGrid* rGrid){
+    Counter_Add(CNT_REELECTRIFY_CALLS, 1);
+
     RGrid_Deelectrify(rGrid);
     RGrid_Electrify(rGrid, GNODE_INVALID);
 }
@@ -301,6 +369,8 @@ void RGrid_RotateRod(RGrid* rGrid, GNode node){
     }
 
     Rod_Rotate(&RON(node), 1, WITH_ANIM);
+    rGrid->nClicks++;
+    RGrid_Touch(rGrid);
 
     if (RON(node).isElectrified){
         RGrid_Reelectrify(rGrid);
@@ -385,6 +455,9 @@ Rod* RGrid_GetRod_Fast(const RGrid* rGrid, GNode node){
 // not rotating
 void RGrid_SetRod(RGrid* rGrid, GNode node, int legs){
     Rod_Set(&RON(node), legs);
+    rGrid->nSeeds = 0;
+
+    RGrid_Touch(rGrid);
 }
 
 
@@ -394,10 +467,50 @@ void RGrid_SetRod(RGrid* rGrid, GNode node, int legs){
 void RGrid_SetSource(RGrid* rGrid, GNode source){
     if (Grid_NodeIsInGrid(source, rGrid->size)){
         rGrid->source = source;
+        rGrid->nSeeds = 0;
+        RGrid_Touch(rGrid);
     }
 }
 
 
+// **************************************************************************** RGrid_GetSeeds
+
+// Save the generation and shuffle seeds at the given pointers, if not NULL. 
+// Return the number of seeds that reproduce the grid, apart from the rotations 
+// of the player (0-2)
+int RGrid_GetSeeds(const RGrid* rGrid, unsigned int* genSeed, unsigned int* shuffleSeed){
+    if (genSeed != NULL)     {*genSeed = rGrid->genSeed;}
+    if (shuffleSeed != NULL) {*shuffleSeed = rGrid->shuffleSeed;}
+
+    return rGrid->nSeeds;
+}
+
+
+// **************************************************************************** RGrid_GetNumClicks
+
+// The number of rotations by the player since the grid was cleared
+int RGrid_GetNumClicks(const RGrid* rGrid){
+    return rGrid->nClicks;
+}
+
+
+// **************************************************************************** RGrid_CalcPar
+
+// The minimum number of rotations that bring all the rods back to the 
+// orientation they had when the grid was created
+int RGrid_CalcPar(const RGrid* rGrid){
+    int par = 0;
+
+    GNode temp = GNODE_NULL;
+    do{
+        par += Rod_CalcRotationsToSolve(&RON(temp));
+        temp = Grid_NextNode(temp, rGrid->size);
+    }while (!Grid_NodesAreEqual(temp, GNODE_NULL));
+
+    return par;
+}
+
+
 // **************************************************************************** RGrid_IsAnimating
 
 // Return true if any rod in the grid is animating
@@ -412,6 +525,21 @@ bool RGrid_IsAnimating(const RGrid* rGrid){
 }
 
 
+// **************************************************************************** RGrid_GetNumAnimating
+
+// Return the number of rods in the grid that are animating
+int RGrid_GetNumAnimating(const RGrid* rGrid){
+    int n = 0;
+    for (int i = 0; i < RGRID_UPDATABLE_N; i++){
+        if (rGrid->updatable[i].x != INVALID){
+            n++;
+        }
+    }
+
+    return n;
+}
+
+
 // **************************************************************************** RGrid_GetTotal
 
 // Return the total number of rods in the grid
@@ -436,6 +564,15 @@ int RGrid_GetNumUnelectrified(const RGrid* rGrid){
 }
 
 
+// **************************************************************************** RGrid_GetVersion
+
+// Return the version of the rod grid. Equal versions mean that the legs, the 
+// electrification and the source have not changed
+unsigned int RGrid_GetVersion(const RGrid* rGrid){
+    return rGrid->version;
+}
+
+
 // **************************************************************************** RGrid_IsCompleted
 
 // return true if the rod grid is completed
@@ -501,6 +638,9 @@ bool RGrid_IsCompleted(const RGrid* rGrid){
         printf("Upd Index:     %d\n", rGrid->updIndex);
         printf("Total:         %d\n", rGrid->nTotal);
         printf("N Electrified: %d\n", rGrid->nElectrified);
+        printf("Seeds (%d):     %u, %u\n", rGrid->nSeeds, rGrid->genSeed, rGrid->shuffleSeed);
+        printf("Clicks:        %d\n", rGrid->nClicks);
+        printf("Version:       %u\n", rGrid->version);
         PRINT_LINE
     }
 #endif
@@ -566,3 +706,11 @@ static bool RGrid_RodCanBeElectrified(const RGrid* rGrid, GNode node){
     return false;
 }
 
+
+// **************************************************************************** RGrid_Touch
+
+// Give the rod grid a new version, after a change
+static void RGrid_Touch(RGrid* rGrid){
+    rGrid->version = atomic_fetch_add_explicit(&rgridLastVersion, 1, memory_order_relaxed) + 1;
+}
+
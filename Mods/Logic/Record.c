@@ -30,9 +30,11 @@
 
 // ============================================================================ OPAQUE STRUCTURES
 
-// Structure for storing the minimum record time for various grid sizes
+// Structure for storing the minimum record time for various grid sizes. n is 
+// the number of valid times
 struct Records{
     Time values[RECORDS_DIM_SIZE][RECORDS_DIM_SIZE];
+    int n;
 };
 
 
@@ -79,6 +81,8 @@ void Records_Clear(Records* records){
             records->values[x - RGRID_MIN_SIZE][y - RGRID_MIN_SIZE] = TIME_INVALID;
         }
     }
+
+    records->n = 0;
 }
 
 
@@ -108,7 +112,9 @@ void Records_Set(Records* records, Time t, int nCols, int nRows){
         t = TIME_INVALID;
     }
 
-    records->values[nCols - RGRID_MIN_SIZE][nRows - RGRID_MIN_SIZE] = t;
+    Time* value = &records->values[nCols - RGRID_MIN_SIZE][nRows - RGRID_MIN_SIZE];
+    records->n += (Time_IsValid(t) ? 1 : 0) - (Time_IsValid(*value) ? 1 : 0);
+    *value = t;
 }
 
 
@@ -116,17 +122,7 @@ void Records_Set(Records* records, Time t, int nCols, int nRows){
 
 // The number of valid times in the record
 int Records_N(const Records* records){
-    int res = 0;
-    for (int y = RGRID_MIN_SIZE; y <= RGRID_MAX_SIZE; y++){
-        for (int x = RGRID_MIN_SIZE; x <= RGRID_MAX_SIZE; x++){
-            Time temp = records->values[x - RGRID_MIN_SIZE][y - RGRID_MIN_SIZE];
-            if (Time_IsValid(temp)){
-                res++;
-            }
-        }
-    }
-
-    return res;
+    return records->n;
 }
 
 
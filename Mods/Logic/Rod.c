@@ -72,6 +72,7 @@ bool Rod_IsAnimating(const Rod* rod){
 // Rotate the rod by 90° clockwise x times, optionally with animation
 void Rod_Rotate(Rod* rod, int times, bool withAnim){
     rod->legs = Direction_RotateLegs(rod->legs, times);
+    rod->rotation = (rod->rotation + times % 4 + 4) % 4;
 
     if (withAnim && times > 0){
         rod->frame = ROD_ROT_FRAMES_N - 1;
@@ -109,6 +110,23 @@ bool Rod_FinishAnim(Rod* rod){
 }
 
 
+// **************************************************************************** Rod_CalcRotationsToSolve
+
+// The minimum number of 90° clockwise rotations that bring the rod back to the 
+// orientation it had when it was set
+int Rod_CalcRotationsToSolve(const Rod* rod){
+    int solvedLegs = Direction_RotateLegs(rod->legs, -rod->rotation);
+
+    for (int times = 0; times < 4; times++){
+        if (Direction_RotateLegs(rod->legs, times) == solvedLegs){
+            return times;
+        }
+    }
+
+    return 0;
+}
+
+
 #ifdef DEBUG_MODE
 // **************************************************************************** Rod_Print
 
@@ -118,6 +136,7 @@ bool Rod_FinishAnim(Rod* rod){
 
         Direction_PrintLegs(rod->legs, WITHOUT_NEW_LINE);
         printf(" | El: %s", Bool_ToString(rod->isElectrified, LONG_FORM));
+        printf(" | Rot: %d", rod->rotation);
         printf(" | Frame: %d", rod->frame);
         
         if (withNewLine) {printf("\n");}
@@ -23,6 +23,7 @@
 #include "../Fund/Fund.h"
 #include "../Logic/Logic.h"
 #include "../Graph/Graph.h"
+#include "../Store/Store.h"
 #include "../GUI/GUI.h"
 #include "../Gadgets/Gadgets.h"
 #include "../Sound/Sound.h"
@@ -43,21 +44,27 @@
 #define SBAR_HOR_RATIO                      0.75f
 #define SBAR_VER_RATIO                      0.75f
 #define SBAR_WIDTH                          30.0f
+#define MINIMAP_SIZE                        150.0f
 
 // Gadget Indices
 #define GP_BOARD                            0
 #define GP_SBAR_HOR                         1
 #define GP_SBAR_VER                         2
-#define GP_TOOLBAR                          3
+#define GP_MINIMAP                          3
+#define GP_TOOLBAR                          4
+
+// Keys that switch to the save slots
+#define SLOT_KEYS                           ((const KeyboardKey[SLOTS_N]) {WKEY_1, WKEY_2, WKEY_3, WKEY_4})
 
 
 // ============================================================================ PRIVATE STRUCTURES
 
 // **************************************************************************** GamePageData
 
-// The data object of the game page
+// The data object of the game page. slot is the active save slot
 typedef struct GamePageData{
     int nRodsLeft;
+    int slot;
 }GamePageData;
 
 
@@ -67,6 +74,7 @@ static void     GamePage_PrepareToShow(Page* page, Event event);
 static void     GamePage_Resize(Page* page);
 static void     GamePage_ReactToEvent(Page* page, Event event, EventQueue* queue);
 static void     GamePage_Update(Page* page, EventQueue* queue);
+static void     GamePage_SwitchSlot(Page* page, int slot, EventQueue* queue);
 #ifdef DEBUG_MODE
     static void GamePage_PrintData(const Page* page);
 #endif
@@ -94,6 +102,9 @@ Page* GamePage_Make(PData* pData){
     Gadget* sbarVer = Scrollbar_Make(GDG_SCROLLBAR_VER, OR_VERTICAL);
     Page_AddGadget(page, sbarVer);
 
+    Gadget* minimap = Minimap_Make(GDG_MINIMAP, board);
+    Page_AddGadget(page, minimap);
+
     Gadget* toolbar = Toolbar_Make();
     Page_AddGadget(page, toolbar);
 
@@ -105,7 +116,7 @@ Page* GamePage_Make(PData* pData){
         page->PrintData = GamePage_PrintData;
     #endif
 
-    GamePageData* data = Memory_Allocate(NULL, sizeof(GamePageData), ZEROVAL_ALL);
+    GamePageData* data = Page_AllocateData(sizeof(GamePageData));
     page->data = data;
     
     Page_Resize(page);
@@ -113,6 +124,8 @@ Page* GamePage_Make(PData* pData){
     if (pData != NULL && Time_IsValid(pData->time)){
         Toolbar_SetTime(toolbar, pData->time);
     }
+
+    data->slot = (pData != NULL) ? PUT_IN_RANGE(pData->slot, 0, SLOTS_N - 1) : 0;
     
     data->nRodsLeft = Board_GetNumUnelectrifiedRodsLeft(board);
     Toolbar_SetRodsLeft(toolbar, data->nRodsLeft);
@@ -157,6 +170,14 @@ Grid GamePage_GetGridSize(const Page* page){
 }
 
 
+// **************************************************************************** GamePage_GetSlot
+
+// Return the active save slot
+int GamePage_GetSlot(const Page* page){
+    return GPDATA->slot;
+}
+
+
 
 
 
@@ -188,6 +209,12 @@ static void GamePage_Resize(Page* page){
     page->gadgets[GP_SBAR_HOR]->cRect = Geo_AlignRect(TO_RECT(sbarHorSize), winRect, RP_BOTTOM_CENTER);
     page->gadgets[GP_SBAR_VER]->cRect = Geo_AlignRect(TO_RECT(sbarVerSize), winRect, RP_MIDDLE_RIGHT);
 
+    // The minimap fits in the bottom left corner, next to the horisontal 
+    // scrollbar
+    float minimapSize = MIN(MINIMAP_SIZE, (winRect.width - sbarHorWidth) * 0.5f);
+    Size minimapCSize = SIZE(minimapSize, minimapSize);
+    page->gadgets[GP_MINIMAP]->cRect = Geo_AlignRect(TO_RECT(minimapCSize), winRect, RP_BOTTOM_LEFT);
+
     // The toolbar resizes automatically
 }
 
@@ -199,7 +226,7 @@ static void GamePage_ReactToEvent(Page* page, Event event, EventQueue* queue){
     switch (event.id){
         case EVENT_GADGET_EXPANDED: case EVENT_GADGET_COLLAPSED:{
             switch (event.source){
-                case GDG_TOOLBAR: case GDG_SCROLLBAR_HOR: case GDG_SCROLLBAR_VER:{
+                case GDG_TOOLBAR: case GDG_SCROLLBAR_HOR: case GDG_SCROLLBAR_VER: case GDG_MINIMAP:{
                     if (event.id == EVENT_GADGET_EXPANDED){
                         Board_SetAsNotReactive(page->gadgets[GP_BOARD]);
                     }else{
@@ -287,6 +314,12 @@ static void GamePage_ReactToEvent(Page* page, Event event, EventQueue* queue){
         }
 
         case EVENT_KEY_RELEASED:{
+            for (int i = 0; i < SLOTS_N; i++){
+                if (event.data.key == SLOT_KEYS[i]){
+                    GamePage_SwitchSlot(page, i, queue);
+                }
+            }
+
             if (event.data.key == WKEY_T){
                 if (Toolbar_IsAnimating(page->gadgets[GP_TOOLBAR])) {break;}
                 if (page->gadgets[GP_TOOLBAR]->isExpanded){
@@ -313,6 +346,8 @@ static void GamePage_ReactToEvent(Page* page, Event event, EventQueue* queue){
             Timer_Pause(page->gadgets[GP_TOOLBAR]->subGadgets[TB_TIMER]);
             Time tempTime = Toolbar_GetTime(page->gadgets[GP_TOOLBAR]);
             Grid tempGridSize = GamePage_GetGridSize(page);
+            int tempClicks = RGrid_GetNumClicks(GamePage_GetRGrid(page));
+            History_AddGame(Glo_History, tempGridSize.nCols, tempGridSize.nRows, tempTime, tempClicks);
             Event tempEvent = Event_SetAsShowPage(page->id, PAGE_SETUP, WITH_ANIM);
             Event_AddPageData(&tempEvent, true, tempTime, tempGridSize.nCols, tempGridSize.nRows);
             Queue_AddEvent(queue, tempEvent);
@@ -341,6 +376,51 @@ static void GamePage_Update(Page* page, UNUSED EventQueue* queue){
 }
 
 
+// **************************************************************************** GamePage_SwitchSlot
+
+// Save the game to the active save slot and load the game of the given slot. 
+// If the slot is empty or its game is completed, start a new game of the same 
+// size
+static void GamePage_SwitchSlot(Page* page, int slot, EventQueue* queue){
+    if (slot == GPDATA->slot) {return;}
+
+    Gadget* board = page->gadgets[GP_BOARD];
+    Gadget* toolbar = page->gadgets[GP_TOOLBAR];
+
+    RGrid* rGrid = NULL;
+    SGraph* sg = NULL;
+    Time time = TIME_NULL;
+
+    if (!Slot_ReadFromFile(slot, &rGrid, &sg, &time) || RGrid_IsCompleted(rGrid)){
+        Grid size = Board_GetGridSize(board);
+        rGrid = RGrid_Free(rGrid);
+        sg = SGraph_Free(sg);
+        rGrid = RGrid_MakeEmpty(size.nCols, size.nRows);
+        RGrid_CreateRandom(rGrid);
+        RGrid_Shuffle(rGrid);
+        time = TIME_NULL;
+    }
+
+    Time prevTime = Toolbar_GetTime(toolbar);
+    Board_SwapGame(board, &rGrid, &sg, queue);
+    Slot_WriteToFile(GPDATA->slot, rGrid, sg, prevTime);
+    rGrid = RGrid_Free(rGrid);
+    sg = SGraph_Free(sg);
+
+    GPDATA->slot = slot;
+
+    Grid size = Board_GetGridSize(board);
+    Toolbar_SetRecordTime(toolbar, Records_Get(Glo_Records, size.nCols, size.nRows));
+    Toolbar_SetTime(toolbar, time);
+    Timer_Resume(toolbar->subGadgets[TB_TIMER]);
+
+    GPDATA->nRodsLeft = Board_GetNumUnelectrifiedRodsLeft(board);
+    Toolbar_SetRodsLeft(toolbar, GPDATA->nRodsLeft);
+
+    Music_FadeOut();
+}
+
+
 #ifdef DEBUG_MODE
 // **************************************************************************** GamePage_PrintData
 
@@ -350,6 +430,7 @@ static void GamePage_Update(Page* page, UNUSED EventQueue* queue){
         CHECK_NULL(page->data, WITH_NEW_LINE)
 
         printf("Rods Left: %d\n", GPDATA->nRodsLeft);
+        printf("Slot:      %d\n", GPDATA->slot);
     }
 #endif
 
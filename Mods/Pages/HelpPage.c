@@ -56,11 +56,12 @@
                                              "+, -, Z, X,", "Zoom in/out",           \
                                              "T",           "Toggle the toolbar",    \
                                              "M",           "Sound on/off",          \
-                                             "R",           "Default view"           \
+                                             "R",           "Default view",          \
+                                             "1, 2, 3, 4",  "Switch save slot"       \
                                             })
 
 #define TABLE_COLS_N                        2
-#define TABLE_ROWS_N                        9
+#define TABLE_ROWS_N                        10
 
 // Gadget Indices
 
@@ -115,7 +116,7 @@ Page* HelpPage_Make(void){
         page->PrintData = HelpPage_PrintData;
     #endif
 
-    HelpPageData* data = Memory_Allocate(NULL, sizeof(HelpPageData), ZEROVAL_ALL);
+    HelpPageData* data = Page_AllocateData(sizeof(HelpPageData));
     page->data = data;
 
     Page_Resize(page);
@@ -11,7 +11,7 @@
     Functions and definitions of constants and structures for the info page.
 
     The info page presents information about the version and the author of the 
-    program.
+    program, as well as the number of completed games in the history.
 */
 
 
@@ -23,6 +23,7 @@
 
 #include "../Public/Public.h"
 #include "../Fund/Fund.h"
+#include "../Logic/Logic.h"
 #include "../Graph/Graph.h"
 #include "../GUI/GUI.h"
 #include "../Gadgets/Gadgets.h"
@@ -40,8 +41,8 @@
 
 // ============================================================================ PRIVATE CONSTANTS
 
-#define MIN_SIZE                            SIZE(200, 75)
-#define MAX_SIZE                            SIZE(400, 150)
+#define MIN_SIZE                            SIZE(200, 110)
+#define MAX_SIZE                            SIZE(400, 220)
 #define MIN_MARGIN                          50.0f
 
 #define MARGIN_TO_EDGE                      20.0f
@@ -49,6 +50,7 @@
 
 #define ROW1_TEXT                           APP_TITLE " v" APP_VERSION
 #define ROW2_TEXT                           "by " APP_AUTHOR
+#define ROW3_TEXT                           "Games played: "
 
 #define COL_TEXT                            COL_UI_FG_PRIMARY
 #define COL_BG_RECT                         COL_UI_BG_TERTIARY
@@ -66,6 +68,7 @@ typedef struct InfoPageData{
 
 // ============================================================================ PRIVATE FUNC DECL
 
+static void     InfoPage_PrepareToShow(Page* page, Event event);
 static void     InfoPage_Resize(Page* page);
 static void     InfoPage_ResizeAfterGadgets(Page* page);
 static void     InfoPage_ReactToEvent(Page* page, Event event, EventQueue* queue);
@@ -93,6 +96,10 @@ Page* InfoPage_Make(void){
     Gadget* row2 = Label_Make(GDG_INFO_LBL_AUTHOR, ROW2_TEXT, COL_TEXT, RP_CENTER);
     Page_AddGadget(page, row2);
 
+    Gadget* row3 = Label_Make(GDG_INFO_LBL_GAMES, ROW3_TEXT, COL_TEXT, RP_CENTER);
+    Page_AddGadget(page, row3);
+
+    page->PrepareToShow      = InfoPage_PrepareToShow;
     page->Resize             = InfoPage_Resize;
     page->ResizeAfterGadgets = InfoPage_ResizeAfterGadgets;
     page->ReactToEvent       = InfoPage_ReactToEvent;
@@ -101,7 +108,7 @@ Page* InfoPage_Make(void){
         page->PrintData      = InfoPage_PrintData;
     #endif
 
-    InfoPageData* data = Memory_Allocate(NULL, sizeof(InfoPageData), ZEROVAL_ALL);
+    InfoPageData* data = Page_AllocateData(sizeof(InfoPageData));
     page->data = data;
 
     Page_Resize(page);
@@ -112,6 +119,22 @@ Page* InfoPage_Make(void){
 
 // ============================================================================ PRIVATE FUNC DEF
 
+// **************************************************************************** InfoPage_PrepareToShow
+
+// Update the number of completed games
+static void InfoPage_PrepareToShow(Page* page, UNUSED Event event){
+    int nGames = (Glo_History != NULL) ? History_N(Glo_History) : 0;
+
+    char buffer[sizeof(ROW3_TEXT) + INT_STR_SIZE];
+    StrBuf txt = StrBuf_Make(buffer, sizeof(buffer));
+    StrBuf_Append(&txt, ROW3_TEXT);
+    StrBuf_AppendInt(&txt, nGames, 0);
+    Label_SetText(page->gadgets[2], txt.str);
+
+    InfoPage_ResizeAfterGadgets(page);
+}
+
+
 // **************************************************************************** InfoPage_Resize
 
 // Resize the info page
@@ -124,15 +147,17 @@ static void InfoPage_Resize(Page* page){
 
     Size rowSize;
     rowSize.width = cRect.width - 2.0f * MARGIN_TO_EDGE;
-    rowSize.height = (cRect.height - 2.0f * MARGIN_TO_EDGE - MARGIN_BETWEEN_LABELS) * 0.5f;
+    rowSize.height = (cRect.height - 2.0f * MARGIN_TO_EDGE - 2.0f * MARGIN_BETWEEN_LABELS) / 3.0f;
 
     Rect innerRect = Geo_ApplyRectMargins(cRect, MARGIN_TO_EDGE);
 
     Point topLeft = RORIGIN(innerRect);
+    Point midLeft = Geo_RectPoint(innerRect, RP_MIDDLE_LEFT);
     Point bottomLeft = Geo_RectPoint(innerRect, RP_BOTTOM_LEFT);
 
     page->gadgets[0]->cRect = Geo_SetRectPS(topLeft,    rowSize, RP_TOP_LEFT);
-    page->gadgets[1]->cRect = Geo_SetRectPS(bottomLeft, rowSize, RP_BOTTOM_LEFT);
+    page->gadgets[1]->cRect = Geo_SetRectPS(midLeft,    rowSize, RP_MIDDLE_LEFT);
+    page->gadgets[2]->cRect = Geo_SetRectPS(bottomLeft, rowSize, RP_BOTTOM_LEFT);
 }
 
 
@@ -142,11 +167,13 @@ static void InfoPage_Resize(Page* page){
 static void InfoPage_ResizeAfterGadgets(Page* page){
     float fontSize1 = Label_GetFontSize(page->gadgets[0]);
     float fontSize2 = Label_GetFontSize(page->gadgets[1]);
+    float fontSize3 = Label_GetFontSize(page->gadgets[2]);
 
-    float fontSize = MIN(fontSize1, fontSize2);
+    float fontSize = MIN(MIN(fontSize1, fontSize2), fontSize3);
 
     Label_SetFontSize(page->gadgets[0], fontSize);
     Label_SetFontSize(page->gadgets[1], fontSize);
+    Label_SetFontSize(page->gadgets[2], fontSize);
 }
 
 
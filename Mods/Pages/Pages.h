@@ -38,6 +38,7 @@ RGrid*          GamePage_GetRGrid(const Page* page);
 SGraph*         GamePage_GetSGraph(const Page* page);
 Time            GamePage_GetCurrentTime(const Page* page);
 Grid            GamePage_GetGridSize(const Page* page);
+int             GamePage_GetSlot(const Page* page);
 
 // ---------------------------------------------------------------------------- Setup Page
 
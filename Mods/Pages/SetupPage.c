@@ -134,7 +134,7 @@ Page* SetupPage_Make(void){
         page->PrintData = SetupPage_PrintData;
     #endif
 
-    SetupPageData* data = Memory_Allocate(NULL, sizeof(SetupPageData), ZEROVAL_ALL);
+    SetupPageData* data = Page_AllocateData(sizeof(SetupPageData));
     page->data = data;
 
     data->type = SETUP_NEW_RECORD;
@@ -150,9 +150,9 @@ Page* SetupPage_Make(void){
 
 // Set the current time in the time table
 void SetupPage_SetCurrentTime(Page* page, Time current){
-    char* str = Time_ToString(NULL, current);
+    char str[TIME_STR_SIZE];
+    Time_Write(str, TIME_STR_SIZE, current);
     Table_SetText(page->gadgets[SU_TABLE_TIME], 1, 0, str);
-    str = Memory_Free(str);
 }
 
 
@@ -160,9 +160,9 @@ void SetupPage_SetCurrentTime(Page* page, Time current){
 
 // Set the record time in the time table
 void SetupPage_SetRecordTime(Page* page, Time record){
-    char* str = Time_ToString(NULL, record);
+    char str[TIME_STR_SIZE];
+    Time_Write(str, TIME_STR_SIZE, record);
     Table_SetText(page->gadgets[SU_TABLE_TIME], 1, 1, str);
-    str = Memory_Free(str);
 }
 
 
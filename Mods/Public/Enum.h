@@ -51,6 +51,12 @@
 #define WKEY_MINUS                          ARCH_DEF(WKEY_MINUS)
 #define WKEY_Z                              ARCH_DEF(WKEY_Z)
 #define WKEY_X                              ARCH_DEF(WKEY_X)
+#define WKEY_1                              ARCH_DEF(WKEY_1)
+#define WKEY_2                              ARCH_DEF(WKEY_2)
+#define WKEY_3                              ARCH_DEF(WKEY_3)
+#define WKEY_4                              ARCH_DEF(WKEY_4)
+#define WKEY_P                              ARCH_DEF(WKEY_P)
+#define WKEY_F                              ARCH_DEF(WKEY_F)
 
 extern const KeyboardKey WATCHED_KEYS[];
 extern const int WATCHED_KEYS_N;
@@ -155,7 +161,7 @@ typedef enum E_EventID{
     EVENT_SWITCH_CHANGED,  EVENT_UPDATE_SWITCH,     EVENT_NUMBOX_CHANGED,
     EVENT_GADGET_EXPANDED, EVENT_GADGET_COLLAPSED,  EVENT_SHOW_PAGE,
     EVENT_HIDE_PAGE,       EVENT_VICTORY,           EVENT_MAKE_NEW_GRID,
-    EVENT_GENERIC
+    EVENT_MINIMAP_CHANGED, EVENT_GENERIC
 }E_EventID;
 #define EVENTS_N                            (EVENT_GENERIC + 1)
 
@@ -204,7 +210,8 @@ typedef enum E_GadgetID{
     GDG_NUMBOX_COLS_BTN_UP, GDG_NUMBOX_COLS_BTN_DOWN, GDG_NUMBOX_ROWS,
     GDG_NUMBOX_ROWS_BTN_UP, GDG_NUMBOX_ROWS_BTN_DOWN, GDG_SETUP_LBL_NEW_RECORD,
     GDG_SETUP_TABLE_TIME,   GDG_SETUP_BTN_OK,         GDG_HELP_TABLE,           
-    GDG_INFO_LBL_TITLE,     GDG_INFO_LBL_AUTHOR, 
+    GDG_INFO_LBL_TITLE,     GDG_INFO_LBL_AUTHOR,      GDG_INFO_LBL_GAMES,
+    GDG_MINIMAP,
     #ifdef DEBUG_MODE
     GDG_GENERIC_1,          GDG_GENERIC_2,            GDG_GENERIC_3,
     GDG_GENERIC_4,          GDG_GENERIC_5,            GDG_GENERIC_6,
@@ -215,7 +222,7 @@ typedef enum E_GadgetID{
 #ifdef DEBUG_MODE
     #define GADGETS_N                       (GDG_GENERIC_12 - GDG_NONE + 1)
 #else
-    #define GADGETS_N                       (GDG_INFO_LBL_AUTHOR - GDG_NONE + 1)
+    #define GADGETS_N                       (GDG_MINIMAP - GDG_NONE + 1)
 #endif
 
 bool            GadgetID_IsValid(int id);
@@ -244,9 +251,9 @@ typedef enum E_GadgetType{
     GT_GENERIC, GT_BOARD,     GT_LABEL,
     GT_BUTTON,  GT_SCROLLBAR, GT_SWITCH,
     GT_NUMBOX,  GT_TIMER,     GT_ICON,
-    GT_TABLE,   GT_TOOLBAR
+    GT_TABLE,   GT_TOOLBAR,   GT_MINIMAP
 }E_GadgetType;
-#define GADGET_TYPES_N                      (GT_TOOLBAR + 1)
+#define GADGET_TYPES_N                      (GT_MINIMAP + 1)
 
 bool            GadgetType_IsValid(int type);
 #ifdef DEBUG_MODE
@@ -270,6 +277,45 @@ bool            SoundFX_IsValid(int sfx);
 #endif
 
 
+// **************************************************************************** E_ProfPhase
+
+// The phases of a frame, timed by the profiler
+typedef enum E_ProfPhase{
+    PROF_RESIZE,    PROF_MCOL,       PROF_FRECTS,
+    PROF_MUSIC,     PROF_EVENTS,     PROF_UPDATE,
+    PROF_DRAW_BG,   PROF_DRAW_PAGES, PROF_OVERLAY
+}E_ProfPhase;
+#define PROF_PHASES_N                       (PROF_OVERLAY + 1)
+
+bool            ProfPhase_IsValid(int phase);
+#ifdef DEBUG_MODE
+    const char* ProfPhase_ToString(int phase);
+#endif
+
+
+// **************************************************************************** E_CounterID
+
+// The runtime counters. The counters only grow, the gauges, from 
+// CNT_FIRST_GAUGE, hold a current value
+typedef enum E_CounterID{
+    CNT_FRAMES,           CNT_FRAMES_DRAWN,
+    CNT_ELECTRIFY_NODES,  CNT_REELECTRIFY_CALLS,
+    CNT_EVENTS_QUEUED,    CNT_EVENTS_DROPPED,
+    CNT_ROD_BATCHES,      CNT_ROD_QUADS,
+    CNT_ALLOCS,           CNT_ALLOC_BYTES,
+    CNT_FREES,            CNT_FONT_MEASURES,
+    CNT_LOD_DRAWS,
+    CNT_LIVE_BLOCKS,      CNT_QUEUE_LENGTH
+}E_CounterID;
+#define COUNTERS_N                          (CNT_QUEUE_LENGTH + 1)
+#define CNT_FIRST_GAUGE                     CNT_LIVE_BLOCKS
+
+bool            CounterID_IsValid(int id);
+#ifdef DEBUG_MODE
+    const char* CounterID_ToString(int id);
+#endif
+
+
 
 
 #endif // ENUM_GUARD
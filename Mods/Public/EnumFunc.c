@@ -63,7 +63,8 @@ bool KeyboardKey_IsValid(KeyboardKey key){
             "D",     "S",     "A",    "W",
             "Space", "Enter", "Tab",  "M",
             "T",     "R",     "Plus", "Minus",
-            "Z",     "X"
+            "Z",     "X",     "1",    "2",
+            "3",     "4",     "P",    "F"
         };
 
         for (int i = 0; i < WATCHED_KEYS_N; i++){
@@ -219,7 +220,7 @@ bool EventID_IsValid(int id){
             "Switch Changed",            "Update Switch",              "Numberbox Changed",
             "Gadget Expanded",           "Gadget Collapsed",           "Show Page",
             "Hide Page",                 "Victory",                    "Make New Grid",
-            "Generic Event"
+            "Minimap Changed",           "Generic Event"
         }; 
 
         CHECK_INVALID(EventID_IsValid(id), LONG_FORM)
@@ -274,7 +275,8 @@ bool GadgetID_IsValid(int id){
             "Up Button of Cols NumBox", "Down Button of Cols NumBox", "Rows Number Box",
             "Up Button of Rows NumBox", "Down Button of Rows NumBox", "New Record Label",
             "Time Table in Setup",      "OK Buttin in Setup",         "Help Table",                 
-            "Title Label in Info",      "Author Label in Info", 
+            "Title Label in Info",      "Author Label in Info",       "Games Label in Info",
+            "Minimap",
             "Generic Gadget 1",         "Generic Gadget 2",           "Generic Gadget 3",
             "Generic Gadget 4",         "Generic Gadget 5",           "Generic Gadget 6",
             "Generic Gadget 7",         "Generic Gadget 8",           "Generic Gadget 9",
@@ -325,7 +327,7 @@ bool GadgetType_IsValid(int type){
             "Generic",    "Board",     "Label",
             "Button",     "Scrollbar", "Switch",
             "Number Box", "Timer",     "Icon",
-            "Table",      "Toolbar"
+            "Table",      "Toolbar",   "Minimap"
         };
 
         CHECK_INVALID(GadgetType_IsValid(type), LONG_FORM)
@@ -356,3 +358,54 @@ bool SoundFX_IsValid(int sfx){
 #endif
 
 
+// **************************************************************************** E_ProfPhase
+
+// Return true if the value is a valid profiler phase
+bool ProfPhase_IsValid(int phase){
+    return IS_IN_RANGE(phase, 0, PROF_PHASES_N - 1);
+}
+
+#ifdef DEBUG_MODE
+    // Return a string describing the profiler phase
+    const char* ProfPhase_ToString(int phase){
+        static const char* names[] = {
+            "Resize",          "Magic Color Update", "Flying Rects Update",
+            "Music Update",    "Events",             "Pages Update",
+            "Background Draw", "Pages Draw",         "Overlay Draw"
+        };
+
+        CHECK_INVALID(ProfPhase_IsValid(phase), LONG_FORM)
+
+        return names[phase];
+    }
+#endif
+
+
+// **************************************************************************** E_CounterID
+
+// Return true if the value is a valid counter id
+bool CounterID_IsValid(int id){
+    return IS_IN_RANGE(id, 0, COUNTERS_N - 1);
+}
+
+#ifdef DEBUG_MODE
+    // Return a string describing the counter id
+    const char* CounterID_ToString(int id){
+        static const char* names[] = {
+            "Frames",           "Frames Drawn",
+            "Electrify Nodes",  "Reelectrify Calls",
+            "Events Queued",    "Events Dropped",
+            "Rod Batches",      "Rod Quads",
+            "Allocations",      "Allocated Bytes",
+            "Deallocations",    "Font Measures",
+            "LOD Draws",
+            "Live Blocks",      "Queue Length"
+        };
+
+        CHECK_INVALID(CounterID_IsValid(id), LONG_FORM)
+
+        return names[id];
+    }
+#endif
+
+
@@ -94,6 +94,29 @@
     }
 
 
+// ---------------------------------------------------------------------------- Trace Macros
+
+// **************************************************************************** TRACE_BEGIN
+
+// Record the begin of a slice in the trace, if tracing is on
+#define TRACE_BEGIN(gName, gArg) \
+    if (Glo_TraceIsOn) {Trace_Begin((gName), (gArg));}
+
+
+// **************************************************************************** TRACE_END
+
+// Record the end of the last begun slice in the trace, if tracing is on
+#define TRACE_END \
+    if (Glo_TraceIsOn) {Trace_End();}
+
+
+// **************************************************************************** TRACE_INSTANT
+
+// Record an instant in the trace, if tracing is on
+#define TRACE_INSTANT(gName, gArg) \
+    if (Glo_TraceIsOn) {Trace_Instant((gName), (gArg));}
+
+
 
 
 
@@ -34,7 +34,8 @@ const KeyboardKey WATCHED_KEYS[] = {
     WKEY_D,     WKEY_S,     WKEY_A,    WKEY_W,
     WKEY_SPACE, WKEY_ENTER, WKEY_TAB,  WKEY_M,
     WKEY_T,     WKEY_R,     WKEY_PLUS, WKEY_MINUS,
-    WKEY_Z,     WKEY_X
+    WKEY_Z,     WKEY_X,     WKEY_1,    WKEY_2,
+    WKEY_3,     WKEY_4,     WKEY_P,    WKEY_F
 };
 
 const int WATCHED_KEYS_N = sizeof(WATCHED_KEYS) / sizeof(WATCHED_KEYS[0]);
@@ -48,6 +49,9 @@ Size Glo_WinSize = {0};
 // Structure for holdeing the minimum record times
 Records* Glo_Records = 0;
 
+// Log of all the completed games
+History* Glo_History = 0;
+
 // The default magic color
 MagicColor* Glo_MCol = 0;
 
@@ -63,8 +67,5 @@ char* Glo_FilePath = 0;
 // Sound and music data
 SoundData* Glo_SoundData = 0;
 
-// Counters for memory tracking
-#ifdef MEMORY_TRACK
-    int Glo_AllocCount = 0;
-    int Glo_FreeCount = 0;
-#endif
+// True if the timeline is recorded in the trace file
+bool Glo_TraceIsOn = false;
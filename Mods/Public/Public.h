@@ -66,6 +66,12 @@
 #define INVALID                             (-1)
 #define IGNORE                              INVALID
 
+// For use in trace functions, for markers without argument
+#define TRACE_NO_ARG                        INVALID
+
+// The initial size of the scratch arena of the main thread, in bytes
+#define SCRATCH_SIZE                        (128 * 1024)
+
 // Strings
 #define STR_NULL                            "(Null)"
 #define STR_NONE                            "(None)"
@@ -98,6 +104,11 @@
 #define TIME_INVALID_STR                    ((char[]) {TIME_INVALID_CHAR, TIME_INVALID_CHAR, TIME_SEP_CHAR, \
                                                        TIME_INVALID_CHAR, TIME_INVALID_CHAR, '\0'})
 
+// The sizes of the buffers for the strings of a time, in the form HH:MM:SS, 
+// and of an int, with its sign, including the terminating character
+#define TIME_STR_SIZE                       9
+#define INT_STR_SIZE                        12
+
 // Rod Constants
 #define ROD_ROT_FRAMES_N                    ((FPS * 1) / 3)
 
@@ -108,6 +119,10 @@
 #define ROD_DEF_TEXTURE_SIZE                300.0f
 #define ROD_MIN_TEXTURE_SIZE                20.0f
 #define ROD_MAX_TEXTURE_SIZE                350.0f
+#define ROD_MIN_TILE_SIZE                   3.0f
+
+// Save Slot Constants
+#define SLOTS_N                             4
 
 // Font Constants
 #define FONT_DEF_SIZE                       300.0f
@@ -177,6 +192,10 @@
 #define IS_SELECTABLE                       true
 #define IS_NOT_SELECTABLE                   false
 
+// For use with the functions that load data from a cache file
+#define WITH_CACHE                          true
+#define WITHOUT_CACHE                       false
+
 // Indices of the toolbar gadgets
 #define TB_TIMER                            0
 #define TB_LBL_RODS_LEFT                    1
@@ -214,7 +233,7 @@
 #define TIME_INVALID                        TIME(INVALID, INVALID, INVALID)
 #define TIME_MAX                            TIME(TIME_MAX_HOURS, 59, 59)
 
-#define ROD_NULL                            ((Rod) {.legs = 0, .isElectrified = false, .frame = 0})
+#define ROD_NULL                            ((Rod) {.legs = 0, .isElectrified = false, .rotation = 0, .frame = 0})
 
 #define EVENT_NULL                          ((Event) {.id = EVENT_NONE, .source = GDG_NONE, .target = GDG_NONE, .data = {0}})
 
@@ -229,6 +248,9 @@ extern Size Glo_WinSize;
 // Structure for holdeing the minimum record times
 extern Records* Glo_Records;
 
+// Log of all the completed games
+extern History* Glo_History;
+
 // The default Magic Color
 extern MagicColor* Glo_MCol;
 
@@ -244,11 +266,8 @@ extern char* Glo_FilePath;
 // Sound and music assets
 extern SoundData* Glo_SoundData;
 
-// Counters for memory tracking
-#ifdef MEMORY_TRACK
-    extern int Glo_AllocCount;
-    extern int Glo_FreeCount;
-#endif
+// True if the timeline is recorded in the trace file
+extern bool Glo_TraceIsOn;
 
 
 
@@ -12,8 +12,8 @@
 
 // ============================================================================ INFO
 /*
-    Math, geometry, grid and time structures, as well as logic, graphics as 
-    well as storage structures.
+    Memory, math, geometry, grid, string and time structures, as well as 
+    logic, graphics as well as storage structures.
 */
 
 
@@ -24,6 +24,22 @@
 
 // ============================================================================ STRUCTURES
 
+// ---------------------------------------------------------------------------- Memory Structures
+
+// **************************************************************************** Arena
+
+// A memory region that hands out blocks by moving an offset, all given back 
+// at once
+typedef struct Arena Arena;
+
+
+// **************************************************************************** Pool
+
+// An allocator of objects of a fixed size, that keeps the given back objects 
+// for reuse
+typedef struct Pool Pool;
+
+
 // ---------------------------------------------------------------------------- Math Structures
 
 // **************************************************************************** Bytes
@@ -87,6 +103,22 @@ typedef struct Grid{
 }Grid;
 
 
+// ---------------------------------------------------------------------------- String Structures
+
+// **************************************************************************** StrBuf
+
+// A string builder over a buffer of fixed capacity, in the storage of the 
+// caller or in the scratch arena. The capacity counts the terminating 
+// character. The string is always terminated; what does not fit is cut and 
+// the builder is marked as truncated
+typedef struct StrBuf{
+    char* str;
+    int capacity;
+    int length;
+    bool isTruncated;
+}StrBuf;
+
+
 // ---------------------------------------------------------------------------- Time Structures
 
 // **************************************************************************** Time
@@ -112,10 +144,12 @@ typedef union Time{
 // **************************************************************************** Rod
 
 // The rod is the elementary unit of the game. It consists of 1-4 legs, with 
-// which it can connect to adjacent rods. It can be electrified or not
+// which it can connect to adjacent rods. It can be electrified or not. The 
+// rotation is the number of 90° clockwise turns (mod 4) since the rod was set
 typedef struct Rod{
     unsigned char legs:4;
     bool isElectrified:1;
+    unsigned char rotation:2;
     unsigned char frame;
 }Rod;
 
@@ -133,6 +167,34 @@ typedef struct RGrid RGrid;
 typedef struct Records Records;
 
 
+// **************************************************************************** History
+
+// Log of all the completed games, with an index of statistics per grid size
+typedef struct History History;
+
+
+// **************************************************************************** HistoryEntry
+
+// A completed game. The date is in seconds since the epoch
+typedef struct HistoryEntry{
+    int nCols;
+    int nRows;
+    Time time;
+    int clicks;
+    long long date;
+}HistoryEntry;
+
+
+// **************************************************************************** HistoryStats
+
+// Statistics of the completed games of a single grid size
+typedef struct HistoryStats{
+    int count;
+    Time best;
+    Time median;
+}HistoryStats;
+
+
 
 
 
@@ -170,13 +232,29 @@ typedef struct SGraph SGraph;
 typedef struct FRects FRects;
 
 
+// **************************************************************************** GlyphQuad
+
+// The rectangle of a glyph of the default custom font in the font atlas and 
+// the rectangle that it is drawn in
+typedef struct GlyphQuad{
+    Rect src;
+    Rect dst;
+}GlyphQuad;
+
+
 // **************************************************************************** Textures
 
-// Structure for storing the icon, rod and selection box textures
+// Structure for storing the icon and selection box textures and the shaders
+// of the rods. The rods are drawn by the rod shader, from their signed 
+// distance fields. The rod atlas is loaded only if the rod shader fails. The 
+// rod atlas and the selection box are single channel textures, drawn with the
+// coverage shader
 typedef struct Textures{
     Texture2D icons[ICONS_N];
-    Texture2D rods[0x10];
+    Texture2D rodAtlas;
     Texture2D selBox;
+    Shader rodShader;
+    Shader coverageShader;
 }Textures;
 
 
@@ -186,6 +264,13 @@ typedef struct Textures{
 typedef struct RodModel RodModel;
 
 
+// **************************************************************************** RCache
+
+// Render texture of the visible part of the rod grid, that is redrawn only
+// where the rods have changed
+typedef struct RCache RCache;
+
+
 // **************************************************************************** TimDisp
 
 // Precalculated values for drawing the time in the form [HH:]MM:SS
@@ -208,9 +293,43 @@ typedef struct PData{
     SGraph* sg;
     Time time;
     bool sound;
+    int slot;
 }PData;
 
 
+// **************************************************************************** SlotInfo
+
+// Summary of a save slot, from the slot file header and the cached thumbnail. 
+// The thumbnail has no data if it is not cached
+typedef struct SlotInfo{
+    bool exists;
+    int nCols;
+    int nRows;
+    int nRodsLeft;
+    Time time;
+    long long date;
+    Image thumb;
+}SlotInfo;
+
+
+// **************************************************************************** Pack
+
+// A memory mapped puzzle pack file, with an index of encoded rod grids
+typedef struct Pack Pack;
+
+
+// **************************************************************************** PackEntry
+
+// The index entry of a puzzle in a puzzle pack. Par is the minimum number of 
+// rotations that solve the puzzle. Difficulty is 0-100
+typedef struct PackEntry{
+    int nCols;
+    int nRows;
+    int par;
+    int difficulty;
+}PackEntry;
+
+
 // ---------------------------------------------------------------------------- Sound Structures
 
 // **************************************************************************** SoundData
@@ -63,6 +63,11 @@ typedef struct Event{
             int nRows;
         }newGrid;
 
+        struct{
+            float xRatio;
+            float yRatio;
+        }minimap;
+
         struct{
             E_PageID id;
             bool withAnim;
@@ -88,7 +93,9 @@ typedef struct EventQueue EventQueue;
 
 // **************************************************************************** Gadget
 
-// A gadget is the elementary unit of the GUI
+// A gadget is the elementary unit of the GUI. IsAnimating returns true while 
+// the gadget changes its appearance without any event, so the frame has to be 
+// drawn
 typedef struct Gadget{
     E_GadgetID id;
     E_GadgetType type;
@@ -108,6 +115,7 @@ typedef struct Gadget{
     void     (*ResizeAfterSubgadgets)(struct Gadget* gadget);
     void     (*ReactToEvent)(struct Gadget* gadget, Event event, EventQueue* queue);
     void     (*Update)(struct Gadget* gadget, EventQueue* queue);
+    bool     (*IsAnimating)(const struct Gadget* gadget);
     Vector2  (*ChangeShift)(const struct Gadget* gadget, Vector2 shift);
     void     (*Draw)(const struct Gadget* gadget, Vector2 shift);
     #ifdef DEBUG_MODE
@@ -0,0 +1,748 @@
+// ============================================================================
+// RODS
+// Codec
+// by Andreas Socratous
+// Jan 2023
+// ============================================================================
+
+
+// ============================================================================ INFO
+/*
+    Functions for encoding the rod grid to a compact block of bytes and
+    decoding it back.
+
+    A solved rod grid is a spanning tree, rooted at the source, and a shuffled
+    one is the same tree with every rod rotated. The rod grid is encoded with
+    each of the available methods and the smallest result is kept:
+
+    SEEDS:  The generation and shuffle seeds, followed by the rotation of 
+            every rod since the shuffle, under an adaptive range coder. The 
+            rotations are omitted if they are all 0. Available while the rod 
+            grid comes from its seeds.
+    TREE:   The tree edges (right and down leg of every solved rod), followed 
+            by the rotation of every rod, both under an adaptive range coder. 
+            Available when the solved legs form a spanning tree.
+    LEGS:   The legs of every rod, under an adaptive range coder. Always
+            available.
+
+    ENCODED DATA:
+        Method                  1 x Byte                  CODEC_METHOD_*
+        Num of Columns          1 x Byte
+        Num of Rows             1 x Byte
+        Source Column           1 x Byte
+        Source Row              1 x Byte
+        Payload:
+            SEEDS:  Generation Seed (4 Bytes), Shuffle Seed (4 Bytes), 
+                    Range coded rotations (optional)
+            TREE:   Range coded tree edges and rotations
+            LEGS:   Range coded legs
+*/
+
+
+// ============================================================================ DEPENDENCIES
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <raylib.h>
+
+#include "../Public/Public.h"
+#include "../Fund/Fund.h"
+#include "../Logic/Logic.h"
+#include "Store.h"
+
+
+// ============================================================================ PRIVATE CONSTANTS
+
+#define CODEC_METHOD_SEEDS                  1
+#define CODEC_METHOD_TREE                   2
+#define CODEC_METHOD_LEGS                   3
+
+#define CODEC_HEADER_SIZE                   5
+#define CODEC_SEEDS_SIZE                    (CODEC_HEADER_SIZE + 8)
+
+#define CODEC_MAX_SYMBOLS                   16
+#define CODEC_FREQ_INC                      24
+#define CODEC_FREQ_MAX                      (1 << 13)
+
+#define CODEC_EDGE_CONTEXTS_N               64
+#define CODEC_ROT_CONTEXTS_N                16
+#define CODEC_LEGS_CONTEXTS_N               4
+
+#define RCODER_TOP                          (1u << 24)
+#define RCODER_INIT_BYTES_N                 5
+
+
+// ============================================================================ PRIVATE STRUCTURES
+
+// **************************************************************************** CModel
+
+// Adaptive frequency model for a small alphabet of symbols
+typedef struct CModel{
+    int freq[CODEC_MAX_SYMBOLS];
+    int total;
+    int nSymbols;
+}CModel;
+
+
+// **************************************************************************** RCoder
+
+// Range coder, writing to or reading from a block of bytes
+typedef struct RCoder{
+    unsigned char* data;
+    int size;
+    int pos;
+    unsigned long long low;
+    unsigned int range;
+    unsigned int code;
+    unsigned char cache;
+    int cacheSize;
+}RCoder;
+
+
+// ============================================================================ PRIVATE FUNC DECL
+
+static unsigned char*   Codec_EncodeSeeds(const RGrid* rGrid, int* size);
+static unsigned char*   Codec_EncodeTree(const RGrid* rGrid, const unsigned char* solved, int* size);
+static unsigned char*   Codec_EncodeLegs(const RGrid* rGrid, int* size);
+static RGrid*           Codec_DecodeSeeds(const unsigned char* data, int size, Grid gridSize, 
+                                          GNode source);
+static RGrid*           Codec_DecodeTree(RCoder* rc, Grid size, GNode source);
+static RGrid*           Codec_DecodeLegs(RCoder* rc, Grid size, GNode source);
+static RGrid*           Codec_MakeFromSeeds(Grid size, unsigned int genSeed, unsigned int shuffleSeed);
+static bool             Codec_IsSpanningTree(const unsigned char* legs, Grid size, GNode source);
+static int              Codec_EdgeContext(const unsigned char* legs, Grid size, int x, int y);
+static void             Codec_WriteHeader(RCoder* rc, int method, Grid size, GNode source);
+static int              Codec_CanonicalRotation(int fromLegs, int toLegs);
+
+static void             CModel_Init(CModel* model, int nSymbols);
+static void             CModel_Update(CModel* model, int symbol);
+
+static void             RCoder_InitEncoder(RCoder* rc, int capacity);
+static void             RCoder_InitDecoder(RCoder* rc, const unsigned char* data, int size, int pos);
+static void             RCoder_PutByte(RCoder* rc, unsigned char byte);
+static unsigned char    RCoder_GetByte(RCoder* rc);
+static void             RCoder_ShiftLow(RCoder* rc);
+static void             RCoder_Encode(RCoder* rc, CModel* model, int symbol);
+static int              RCoder_Decode(RCoder* rc, CModel* model);
+static void             RCoder_Flush(RCoder* rc);
+
+
+
+
+
+
+// ============================================================================ FUNC DEF
+
+// **************************************************************************** Codec_EncodeRGrid
+
+// Encode the rod grid with the method that gives the smallest size. Return 
+// the encoded data and save its size at the given pointer
+unsigned char* Codec_EncodeRGrid(const RGrid* rGrid, int* size){
+    Grid gridSize = RGrid_GetSize(rGrid);
+    int n = Grid_N(gridSize);
+
+    // The legs of the solved rod grid, by undoing the rotation of every rod
+    unsigned char* solved = Memory_Allocate(NULL, n, ZEROVAL_NONE);
+    for (int y = 0; y < gridSize.nRows; y++){
+        for (int x = 0; x < gridSize.nCols; x++){
+            const Rod* rod = RGrid_GetRod_Fast(rGrid, GNODE(x, y));
+            solved[y * gridSize.nCols + x] = Direction_RotateLegs(rod->legs, -rod->rotation);
+        }
+    }
+
+    // Encode with every available method and keep the smallest
+    int resSize = 0;
+    unsigned char* res = Codec_EncodeLegs(rGrid, &resSize);
+
+    for (int method = CODEC_METHOD_SEEDS; method <= CODEC_METHOD_TREE; method++){
+        int tempSize = 0;
+        unsigned char* temp = NULL;
+
+        if (method == CODEC_METHOD_SEEDS && RGrid_GetSeeds(rGrid, NULL, NULL) == 2){
+            temp = Codec_EncodeSeeds(rGrid, &tempSize);
+        }else if (method == CODEC_METHOD_TREE && 
+                  Codec_IsSpanningTree(solved, gridSize, RGrid_GetSource(rGrid))){
+            temp = Codec_EncodeTree(rGrid, solved, &tempSize);
+        }
+
+        if (temp != NULL && tempSize < resSize){
+            res = Memory_Free(res);
+            res = temp;
+            resSize = tempSize;
+        }else{
+            temp = Memory_Free(temp);
+        }
+    }
+
+    solved = Memory_Free(solved);
+
+    if (size != NULL) {*size = resSize;}
+
+    return res;
+}
+
+
+// **************************************************************************** Codec_DecodeRGrid
+
+// Decode the rod grid from the encoded data. Return NULL if the data is invalid
+RGrid* Codec_DecodeRGrid(const unsigned char* data, int size){
+    if (data == NULL || size < CODEC_HEADER_SIZE) {return NULL;}
+
+    int method = data[0];
+    Grid gridSize = GRID0(data[1], data[2]);
+    GNode source = GNODE(data[3], data[4]);
+
+    if (!IS_IN_RANGE(gridSize.nCols, RGRID_MIN_SIZE, RGRID_MAX_SIZE) ||
+        !IS_IN_RANGE(gridSize.nRows, RGRID_MIN_SIZE, RGRID_MAX_SIZE) ||
+        !Grid_NodeIsInGrid(source, gridSize)){
+        return NULL;
+    }
+
+    RCoder rc;
+
+    switch (method){
+        case CODEC_METHOD_SEEDS:{
+            return Codec_DecodeSeeds(data, size, gridSize, source);
+        }
+
+        case CODEC_METHOD_TREE:{
+            RCoder_InitDecoder(&rc, data, size, CODEC_HEADER_SIZE);
+            return Codec_DecodeTree(&rc, gridSize, source);
+        }
+
+        case CODEC_METHOD_LEGS:{
+            RCoder_InitDecoder(&rc, data, size, CODEC_HEADER_SIZE);
+            return Codec_DecodeLegs(&rc, gridSize, source);
+        }
+
+        default: {break;}
+    }
+
+    return NULL;
+}
+
+
+
+
+
+
+// ============================================================================ PRIVATE FUNC DEF
+
+// **************************************************************************** Codec_EncodeSeeds
+
+// Encode the rod grid as its generation and shuffle seeds, followed by the 
+// rotations since the shuffle, if any
+static unsigned char* Codec_EncodeSeeds(const RGrid* rGrid, int* size){
+    Grid gridSize = RGrid_GetSize(rGrid);
+
+    unsigned int seeds[2] = {0};
+    RGrid_GetSeeds(rGrid, &seeds[0], &seeds[1]);
+
+    RCoder rc;
+    RCoder_InitEncoder(&rc, CODEC_SEEDS_SIZE);
+    Codec_WriteHeader(&rc, CODEC_METHOD_SEEDS, gridSize, RGrid_GetSource(rGrid));
+
+    for (int i = 0; i < 8; i++){
+        RCoder_PutByte(&rc, (seeds[i / 4] >> ((i % 4) * 8)) & 0xFF);
+    }
+
+    // Rotations since the shuffle, in the context of the shuffled legs
+    RGrid* ref = Codec_MakeFromSeeds(gridSize, seeds[0], seeds[1]);
+
+    CModel models[CODEC_ROT_CONTEXTS_N];
+    for (int i = 0; i < CODEC_ROT_CONTEXTS_N; i++) {CModel_Init(&models[i], 4);}
+
+    bool isModified = false;
+    for (int y = 0; y < gridSize.nRows; y++){
+        for (int x = 0; x < gridSize.nCols; x++){
+            int refLegs = RGrid_GetRod_Fast(ref, GNODE(x, y))->legs;
+            int legs = RGrid_GetRod_Fast(rGrid, GNODE(x, y))->legs;
+            int rotation = Codec_CanonicalRotation(refLegs, legs);
+            RCoder_Encode(&rc, &models[refLegs], rotation);
+            isModified = isModified || (rotation != 0);
+        }
+    }
+
+    RCoder_Flush(&rc);
+
+    ref = RGrid_Free(ref);
+
+    *size = isModified ? rc.pos : CODEC_SEEDS_SIZE;
+    return rc.data;
+}
+
+
+// **************************************************************************** Codec_EncodeTree
+
+// Encode the rod grid as the edges of the spanning tree, given by the solved 
+// legs, and the rotation of every rod
+static unsigned char* Codec_EncodeTree(const RGrid* rGrid, const unsigned char* solved, int* size){
+    Grid gridSize = RGrid_GetSize(rGrid);
+
+    CModel edgeModels[CODEC_EDGE_CONTEXTS_N];
+    CModel rotModels[CODEC_ROT_CONTEXTS_N];
+    for (int i = 0; i < CODEC_EDGE_CONTEXTS_N; i++) {CModel_Init(&edgeModels[i], 4);}
+    for (int i = 0; i < CODEC_ROT_CONTEXTS_N; i++)  {CModel_Init(&rotModels[i], 4);}
+
+    RCoder rc;
+    RCoder_InitEncoder(&rc, CODEC_HEADER_SIZE + Grid_N(gridSize) / 2);
+    Codec_WriteHeader(&rc, CODEC_METHOD_TREE, gridSize, RGrid_GetSource(rGrid));
+
+    // Tree edges. The left and up legs are already known from the neighbours, 
+    // so only the right and down legs are encoded
+    for (int y = 0; y < gridSize.nRows; y++){
+        for (int x = 0; x < gridSize.nCols; x++){
+            int legs = solved[y * gridSize.nCols + x];
+            int context = Codec_EdgeContext(solved, gridSize, x, y);
+            RCoder_Encode(&rc, &edgeModels[context], legs & (LEGDIR_RIGHT | LEGDIR_DOWN));
+        }
+    }
+
+    // Rotations, in the context of the solved legs
+    for (int y = 0; y < gridSize.nRows; y++){
+        for (int x = 0; x < gridSize.nCols; x++){
+            int legs = solved[y * gridSize.nCols + x];
+            int rotation = Codec_CanonicalRotation(legs, RGrid_GetRod_Fast(rGrid, GNODE(x, y))->legs);
+            RCoder_Encode(&rc, &rotModels[legs], rotation);
+        }
+    }
+
+    RCoder_Flush(&rc);
+
+    *size = rc.pos;
+    return rc.data;
+}
+
+
+// **************************************************************************** Codec_EncodeLegs
+
+// Encode the rod grid as the legs of every rod
+static unsigned char* Codec_EncodeLegs(const RGrid* rGrid, int* size){
+    Grid gridSize = RGrid_GetSize(rGrid);
+
+    CModel models[CODEC_LEGS_CONTEXTS_N];
+    for (int i = 0; i < CODEC_LEGS_CONTEXTS_N; i++) {CModel_Init(&models[i], 16);}
+
+    RCoder rc;
+    RCoder_InitEncoder(&rc, CODEC_HEADER_SIZE + Grid_N(gridSize) / 2);
+    Codec_WriteHeader(&rc, CODEC_METHOD_LEGS, gridSize, RGrid_GetSource(rGrid));
+
+    // Legs, in the context of the adjacent legs of the left and upper rods
+    for (int y = 0; y < gridSize.nRows; y++){
+        for (int x = 0; x < gridSize.nCols; x++){
+            int left = (x > 0) ? RGrid_GetRod_Fast(rGrid, GNODE(x - 1, y))->legs : 0;
+            int up   = (y > 0) ? RGrid_GetRod_Fast(rGrid, GNODE(x, y - 1))->legs : 0;
+            int context = ((left & LEGDIR_RIGHT) ? 1 : 0) + ((up & LEGDIR_DOWN) ? 2 : 0);
+            RCoder_Encode(&rc, &models[context], RGrid_GetRod_Fast(rGrid, GNODE(x, y))->legs);
+        }
+    }
+
+    RCoder_Flush(&rc);
+
+    *size = rc.pos;
+    return rc.data;
+}
+
+
+// **************************************************************************** Codec_DecodeSeeds
+
+// Decode a rod grid, encoded with the seeds method. Return NULL if invalid
+static RGrid* Codec_DecodeSeeds(const unsigned char* data, int size, Grid gridSize, 
+                                GNode source){
+    if (size < CODEC_SEEDS_SIZE) {return NULL;}
+
+    unsigned int seeds[2] = {0};
+    for (int i = 0; i < 8; i++){
+        seeds[i / 4] |= ((unsigned int) data[CODEC_HEADER_SIZE + i] << ((i % 4) * 8));
+    }
+
+    RGrid* rGrid = Codec_MakeFromSeeds(gridSize, seeds[0], seeds[1]);
+    if (!Grid_NodesAreEqual(RGrid_GetSource(rGrid), source)){
+        return RGrid_Free(rGrid);
+    }
+
+    // Rotations since the shuffle, if any
+    if (size > CODEC_SEEDS_SIZE){
+        CModel models[CODEC_ROT_CONTEXTS_N];
+        for (int i = 0; i < CODEC_ROT_CONTEXTS_N; i++) {CModel_Init(&models[i], 4);}
+
+        RCoder rc;
+        RCoder_InitDecoder(&rc, data, size, CODEC_SEEDS_SIZE);
+
+        for (int y = 0; y < gridSize.nRows; y++){
+            for (int x = 0; x < gridSize.nCols; x++){
+                Rod* rod = RGrid_GetRod_Fast(rGrid, GNODE(x, y));
+                Rod_Rotate(rod, RCoder_Decode(&rc, &models[rod->legs]), WITHOUT_ANIM);
+            }
+        }
+
+        RGrid_Reelectrify(rGrid);
+    }
+
+    return rGrid;
+}
+
+
+// **************************************************************************** Codec_DecodeTree
+
+// Decode a rod grid, encoded with the tree method. Return NULL if invalid
+static RGrid* Codec_DecodeTree(RCoder* rc, Grid size, GNode source){
+    CModel edgeModels[CODEC_EDGE_CONTEXTS_N];
+    CModel rotModels[CODEC_ROT_CONTEXTS_N];
+    for (int i = 0; i < CODEC_EDGE_CONTEXTS_N; i++) {CModel_Init(&edgeModels[i], 4);}
+    for (int i = 0; i < CODEC_ROT_CONTEXTS_N; i++)  {CModel_Init(&rotModels[i], 4);}
+
+    unsigned char* solved = Memory_Allocate(NULL, Grid_N(size), ZEROVAL_ALL);
+
+    // Tree edges. Complete the left and up legs from the neighbours
+    for (int y = 0; y < size.nRows; y++){
+        for (int x = 0; x < size.nCols; x++){
+            int i = y * size.nCols + x;
+            if (x > 0 && (solved[i - 1] & LEGDIR_RIGHT))         {solved[i] |= LEGDIR_LEFT;}
+            if (y > 0 && (solved[i - size.nCols] & LEGDIR_DOWN)) {solved[i] |= LEGDIR_UP;}
+
+            int context = Codec_EdgeContext(solved, size, x, y);
+            solved[i] |= RCoder_Decode(rc, &edgeModels[context]);
+        }
+    }
+
+    RGrid* rGrid = NULL;
+
+    if (Codec_IsSpanningTree(solved, size, source)){
+        rGrid = RGrid_MakeEmpty(size.nCols, size.nRows);
+        RGrid_SetSource(rGrid, source);
+
+        // Rotations
+        for (int y = 0; y < size.nRows; y++){
+            for (int x = 0; x < size.nCols; x++){
+                int legs = solved[y * size.nCols + x];
+                GNode node = GNODE(x, y);
+                RGrid_SetRod(rGrid, node, legs);
+                Rod_Rotate(RGrid_GetRod_Fast(rGrid, node), RCoder_Decode(rc, &rotModels[legs]), 
+                           WITHOUT_ANIM);
+            }
+        }
+
+        RGrid_Electrify(rGrid, GNODE_INVALID);
+    }
+
+    solved = Memory_Free(solved);
+
+    return rGrid;
+}
+
+
+// **************************************************************************** Codec_DecodeLegs
+
+// Decode a rod grid, encoded with the legs method
+static RGrid* Codec_DecodeLegs(RCoder* rc, Grid size, GNode source){
+    CModel models[CODEC_LEGS_CONTEXTS_N];
+    for (int i = 0; i < CODEC_LEGS_CONTEXTS_N; i++) {CModel_Init(&models[i], 16);}
+
+    RGrid* rGrid = RGrid_MakeEmpty(size.nCols, size.nRows);
+    RGrid_SetSource(rGrid, source);
+
+    for (int y = 0; y < size.nRows; y++){
+        for (int x = 0; x < size.nCols; x++){
+            int left = (x > 0) ? RGrid_GetRod_Fast(rGrid, GNODE(x - 1, y))->legs : 0;
+            int up   = (y > 0) ? RGrid_GetRod_Fast(rGrid, GNODE(x, y - 1))->legs : 0;
+            int context = ((left & LEGDIR_RIGHT) ? 1 : 0) + ((up & LEGDIR_DOWN) ? 2 : 0);
+            RGrid_SetRod(rGrid, GNODE(x, y), RCoder_Decode(rc, &models[context]));
+        }
+    }
+
+    RGrid_Electrify(rGrid, GNODE_INVALID);
+
+    return rGrid;
+}
+
+
+// **************************************************************************** Codec_MakeFromSeeds
+
+// Make a rod grid of the given size, generated and shuffled from the seeds
+static RGrid* Codec_MakeFromSeeds(Grid size, unsigned int genSeed, unsigned int shuffleSeed){
+    RGrid* rGrid = RGrid_MakeEmpty(size.nCols, size.nRows);
+    RGrid_CreateFromSeed(rGrid, genSeed);
+    RGrid_ShuffleFromSeed(rGrid, shuffleSeed);
+
+    return rGrid;
+}
+
+
+// **************************************************************************** Codec_IsSpanningTree
+
+// Return true if the legs form a spanning tree of the grid, rooted at the
+// source
+static bool Codec_IsSpanningTree(const unsigned char* legs, Grid size, GNode source){
+    int n = Grid_N(size);
+
+    // Every leg must be matched by the adjacent rod. A tree has n - 1 edges
+    int nLegs = 0;
+    for (int y = 0; y < size.nRows; y++){
+        for (int x = 0; x < size.nCols; x++){
+            int nodeLegs = legs[y * size.nCols + x];
+            for (int dir = DIR_RIGHT; dir <= DIR_UP; dir++){
+                if (!(nodeLegs & Direction_ToLegDir(dir))) {continue;}
+
+                GNode next = Grid_MoveNodeToDir(GNODE(x, y), dir, 1);
+                if (!Grid_NodeIsInGrid(next, size)) {return false;}
+
+                int nextLegs = legs[next.y * size.nCols + next.x];
+                if (!(nextLegs & Direction_ToLegDir(Direction_Opposite(dir)))) {return false;}
+
+                nLegs++;
+            }
+        }
+    }
+
+    if (nLegs != 2 * (n - 1)) {return false;}
+
+    // With n - 1 edges, the legs form a tree if all the rods are reached
+    GNode* list = Memory_Allocate(NULL, sizeof(GNode) * n, ZEROVAL_NONE);
+    unsigned char* isVisited = Memory_Allocate(NULL, n, ZEROVAL_ALL);
+
+    list[0] = source;
+    isVisited[source.y * size.nCols + source.x] = true;
+    int nList = 1;
+
+    for (int i = 0; i < nList; i++){
+        GNode current = list[i];
+        int currentLegs = legs[current.y * size.nCols + current.x];
+
+        for (int dir = DIR_RIGHT; dir <= DIR_UP; dir++){
+            if (!(currentLegs & Direction_ToLegDir(dir))) {continue;}
+
+            GNode next = Grid_MoveNodeToDir(current, dir, 1);
+            int nextInd = next.y * size.nCols + next.x;
+            if (isVisited[nextInd]) {continue;}
+
+            isVisited[nextInd] = true;
+            list[nList] = next;
+            nList++;
+        }
+    }
+
+    list = Memory_Free(list);
+    isVisited = Memory_Free(isVisited);
+
+    return nList == n;
+}
+
+
+// **************************************************************************** Codec_EdgeContext
+
+// The context for the right and down legs of the rod at (x, y): its left and 
+// up legs, the down leg of the left rod, the right leg of the upper rod and 
+// whether the rod is at the right or bottom edge
+static int Codec_EdgeContext(const unsigned char* legs, Grid size, int x, int y){
+    int i = y * size.nCols + x;
+    int context = (legs[i] >> 2) & 0x3;
+
+    if (x > 0 && (legs[i - 1] & LEGDIR_DOWN))          {context |= 0x04;}
+    if (y > 0 && (legs[i - size.nCols] & LEGDIR_RIGHT)) {context |= 0x08;}
+    if (x == size.nCols - 1)                            {context |= 0x10;}
+    if (y == size.nRows - 1)                            {context |= 0x20;}
+
+    return context;
+}
+
+
+// **************************************************************************** Codec_WriteHeader
+
+// Write the method, the size and the source at the start of the encoded data
+static void Codec_WriteHeader(RCoder* rc, int method, Grid size, GNode source){
+    RCoder_PutByte(rc, method);
+    RCoder_PutByte(rc, size.nCols);
+    RCoder_PutByte(rc, size.nRows);
+    RCoder_PutByte(rc, source.x);
+    RCoder_PutByte(rc, source.y);
+}
+
+
+// **************************************************************************** Codec_CanonicalRotation
+
+// The smallest number of 90° clockwise rotations, that turn the first legs to 
+// the second. Symmetric rods have fewer distinct rotations
+static int Codec_CanonicalRotation(int fromLegs, int toLegs){
+    for (int r = 0; r < 4; r++){
+        if (Direction_RotateLegs(fromLegs, r) == toLegs){
+            return r;
+        }
+    }
+
+    return 0;
+}
+
+
+
+
+
+
+// ---------------------------------------------------------------------------- Adaptive Model Functions
+
+// **************************************************************************** CModel_Init
+
+// Initialize the model with equal frequencies for all symbols
+static void CModel_Init(CModel* model, int nSymbols){
+    model->nSymbols = PUT_IN_RANGE(nSymbols, 1, CODEC_MAX_SYMBOLS);
+    for (int i = 0; i < model->nSymbols; i++){
+        model->freq[i] = 1;
+    }
+    model->total = model->nSymbols;
+}
+
+
+// **************************************************************************** CModel_Update
+
+// Increase the frequency of the symbol. Halve all frequencies when the total
+// reaches the limit
+static void CModel_Update(CModel* model, int symbol){
+    model->freq[symbol] += CODEC_FREQ_INC;
+    model->total += CODEC_FREQ_INC;
+
+    if (model->total > CODEC_FREQ_MAX){
+        model->total = 0;
+        for (int i = 0; i < model->nSymbols; i++){
+            model->freq[i] = (model->freq[i] + 1) / 2;
+            model->total += model->freq[i];
+        }
+    }
+}
+
+
+
+
+
+
+// ---------------------------------------------------------------------------- Range Coder Functions
+
+// **************************************************************************** RCoder_InitEncoder
+
+// Initialize the range coder for encoding, with the given initial capacity
+static void RCoder_InitEncoder(RCoder* rc, int capacity){
+    *rc = (RCoder) {0};
+    rc->size = MAX(capacity, 16);
+    rc->data = Memory_Allocate(NULL, rc->size, ZEROVAL_NONE);
+    rc->range = 0xFFFFFFFFu;
+    rc->cacheSize = 1;
+}
+
+
+// **************************************************************************** RCoder_InitDecoder
+
+// Initialize the range coder for decoding the data, starting at pos
+static void RCoder_InitDecoder(RCoder* rc, const unsigned char* data, int size, int pos){
+    *rc = (RCoder) {0};
+    rc->data = (unsigned char*) data;
+    rc->size = size;
+    rc->pos = pos;
+    rc->range = 0xFFFFFFFFu;
+
+    for (int i = 0; i < RCODER_INIT_BYTES_N; i++){
+        rc->code = (rc->code << 8) | RCoder_GetByte(rc);
+    }
+}
+
+
+// **************************************************************************** RCoder_PutByte
+
+// Append the byte to the encoded data, growing it if needed
+static void RCoder_PutByte(RCoder* rc, unsigned char byte){
+    if (rc->pos >= rc->size){
+        rc->size *= 2;
+        rc->data = Memory_Allocate(rc->data, rc->size, ZEROVAL_NONE);
+    }
+
+    rc->data[rc->pos] = byte;
+    rc->pos++;
+}
+
+
+// **************************************************************************** RCoder_GetByte
+
+// Read the next byte of the encoded data. Past the end, return 0
+static unsigned char RCoder_GetByte(RCoder* rc){
+    if (rc->pos >= rc->size) {return 0;}
+
+    return rc->data[rc->pos++];
+}
+
+
+// **************************************************************************** RCoder_ShiftLow
+
+// Output the top byte of low, propagating the carry to the pending bytes
+static void RCoder_ShiftLow(RCoder* rc){
+    if ((unsigned int) rc->low < 0xFF000000u || (rc->low >> 32) != 0){
+        unsigned char carry = (unsigned char) (rc->low >> 32);
+        unsigned char temp = rc->cache;
+        do{
+            RCoder_PutByte(rc, temp + carry);
+            temp = 0xFF;
+        }while (--rc->cacheSize != 0);
+        rc->cache = (unsigned char) (rc->low >> 24);
+    }
+
+    rc->cacheSize++;
+    rc->low = (rc->low & 0x00FFFFFFu) << 8;
+}
+
+
+// **************************************************************************** RCoder_Encode
+
+// Encode the symbol with the model and update the model
+static void RCoder_Encode(RCoder* rc, CModel* model, int symbol){
+    int cumFreq = 0;
+    for (int i = 0; i < symbol; i++){
+        cumFreq += model->freq[i];
+    }
+
+    unsigned int r = rc->range / model->total;
+    rc->low += (unsigned long long) r * cumFreq;
+    rc->range = r * model->freq[symbol];
+
+    while (rc->range < RCODER_TOP){
+        rc->range <<= 8;
+        RCoder_ShiftLow(rc);
+    }
+
+    CModel_Update(model, symbol);
+}
+
+
+// **************************************************************************** RCoder_Decode
+
+// Decode the next symbol with the model and update the model
+static int RCoder_Decode(RCoder* rc, CModel* model){
+    unsigned int r = rc->range / model->total;
+    unsigned int value = rc->code / r;
+    value = MIN(value, (unsigned int) model->total - 1);
+
+    int symbol = 0;
+    unsigned int cumFreq = 0;
+    while (cumFreq + model->freq[symbol] <= value){
+        cumFreq += model->freq[symbol];
+        symbol++;
+    }
+
+    rc->code -= r * cumFreq;
+    rc->range = r * model->freq[symbol];
+
+    while (rc->range < RCODER_TOP){
+        rc->code = (rc->code << 8) | RCoder_GetByte(rc);
+        rc->range <<= 8;
+    }
+
+    CModel_Update(model, symbol);
+
+    return symbol;
+}
+
+
+// **************************************************************************** RCoder_Flush
+
+// Output the remaining bytes of the encoder
+static void RCoder_Flush(RCoder* rc){
+    for (int i = 0; i < RCODER_INIT_BYTES_N; i++){
+        RCoder_ShiftLow(rc);
+    }
+}
@@ -0,0 +1,226 @@
+// ============================================================================
+// RODS
+// History Data
+// by Andreas Socratous
+// Jan 2023
+// ============================================================================
+
+
+// ============================================================================ INFO
+/*
+    Functions for reading and writing the history of the completed games to
+    the history file.
+
+    The history file is append-only. Saving writes only the entries that are
+    not yet in the file. The entries have a fixed size, so an entry that was
+    cut short by a failed write is ignored when reading and overwritten by the
+    next append.
+*/
+
+
+// ============================================================================ FILE STRUCTURE
+/*
+    1) HEADER:
+        File Identifier         1 x String                HDATA_IDENTIFIER
+        Version                 1 x Int16                 HDATA_VERSION
+        Seperator               1 x Byte                  FILE_SEP
+
+    2) ENTRIES (until the end of the file):
+        Entry                   HDATA_ENTRY_SIZE Bytes
+            Entry:
+                Num of Columns  1 x Byte
+                Num of Rows     1 x Byte
+                Time            1 x Time (2 Bytes)
+                Clicks          1 x Int32
+                Date            1 x Int32                 Minutes since the epoch
+*/
+
+
+// ============================================================================ DEPENDENCIES
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <raylib.h>
+
+#include "../Public/Public.h"
+#include "../Fund/Fund.h"
+#include "../Logic/Logic.h"
+#include "Store.h"
+#include "File_Internal.h"
+
+
+// ============================================================================ PRIVATE CONSTANTS
+
+#define HDATA_IDENTIFIER                    "RODH"
+#define HDATA_VERSION                       1
+#define HDATA_ENTRY_SIZE                    12
+
+
+// ============================================================================ PRIVATE FUNC DECL
+
+static bool     HData_WriteHeader(FILE* file);
+static bool     HData_ReadHeader(FILE* file);
+static bool     HData_WriteEntry(HistoryEntry entry, FILE* file);
+static bool     HData_ReadEntry(HistoryEntry* entry, FILE* file);
+
+
+
+
+
+
+// ============================================================================ FUNC DEF
+
+// **************************************************************************** HData_ReadFromFile
+
+// Read all the entries of the history file and add them to the history, as
+// saved. Return false if the file does not exist or its header is invalid
+bool HData_ReadFromFile(History* history){
+    char* path = Path_GetHistoryFile();
+    if (path == NULL) {return false;}
+
+    FILE* file = fopen(path, "rb");
+    path = Memory_Free(path);
+    if (file == NULL) {return false;}
+
+    if (!HData_ReadHeader(file)){
+        fclose(file);
+        return false;
+    }
+
+    HistoryEntry entry;
+    while (HData_ReadEntry(&entry, file)){
+        History_Add(history, entry);
+    }
+
+    History_SetAllSaved(history);
+
+    fclose(file);
+    return true;
+}
+
+
+// **************************************************************************** HData_AppendToFile
+
+// Append the unsaved entries of the history to the history file. If the file
+// does not exist or is invalid, write it from the start. Return true if
+// successful
+bool HData_AppendToFile(History* history){
+    int first = History_GetNumSaved(history);
+    int n = History_N(history);
+    if (first == n) {return true;}
+
+    char* path = Path_GetHistoryFile();
+    if (path == NULL) {return false;}
+
+    FILE* file = fopen(path, "r+b");
+    bool isValid = (file != NULL) && HData_ReadHeader(file);
+
+    if (isValid){
+        // Skip the complete entries. A trailing partial entry is overwritten
+        long start = ftell(file);
+        isValid = (start > 0) && (fseek(file, 0, SEEK_END) == 0);
+        long end = isValid ? ftell(file) : -1;
+        isValid = isValid && (end >= start);
+        isValid = isValid && (fseek(file, start + (end - start) / HDATA_ENTRY_SIZE * HDATA_ENTRY_SIZE,
+                                    SEEK_SET) == 0);
+    }
+
+    if (!isValid){
+        if (file != NULL) {fclose(file);}
+        file = fopen(path, "wb");
+        first = 0;
+        if (file != NULL && !HData_WriteHeader(file)){
+            fclose(file);
+            file = NULL;
+        }
+    }
+
+    path = Memory_Free(path);
+    if (file == NULL) {return false;}
+
+    bool res = true;
+    for (int i = first; res && i < n; i++){
+        res = HData_WriteEntry(History_GetEntry(history, i), file);
+    }
+
+    res = (fclose(file) == 0) && res;
+    if (res){
+        History_SetAllSaved(history);
+    }
+
+    return res;
+}
+
+
+
+
+
+
+// ============================================================================ PRIVATE FUNC DEF
+
+// **************************************************************************** HData_WriteHeader
+
+// Write the header of the history file. Return true if successful
+static bool HData_WriteHeader(FILE* file){
+    if (!File_WriteString(HDATA_IDENTIFIER, file)) {return false;}
+    if (!File_WriteInt(HDATA_VERSION, 2, file))    {return false;}
+    if (!File_WriteSep(file))                      {return false;}
+
+    return true;
+}
+
+
+// **************************************************************************** HData_ReadHeader
+
+// Read the header of the history file. Return true if it is valid
+static bool HData_ReadHeader(FILE* file){
+    char* identifier = NULL;
+    if (!File_ReadString(&identifier, file)) {return false;}
+
+    bool res = String_IsEqual(identifier, HDATA_IDENTIFIER);
+    identifier = Memory_Free(identifier);
+
+    int version = 0;
+    res = res && File_ReadInt(&version, 2, file) && (version == HDATA_VERSION);
+    res = res && File_ReadSep(file);
+
+    return res;
+}
+
+
+// **************************************************************************** HData_WriteEntry
+
+// Write the entry to the history file. Return true if successful
+static bool HData_WriteEntry(HistoryEntry entry, FILE* file){
+    int minutes = (int) (entry.date / 60);
+
+    if (!File_WriteByte(entry.nCols, file))     {return false;}
+    if (!File_WriteByte(entry.nRows, file))     {return false;}
+    if (!File_WriteTime(entry.time, file))      {return false;}
+    if (!File_WriteInt(entry.clicks, 4, file))  {return false;}
+    if (!File_WriteInt(minutes, 4, file))       {return false;}
+
+    return true;
+}
+
+
+// **************************************************************************** HData_ReadEntry
+
+// Read an entry from the history file and store it at the given pointer.
+// Return false at the end of the file or if the entry is incomplete
+static bool HData_ReadEntry(HistoryEntry* entry, FILE* file){
+    unsigned char nCols, nRows;
+    int minutes = 0;
+
+    if (!File_ReadByte(&nCols, file))           {return false;}
+    if (!File_ReadByte(&nRows, file))           {return false;}
+    if (!File_ReadTime(&entry->time, file))     {return false;}
+    if (!File_ReadInt(&entry->clicks, 4, file)) {return false;}
+    if (!File_ReadInt(&minutes, 4, file))       {return false;}
+
+    entry->nCols = nCols;
+    entry->nRows = nRows;
+    entry->date = (long long) minutes * 60;
+
+    return true;
+}
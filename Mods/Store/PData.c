@@ -24,6 +24,7 @@
 #include "../Graph/Graph.h"
 #include "Store.h"
 #include "File_Internal.h"
+#include "PData_Internal.h"
 
 
 // ============================================================================ FILE STRUCTURE
@@ -43,12 +44,16 @@
                 Time     1 x Time (2 bytes)
 
     3) ROD GRID:
-        Exists                  1 x Byte                  0:false, 1:false
-        Num of Columns          1 x Byte
-        Num of Rows             1 x Byte
-        Source Column           1 x Byte
-        Source Row              1 x Byte
-        Leg Data:               Num of Rods / 2           Two rods per byte: RDLU
+        Exists                  1 x Byte                  0:false, 1:legs, 2:encoded
+        Legs (1):
+            Num of Columns      1 x Byte
+            Num of Rows         1 x Byte
+            Source Column       1 x Byte
+            Source Row          1 x Byte
+            Leg Data:           Num of Rods / 2           Two rods per byte: RDLU
+        Encoded (2):
+            Data Size (DS)      1 x Int32
+            Data                DS x Byte                 See Codec.c
         Seperator               1 x Byte                  FILE_SEP
 
     4) SCROLL GRAPHICS:
@@ -68,7 +73,11 @@
         Sound On/Off            1 x Byte                  0:false, 1:true
         Seperator               1 x Byte                  FILE_SEP
 
-    7) TERMINATOR
+    7) SAVE SLOT                                          Missing in older versions
+        Active Slot             1 x Byte                  0 to SLOTS_N - 1
+        Seperator               1 x Byte                  FILE_SEP
+
+    8) TERMINATOR
         Seperator               1 x Byte                  FILE_SEP
 
 */
@@ -101,14 +110,13 @@ static bool     PData_WriteHeader(FILE* file);
 static bool     PData_ReadHeader(char** version, FILE* file);
 static bool     PData_WriteRecords(const Records* records, FILE* file);
 static bool     PData_ReadRecords(Records** records, FILE* file);
-static bool     PData_WriteRGrid(const RGrid* rGrid, FILE* file);
-static bool     PData_ReadRGrid(RGrid** rGrid, FILE* file);
-static bool     PData_WriteSGraph(const SGraph* sg, FILE* file);
-static bool     PData_ReadSGraph(SGraph** sg, Grid grid, FILE* file);
+static bool     PData_ReadRGridLegs(RGrid** rGrid, FILE* file);
 static bool     PData_WriteTime(Time time, FILE* file);
 static bool     PData_ReadTime(Time* time, FILE* file);
 static bool     PData_WriteSound(bool sound, FILE* file);
 static bool     PData_ReadSound(bool* sound, FILE* file);
+static bool     PData_WriteSlot(int slot, FILE* file);
+static bool     PData_ReadSlot(int* slot, FILE* file);
 
 
 
@@ -147,13 +155,16 @@ PData* PData_Free(PData* pData){
 // **************************************************************************** PData_WriteToFile
 
 // Write the peristent data to the data file. Return true if successful
-bool PData_WriteToFile(const Records* records, const RGrid* rGrid, const SGraph* sg, Time time, bool sound){
+bool PData_WriteToFile(const Records* records, const RGrid* rGrid, const SGraph* sg, Time time, bool sound, 
+                       int slot){
 
     #define TRY(gFunc) if(!gFunc) {res = false; goto LAB_PDATA_WRITE_EXIT;}
     
     FILE* file = NULL;
     OPEN_FILE("w", false)
 
+    TRACE_BEGIN("PData_WriteToFile", TRACE_NO_ARG)
+
     bool res = true;
     
     TRY(PData_WriteHeader(file))
@@ -161,10 +172,10 @@ bool PData_WriteToFile(const Records* records, const RGrid* rGrid, const SGraph*
     TRY(PData_WriteRecords(records, file))
     
     if (rGrid == NULL || sg == NULL || !Time_IsValid(time)){
-        File_WriteByte(0, file);
+        File_WriteByte(PDATA_RGRID_NONE, file);
         goto LAB_PDATA_WRITE_EXIT;
     }else{
-        TRY(File_WriteByte(1, file))
+        TRY(File_WriteByte(PDATA_RGRID_ENCODED, file))
     }
     
     TRY(PData_WriteRGrid(rGrid, file))
@@ -175,11 +186,14 @@ bool PData_WriteToFile(const Records* records, const RGrid* rGrid, const SGraph*
     
     TRY(PData_WriteSound(sound, file))
     
+    TRY(PData_WriteSlot(slot, file))
+    
     TRY(File_WriteSep(file))
 
     LAB_PDATA_WRITE_EXIT:
 
     fclose(file);
+    TRACE_END
     return res;
 
     #undef TRY
@@ -204,13 +218,13 @@ PData* PData_ReadFromFile(void){
     
     TRY(PData_ReadRecords(&(pData->records), file))
     
-    unsigned char exists = 0;
+    unsigned char exists = PDATA_RGRID_NONE;
     TRY(File_ReadByte(&exists, file))
-    if (exists == 0){
+    if (exists == PDATA_RGRID_NONE){
         goto LAB_PDATA_READ_EXIT;
     }
     
-    TRY(PData_ReadRGrid(&(pData->rGrid), file))
+    TRY(PData_ReadRGrid(&(pData->rGrid), exists, file))
     
     Grid grid = RGrid_GetSize(pData->rGrid);
     if (!IS_IN_RANGE(grid.nCols, RGRID_MIN_SIZE, RGRID_MAX_SIZE) || 
@@ -227,6 +241,8 @@ PData* PData_ReadFromFile(void){
     
     TRY(File_ReadSep(file))
     
+    TRY(PData_ReadSlot(&(pData->slot), file))
+    
 
     LAB_PDATA_READ_EXIT:
 
@@ -266,6 +282,9 @@ PData* PData_ReadFromFile(void){
 
         printf("Sound: %s\n", Bool_ToString(pData->sound, LONG_FORM));
         PRINT_LINE
+
+        printf("Slot: %d\n", pData->slot);
+        PRINT_LINE
     }   
 #endif
 
@@ -372,43 +391,64 @@ static bool PData_ReadRecords(Records** records, FILE* file){
 
 // **************************************************************************** PData_WriteRGrid
 
-// Write the rod grid to the file. Return true if successful
-static bool PData_WriteRGrid(const RGrid* rGrid, FILE* file){
+// Write the encoded rod grid to the file. Return true if successful
+bool PData_WriteRGrid(const RGrid* rGrid, FILE* file){
     if (rGrid == NULL) {return false;}
 
-    Grid size = RGrid_GetSize(rGrid);
-    if (!File_WriteByte(size.nCols, file)) {return false;}
-    if (!File_WriteByte(size.nRows, file)) {return false;}
+    int size = 0;
+    unsigned char* data = Codec_EncodeRGrid(rGrid, &size);
 
-    GNode source = RGrid_GetSource(rGrid);
-    if (!File_WriteByte(source.x, file)) {return false;}
-    if (!File_WriteByte(source.y, file)) {return false;}
+    bool res = File_WriteInt(size, 4, file) && 
+               (fwrite(data, 1, size, file) == (size_t) size) &&
+               File_WriteSep(file);
 
-    GNode node = GNODE_NULL;
-    do{
-        unsigned char byte = 0;
+    data = Memory_Free(data);
 
-        byte = (RGrid_GetRod(rGrid, node)->legs << 4);
-        node = Grid_NextNode(node, size);
+    return res;
+}
 
-        if (!Grid_NodesAreEqual(node, GNODE_NULL)){
-            byte += (RGrid_GetRod(rGrid, node)->legs);
-            node = Grid_NextNode(node, size);
-        }
 
-        if (!File_WriteByte(byte, file)) {return false;}
-    }while (!Grid_NodesAreEqual(node, GNODE_NULL));
+// **************************************************************************** PData_ReadRGrid
 
-    if (!File_WriteSep(file)) {return false;}
+// Read the rod grid from the file, in the given format (legs or encoded). Save 
+// it in rGrid. Return true if successful
+bool PData_ReadRGrid(RGrid** rGrid, int format, FILE* file){
+    if (rGrid == NULL) {return false;}
+    if (*rGrid != NULL) {*rGrid = RGrid_Free(*rGrid);}
+
+    if (format == PDATA_RGRID_LEGS){
+        return PData_ReadRGridLegs(rGrid, file);
+    }
+    if (format != PDATA_RGRID_ENCODED){
+        return false;
+    }
+
+    int size = 0;
+    if (!File_ReadInt(&size, 4, file)) {return false;}
+    if (size <= 0 || size > RGRID_MAX_SIZE * RGRID_MAX_SIZE) {return false;}
+
+    unsigned char* data = Memory_Allocate(NULL, size, ZEROVAL_NONE);
+    if (fread(data, 1, size, file) == (size_t) size){
+        *rGrid = Codec_DecodeRGrid(data, size);
+    }
+    data = Memory_Free(data);
+
+    if (*rGrid == NULL) {return false;}
+
+    if (!File_ReadSep(file)){
+        *rGrid = RGrid_Free(*rGrid);
+        return false;
+    }
 
     return true;
 }
 
 
-// **************************************************************************** PData_ReadRGrid
+// **************************************************************************** PData_ReadRGridLegs
 
-// Read the rod grid from the file. Save it in rGrid. Return true if successful
-static bool PData_ReadRGrid(RGrid** rGrid, FILE* file){
+// Read the rod grid, stored with 4 bits of legs per rod by older versions. 
+// Save it in rGrid. Return true if successful
+static bool PData_ReadRGridLegs(RGrid** rGrid, FILE* file){
     #define TRY(gFunc) if (!gFunc) {*rGrid = RGrid_Free(*rGrid); return false;}
 
     if (rGrid == NULL) {return false;}
@@ -465,7 +505,7 @@ static bool PData_ReadRGrid(RGrid** rGrid, FILE* file){
 // **************************************************************************** PData_WriteSGraph
 
 // Write the scroll graphics object to the file. Return true, if successful
-static bool PData_WriteSGraph(const SGraph* sg, FILE* file){
+bool PData_WriteSGraph(const SGraph* sg, FILE* file){
     if (sg == NULL) {return false;}
 
     Size vScreen = SGraph_GetVScreen(sg);
@@ -488,7 +528,7 @@ static bool PData_WriteSGraph(const SGraph* sg, FILE* file){
 
 // Read a scroll graphics object from the file and save it at the given 
 // pointer. Return true if successful
-static bool PData_ReadSGraph(SGraph** sg, Grid grid, FILE* file){
+bool PData_ReadSGraph(SGraph** sg, Grid grid, FILE* file){
     #define TRY(gFunc) if (!gFunc) {*sg = SGraph_Free(*sg); return false;}
 
     if (sg == NULL) {return false;}
@@ -502,7 +542,7 @@ static bool PData_ReadSGraph(SGraph** sg, Grid grid, FILE* file){
     Size vScreen = SIZE(w, h);
     vScreen = Grid_FitSizeToGrid(vScreen, grid);
     float tileSize = Grid_CalcSqrCellSize(grid, vScreen);
-    if (!IS_IN_RANGE(tileSize, ROD_MIN_TEXTURE_SIZE, ROD_MAX_TEXTURE_SIZE)){
+    if (!IS_IN_RANGE(tileSize, ROD_MIN_TILE_SIZE, ROD_MAX_TEXTURE_SIZE)){
         return false;
     }
 
@@ -516,7 +556,7 @@ static bool PData_ReadSGraph(SGraph** sg, Grid grid, FILE* file){
     Rect viewport = RECT(x, y, w, h);
 
     *sg = SGraph_MakeFromGrid(grid, tileSize, TO_RECT(RSIZE(viewport)), SGRAPH_DEF_MARGIN, 
-                              ROD_MIN_TEXTURE_SIZE, ROD_MAX_TEXTURE_SIZE);
+                              ROD_MIN_TILE_SIZE, ROD_MAX_TEXTURE_SIZE);
 
     SGraph_SetVScreen(*sg, vScreen);
     SGraph_PlaceViewport(*sg, RORIGIN(viewport), RP_TOP_LEFT);
@@ -569,6 +609,36 @@ static bool PData_ReadSound(bool* sound, FILE* file){
 }
 
 
+// **************************************************************************** PData_WriteSlot
+
+// Write the active save slot to the file. Return true if successful
+static bool PData_WriteSlot(int slot, FILE* file){
+    if (!File_WriteByte(PUT_IN_RANGE(slot, 0, SLOTS_N - 1), file)) {return false;}
+    return File_WriteSep(file);
+}
+
+
+// **************************************************************************** PData_ReadSlot
+
+// Read the active save slot from the file and save it at the given pointer. 
+// Files of older versions have only the terminator here, so the slot is 0. 
+// Return true if successful
+static bool PData_ReadSlot(int* slot, FILE* file){
+    unsigned char byte;
+    if (!File_ReadByte(&byte, file)) {return false;}
+
+    if (!File_ReadSep(file)){
+        *slot = 0;
+        return true;
+    }
+
+    if (byte >= SLOTS_N) {return false;}
+
+    *slot = byte;
+    return true;
+}
+
+
 
 
 
@@ -0,0 +1,46 @@
+// ============================================================================
+// RODS
+// Persistent Data Internal Header
+// by Andreas Socratous
+// Jan 2023
+// ============================================================================
+
+
+#ifndef PDATA_INTERNAL_GUARD
+#define PDATA_INTERNAL_GUARD
+
+
+// ============================================================================ INFO
+/*
+    Functions for reading and writing the game sections of the data file, that
+    are shared with the save slot files.
+*/
+
+
+// ============================================================================ DEPENDENCIES
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <raylib.h>
+
+#include "../Public/Public.h"
+
+
+// ============================================================================ CONSTANTS
+
+#define PDATA_RGRID_NONE                    0
+#define PDATA_RGRID_LEGS                    1
+#define PDATA_RGRID_ENCODED                 2
+
+
+// ============================================================================ FUNC DECL
+
+bool            PData_WriteRGrid(const RGrid* rGrid, FILE* file);
+bool            PData_ReadRGrid(RGrid** rGrid, int format, FILE* file);
+bool            PData_WriteSGraph(const SGraph* sg, FILE* file);
+bool            PData_ReadSGraph(SGraph** sg, Grid grid, FILE* file);
+
+
+
+#endif // PDATA_INTERNAL_GUARD
+
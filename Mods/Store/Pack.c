@@ -0,0 +1,299 @@
+// ============================================================================
+// RODS
+// Puzzle Pack
+// by Andreas Socratous
+// Jan 2023
+// ============================================================================
+
+
+// ============================================================================ INFO
+/*
+    Functions for reading and writing puzzle packs.
+
+    A puzzle pack is a file with many pre-generated rod grids. The file is
+    mapped to memory when opened. The header and the fixed stride index give
+    any puzzle at a constant cost, without reading the rest of the file.
+*/
+
+
+// ============================================================================ FILE STRUCTURE
+/*
+    1) HEADER:
+        File Identifier         4 x Byte                  PACK_IDENTIFIER
+        Version                 1 x Int16                 PACK_VERSION
+        Index Stride            1 x Int16                 PACK_INDEX_STRIDE
+        Num of Entries (NE)     1 x Int32
+        Reserved                4 x Byte
+
+    2) INDEX:
+        Entries                 NE x Entry (Index Stride Bytes)
+            Entry:
+                Offset          1 x Int32                 From the start of the file
+                Size            1 x Int32
+                Num of Columns  1 x Byte
+                Num of Rows     1 x Byte
+                Par             1 x Int16
+                Difficulty      1 x Byte
+                Reserved        3 x Byte
+
+    3) PAYLOADS:
+        Encoded Rod Grids       NE x Data                 See Codec.c
+
+    All integers are unsigned and little endian.
+*/
+
+
+// ============================================================================ DEPENDENCIES
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <raylib.h>
+
+#include "../Public/Public.h"
+#include "../Fund/Fund.h"
+#include "../Logic/Logic.h"
+#include "Store.h"
+
+
+// ============================================================================ PRIVATE CONSTANTS
+
+#define PACK_IDENTIFIER                     "RPAK"
+#define PACK_VERSION                        1
+#define PACK_HEADER_SIZE                    16
+#define PACK_INDEX_STRIDE                   16
+
+
+// ============================================================================ OPAQUE STRUCTURES
+
+// **************************************************************************** Pack
+
+// A memory mapped puzzle pack file, with an index of encoded rod grids
+struct Pack{
+    const unsigned char* data;
+    int size;
+    int n;
+    int stride;
+};
+
+
+// ============================================================================ PRIVATE FUNC DECL
+
+const unsigned char* Pack_MapFileForPlatform(const char* path, int* size);
+void            Pack_UnmapFileForPlatform(const unsigned char* data, int size);
+
+static unsigned int Pack_GetUInt(const unsigned char* data, int nBytes);
+static void     Pack_PutUInt(unsigned char* data, unsigned int num, int nBytes);
+
+
+
+
+
+
+// ============================================================================ FUNC DEF
+
+// **************************************************************************** Pack_Open
+
+// Open the puzzle pack file. Only the header is validated. Return NULL if it
+// fails
+Pack* Pack_Open(const char* path){
+    if (path == NULL) {return NULL;}
+
+    int size = 0;
+    const unsigned char* data = Pack_MapFileForPlatform(path, &size);
+    if (data == NULL) {return NULL;}
+
+    bool isValid = (size >= PACK_HEADER_SIZE);
+    for (int i = 0; isValid && i < 4; i++){
+        isValid = (data[i] == PACK_IDENTIFIER[i]);
+    }
+
+    int version = isValid ? (int) Pack_GetUInt(data + 4, 2) : 0;
+    int stride  = isValid ? (int) Pack_GetUInt(data + 6, 2) : 0;
+    unsigned int n = isValid ? Pack_GetUInt(data + 8, 4) : 0;
+
+    isValid = isValid && (version == PACK_VERSION) && (stride >= PACK_INDEX_STRIDE) &&
+              (n <= (unsigned int) (size - PACK_HEADER_SIZE) / stride);
+
+    if (!isValid){
+        Pack_UnmapFileForPlatform(data, size);
+        return NULL;
+    }
+
+    Pack* pack = Memory_Allocate(NULL, sizeof(Pack), ZEROVAL_ALL);
+    pack->data = data;
+    pack->size = size;
+    pack->n = (int) n;
+    pack->stride = stride;
+
+    return pack;
+}
+
+
+// **************************************************************************** Pack_Close
+
+// Close the puzzle pack and free its memory. Return NULL
+Pack* Pack_Close(Pack* pack){
+    if (pack == NULL) {return NULL;}
+
+    Pack_UnmapFileForPlatform(pack->data, pack->size);
+
+    return Memory_Free(pack);
+}
+
+
+// **************************************************************************** Pack_N
+
+// The number of puzzles in the puzzle pack
+int Pack_N(const Pack* pack){
+    return pack->n;
+}
+
+
+// **************************************************************************** Pack_GetEntry
+
+// Save the index entry of the puzzle at the given pointer. Return true if the
+// index is valid
+bool Pack_GetEntry(const Pack* pack, int index, PackEntry* entry){
+    if (!IS_IN_RANGE(index, 0, pack->n - 1)) {return false;}
+
+    const unsigned char* ptr = pack->data + PACK_HEADER_SIZE + index * pack->stride;
+
+    entry->nCols      = ptr[8];
+    entry->nRows      = ptr[9];
+    entry->par        = (int) Pack_GetUInt(ptr + 10, 2);
+    entry->difficulty = ptr[12];
+
+    return true;
+}
+
+
+// **************************************************************************** Pack_LoadRGrid
+
+// Decode the rod grid of the puzzle, directly from the mapped file. Return
+// NULL if the index or the data is invalid
+RGrid* Pack_LoadRGrid(const Pack* pack, int index){
+    if (!IS_IN_RANGE(index, 0, pack->n - 1)) {return NULL;}
+
+    const unsigned char* ptr = pack->data + PACK_HEADER_SIZE + index * pack->stride;
+
+    unsigned int offset = Pack_GetUInt(ptr, 4);
+    unsigned int size = Pack_GetUInt(ptr + 4, 4);
+    if (offset > (unsigned int) pack->size || size > (unsigned int) pack->size - offset){
+        return NULL;
+    }
+
+    return Codec_DecodeRGrid(pack->data + offset, (int) size);
+}
+
+
+// **************************************************************************** Pack_MakeEntry
+
+// Make the index entry for the rod grid
+PackEntry Pack_MakeEntry(const RGrid* rGrid){
+    Grid size = RGrid_GetSize(rGrid);
+    int par = RGrid_CalcPar(rGrid);
+
+    PackEntry entry;
+    entry.nCols = size.nCols;
+    entry.nRows = size.nRows;
+    entry.par = MIN(par, 0xFFFF);
+    entry.difficulty = PUT_IN_RANGE(100 * par / (3 * Grid_N(size)), 0, 100);
+
+    return entry;
+}
+
+
+// **************************************************************************** Pack_WriteToFile
+
+// Write a puzzle pack with the given entries and encoded rod grids (payloads).
+// Return true if successful
+bool Pack_WriteToFile(const char* path, const PackEntry* entries, unsigned char** payloads,
+                      const int* sizes, int n){
+    if (path == NULL || n < 0) {return false;}
+
+    FILE* file = fopen(path, "wb");
+    if (file == NULL) {return false;}
+
+    bool res = true;
+
+    unsigned char header[PACK_HEADER_SIZE] = {0};
+    Memory_Write(header, PACK_IDENTIFIER, 4);
+    Pack_PutUInt(header + 4, PACK_VERSION, 2);
+    Pack_PutUInt(header + 6, PACK_INDEX_STRIDE, 2);
+    Pack_PutUInt(header + 8, n, 4);
+    res = res && (fwrite(header, 1, PACK_HEADER_SIZE, file) == PACK_HEADER_SIZE);
+
+    unsigned int offset = PACK_HEADER_SIZE + n * PACK_INDEX_STRIDE;
+    for (int i = 0; res && i < n; i++){
+        unsigned char item[PACK_INDEX_STRIDE] = {0};
+        Pack_PutUInt(item, offset, 4);
+        Pack_PutUInt(item + 4, sizes[i], 4);
+        item[8] = entries[i].nCols;
+        item[9] = entries[i].nRows;
+        Pack_PutUInt(item + 10, entries[i].par, 2);
+        item[12] = entries[i].difficulty;
+        res = (fwrite(item, 1, PACK_INDEX_STRIDE, file) == PACK_INDEX_STRIDE);
+
+        offset += sizes[i];
+    }
+
+    for (int i = 0; res && i < n; i++){
+        res = (fwrite(payloads[i], 1, sizes[i], file) == (size_t) sizes[i]);
+    }
+
+    fclose(file);
+    return res;
+}
+
+
+#ifdef DEBUG_MODE
+// **************************************************************************** Pack_Print
+
+    // Multiline print of the puzzle pack index
+    void Pack_Print(const Pack* pack){
+        CHECK_NULL(pack, WITH_NEW_LINE)
+
+        PRINT_LINE
+        printf("Size:    %d\n", pack->size);
+        printf("Stride:  %d\n", pack->stride);
+        printf("Entries: %d\n", pack->n);
+        PRINT_LINE
+
+        for (int i = 0; i < pack->n; i++){
+            PackEntry entry;
+            Pack_GetEntry(pack, i, &entry);
+            printf("%5d) %3d x %3d | Par: %5d | Difficulty: %3d\n", i, entry.nCols, entry.nRows,
+                   entry.par, entry.difficulty);
+        }
+        PRINT_LINE
+    }
+#endif
+
+
+
+
+
+
+// ============================================================================ PRIVATE FUNC DEF
+
+// **************************************************************************** Pack_GetUInt
+
+// Read a little endian unsigned integer of 1 to 4 bytes
+static unsigned int Pack_GetUInt(const unsigned char* data, int nBytes){
+    unsigned int num = 0;
+    for (int i = nBytes - 1; i >= 0; i--){
+        num = (num << 8) | data[i];
+    }
+
+    return num;
+}
+
+
+// **************************************************************************** Pack_PutUInt
+
+// Write a little endian unsigned integer of 1 to 4 bytes
+static void Pack_PutUInt(unsigned char* data, unsigned int num, int nBytes){
+    for (int i = 0; i < nBytes; i++){
+        data[i] = (num >> (i * 8)) & 0xFF;
+    }
+}
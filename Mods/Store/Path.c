@@ -30,12 +30,20 @@
 #define PATH_SUPPORT_DIR_NAME               ARCH_DEF(PATH_SUPPORT_DIR_NAME)
 #define PATH_APP_DIR_NAME                   ARCH_DEF(PATH_APP_DIR_NAME)
 #define PATH_DATA_FILE_NAME                 "RodsData"
+#define PATH_HISTORY_FILE_NAME              "RodsHistory"
+#define PATH_SLOT_FILE_NAME                 "RodsSlot"
+#define PATH_THUMB_FILE_EXT                 ".png"
+#define PATH_TEXTURE_FILE_NAME              "RodsTextures"
+#define PATH_FONT_FILE_NAME                 "RodsFont"
+#define PATH_STALL_LOG_FILE_NAME            "RodsStalls.log"
+#define PATH_STALL_LOG_OLD_FILE_NAME        "RodsStalls.old.log"
 #define PATH_SEP                            ARCH_DEF(PATH_SEP)
 
 
 // ============================================================================ PRIVATE FUNC DECL
 
 char*           Path_GetHomeDir(char* dst);
+static char*    Path_GetAppFile(const char* name);
 char*           Path_AddComponent(char* dst, const char* component);
 bool            Path_MakeDir(const char* path);
 bool            Path_MakeDirForPlatform(const char* path);
@@ -52,22 +60,83 @@ bool            Path_MakeDirForPlatform(const char* path);
 // Determine the data file path, in the app folder in the application support 
 // folder of the operating system. Create the app folder if it does not exist
 char* Path_GetDataFile(void){
-    char* path = Path_GetHomeDir(NULL);
-    
-    path = Path_AddComponent(path, PATH_SUPPORT_DIR_NAME);
-    path = Path_AddComponent(path, PATH_APP_DIR_NAME);
-    
-    bool res = Path_MakeDir(path);
-    if (res == false){
-        return Memory_Free(path);
-    }
-    
-    path = Path_AddComponent(path, PATH_DATA_FILE_NAME);
-    
+    return Path_GetAppFile(PATH_DATA_FILE_NAME);
+}
+
+
+// **************************************************************************** Path_GetHistoryFile
+
+// Determine the history file path, next to the data file. Create the app 
+// folder if it does not exist
+char* Path_GetHistoryFile(void){
+    return Path_GetAppFile(PATH_HISTORY_FILE_NAME);
+}
+
+
+// **************************************************************************** Path_GetSlotFile
+
+// Determine the path of the save slot file (slot 0 is RodsSlot1), next to the 
+// data file. Create the app folder if it does not exist
+char* Path_GetSlotFile(int slot){
+    char* name = String_FromInt(NULL, slot + 1);
+    name = String_Concat(name, 2, PATH_SLOT_FILE_NAME, name);
+
+    char* path = Path_GetAppFile(name);
+    name = Memory_Free(name);
+
     return path;
 }
 
 
+// **************************************************************************** Path_GetSlotThumbFile
+
+// Determine the path of the cached thumbnail of the save slot, next to the 
+// slot file
+char* Path_GetSlotThumbFile(int slot){
+    char* path = Path_GetSlotFile(slot);
+    if (path == NULL) {return NULL;}
+
+    return String_Concat(path, 2, path, PATH_THUMB_FILE_EXT);
+}
+
+
+// **************************************************************************** Path_GetTextureFile
+
+// Determine the path of the texture cache file, next to the data file. Create 
+// the app folder if it does not exist
+char* Path_GetTextureFile(void){
+    return Path_GetAppFile(PATH_TEXTURE_FILE_NAME);
+}
+
+
+// **************************************************************************** Path_GetFontFile
+
+// Determine the path of the font cache file, next to the data file. Create 
+// the app folder if it does not exist
+char* Path_GetFontFile(void){
+    return Path_GetAppFile(PATH_FONT_FILE_NAME);
+}
+
+
+// **************************************************************************** Path_GetStallLogFile
+
+// Determine the path of the stall log, next to the data file. Create the app 
+// folder if it does not exist
+char* Path_GetStallLogFile(void){
+    return Path_GetAppFile(PATH_STALL_LOG_FILE_NAME);
+}
+
+
+// **************************************************************************** Path_GetStallLogOldFile
+
+// Determine the path of the previous stall log, that is kept when the stall 
+// log is rotated, next to the data file. Create the app folder if it does not 
+// exist
+char* Path_GetStallLogOldFile(void){
+    return Path_GetAppFile(PATH_STALL_LOG_OLD_FILE_NAME);
+}
+
+
 // **************************************************************************** Path_FileExists
 
 // Return true if the file exists
@@ -102,6 +171,28 @@ bool Path_DirExists(const char* path){
 
 // ============================================================================ PRIVATE FUNC DECL
 
+// **************************************************************************** Path_GetAppFile
+
+// Determine the path of the file with the given name, in the app folder in the 
+// application support folder of the operating system. Create the app folder if 
+// it does not exist
+static char* Path_GetAppFile(const char* name){
+    char* path = Path_GetHomeDir(NULL);
+    
+    path = Path_AddComponent(path, PATH_SUPPORT_DIR_NAME);
+    path = Path_AddComponent(path, PATH_APP_DIR_NAME);
+    
+    bool res = Path_MakeDir(path);
+    if (res == false){
+        return Memory_Free(path);
+    }
+    
+    path = Path_AddComponent(path, name);
+    
+    return path;
+}
+
+
 // **************************************************************************** Path_AddComponent
 
 // Add the path component to dst. If the component is NULL or empty, do nothing
@@ -115,7 +206,7 @@ char* Path_AddComponent(char* dst, const char* component){
     }
 
     int dstLength = String_Length(dst);
-    const char* sep = (dstLength > 0 && *(component + dstLength - 1) == PATH_SEP[0]) ? NULL : PATH_SEP;
+    const char* sep = (dstLength > 0 && *(dst + dstLength - 1) == PATH_SEP[0]) ? NULL : PATH_SEP;
 
     return String_Concat(dst, 3, dst, sep, component);
 }
@@ -0,0 +1,409 @@
+// ============================================================================
+// RODS
+// Save Slots
+// by Andreas Socratous
+// Jan 2023
+// ============================================================================
+
+
+// ============================================================================ INFO
+/*
+    Functions for reading and writing the save slots.
+
+    Every save slot is a file next to the data file, with a small header and
+    the game. Listing the slots reads only the headers and the cached
+    thumbnails, never the rod grids.
+
+    The thumbnail of a slot is rendered from the legs of the rods, by a worker
+    thread, and cached as an image next to the slot file. The worker gets its
+    own copy of the legs, so the game goes on while it runs. Reading the slot
+    info waits for the worker of the slot, if any.
+*/
+
+
+// ============================================================================ FILE STRUCTURE
+/*
+    1) HEADER:
+        File Identifier         1 x String                SLOT_IDENTIFIER
+        Version                 1 x Int16                 SLOT_VERSION
+        Num of Columns          1 x Byte
+        Num of Rows             1 x Byte
+        Rods Left               1 x Int16
+        Time                    1 x Time (2 Bytes)
+        Date                    1 x Int32                 Minutes since the epoch
+        Seperator               1 x Byte                  FILE_SEP
+
+    2) ROD GRID:
+        Data Size (DS)          1 x Int32
+        Data                    DS x Byte                 See Codec.c
+        Seperator               1 x Byte                  FILE_SEP
+
+    3) SCROLL GRAPHICS:
+        As in the data file                               See PData.c
+
+    4) TERMINATOR
+        Seperator               1 x Byte                  FILE_SEP
+*/
+
+
+// ============================================================================ DEPENDENCIES
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <raylib.h>
+
+#include <pthread.h>
+#include <time.h>
+
+#include "../Public/Public.h"
+#include "../Fund/Fund.h"
+#include "../Logic/Logic.h"
+#include "../Graph/Graph.h"
+#include "Store.h"
+#include "File_Internal.h"
+#include "PData_Internal.h"
+
+
+// ============================================================================ PRIVATE CONSTANTS
+
+#define SLOT_IDENTIFIER                     "RSLT"
+#define SLOT_VERSION                        1
+
+#define SLOT_THUMB_CELL_SIZE                3
+
+// Bits of a thumbnail cell. The first 4 are the legs, right, down, left, up
+#define SLOT_CELL_ELECTRIFIED               0x10
+#define SLOT_CELL_SOURCE                    0x20
+
+
+// ============================================================================ PRIVATE STRUCTURES
+
+// **************************************************************************** SlotThumbJob
+
+// The thumbnail of a save slot, rendered by a worker thread. cells holds a
+// copy of the legs and the state of every rod
+typedef struct SlotThumbJob{
+    pthread_t thread;
+    char* path;
+    unsigned char* cells;
+    int nCols;
+    int nRows;
+}SlotThumbJob;
+
+
+// ============================================================================ PRIVATE FUNC DECL
+
+static bool     Slot_WriteHeader(const RGrid* rGrid, Time t, FILE* file);
+static bool     Slot_ReadHeader(SlotInfo* info, FILE* file);
+static void     Slot_StartThumb(int slot, const RGrid* rGrid);
+static void     Slot_WaitForThumb(int slot);
+static void*    Slot_RenderThumb(void* arg);
+
+
+// ============================================================================ PRIVATE VARIABLES
+
+// The running thumbnail job of every save slot, or NULL
+static SlotThumbJob* slotThumbJobs[SLOTS_N];
+
+
+
+
+
+
+// ============================================================================ FUNC DEF
+
+// **************************************************************************** Slot_WriteToFile
+
+// Write the game to the file of the save slot and start rendering its
+// thumbnail. Return true if successful
+bool Slot_WriteToFile(int slot, const RGrid* rGrid, const SGraph* sg, Time time){
+    if (!IS_IN_RANGE(slot, 0, SLOTS_N - 1) || rGrid == NULL || sg == NULL) {return false;}
+
+    char* path = Path_GetSlotFile(slot);
+    if (path == NULL) {return false;}
+
+    FILE* file = fopen(path, "wb");
+    path = Memory_Free(path);
+    if (file == NULL) {return false;}
+
+    bool res = Slot_WriteHeader(rGrid, time, file) &&
+               PData_WriteRGrid(rGrid, file) &&
+               PData_WriteSGraph(sg, file) &&
+               File_WriteSep(file);
+
+    res = (fclose(file) == 0) && res;
+
+    if (res){
+        Slot_StartThumb(slot, rGrid);
+    }
+
+    return res;
+}
+
+
+// **************************************************************************** Slot_ReadFromFile
+
+// Read the game from the file of the save slot and save it at the given
+// pointers. Return false if the slot is empty or the file is invalid
+bool Slot_ReadFromFile(int slot, RGrid** rGrid, SGraph** sg, Time* time){
+    if (!IS_IN_RANGE(slot, 0, SLOTS_N - 1)) {return false;}
+
+    char* path = Path_GetSlotFile(slot);
+    if (path == NULL) {return false;}
+
+    FILE* file = fopen(path, "rb");
+    path = Memory_Free(path);
+    if (file == NULL) {return false;}
+
+    SlotInfo info;
+    bool res = Slot_ReadHeader(&info, file) &&
+               PData_ReadRGrid(rGrid, PDATA_RGRID_ENCODED, file);
+
+    if (res){
+        Grid size = RGrid_GetSize(*rGrid);
+        res = (size.nCols == info.nCols) && (size.nRows == info.nRows) &&
+              PData_ReadSGraph(sg, size, file);
+    }
+
+    fclose(file);
+
+    if (!res){
+        *rGrid = RGrid_Free(*rGrid);
+        *sg = SGraph_Free(*sg);
+        return false;
+    }
+
+    *time = info.time;
+
+    return true;
+}
+
+
+// **************************************************************************** Slot_ReadInfo
+
+// Read the header and the cached thumbnail of the save slot. Wait for the
+// thumbnail, if it is being rendered. Return false if the slot is empty
+bool Slot_ReadInfo(int slot, SlotInfo* info){
+    Memory_Set(info, sizeof(SlotInfo), 0);
+    info->time = TIME_INVALID;
+
+    if (!IS_IN_RANGE(slot, 0, SLOTS_N - 1)) {return false;}
+
+    Slot_WaitForThumb(slot);
+
+    char* path = Path_GetSlotFile(slot);
+    if (path == NULL) {return false;}
+
+    FILE* file = fopen(path, "rb");
+    path = Memory_Free(path);
+    if (file == NULL) {return false;}
+
+    info->exists = Slot_ReadHeader(info, file);
+    fclose(file);
+
+    if (!info->exists) {return false;}
+
+    path = Path_GetSlotThumbFile(slot);
+    if (path != NULL && Path_FileExists(path)){
+        info->thumb = LoadImage(path);
+    }
+    path = Memory_Free(path);
+
+    return true;
+}
+
+
+// **************************************************************************** Slot_FreeInfo
+
+// Unload the thumbnail of the slot info
+void Slot_FreeInfo(SlotInfo* info){
+    if (info->thumb.data != NULL){
+        UnloadImage(info->thumb);
+    }
+    info->thumb = (Image) {0};
+}
+
+
+// **************************************************************************** Slot_WaitForAllThumbs
+
+// Wait for all the thumbnails that are being rendered
+void Slot_WaitForAllThumbs(void){
+    for (int i = 0; i < SLOTS_N; i++){
+        Slot_WaitForThumb(i);
+    }
+}
+
+
+#ifdef DEBUG_MODE
+// **************************************************************************** Slot_PrintInfo
+
+    // Print the slot info in a single line
+    void Slot_PrintInfo(const SlotInfo* info, bool withNewLine){
+        CHECK_NULL(info, withNewLine)
+
+        if (!info->exists){
+            printf("Empty");
+        }else{
+            printf("%3d x %3d | Left: %4d | Time: ", info->nCols, info->nRows, info->nRodsLeft);
+            Time_Print(info->time, WITHOUT_NEW_LINE);
+            printf(" | Date: %lld | Thumb: %d x %d", info->date, info->thumb.width,
+                   info->thumb.height);
+        }
+
+        if (withNewLine){
+            printf("\n");
+        }
+    }
+#endif
+
+
+
+
+
+
+// ============================================================================ PRIVATE FUNC DEF
+
+// **************************************************************************** Slot_WriteHeader
+
+// Write the header of the slot file. Return true if successful
+static bool Slot_WriteHeader(const RGrid* rGrid, Time t, FILE* file){
+    Grid size = RGrid_GetSize(rGrid);
+    int minutes = (int) (time(NULL) / 60);
+
+    if (!File_WriteString(SLOT_IDENTIFIER, file))                       {return false;}
+    if (!File_WriteInt(SLOT_VERSION, 2, file))                          {return false;}
+    if (!File_WriteByte(size.nCols, file))                              {return false;}
+    if (!File_WriteByte(size.nRows, file))                              {return false;}
+    if (!File_WriteInt(RGrid_GetNumUnelectrified(rGrid), 2, file))      {return false;}
+    if (!File_WriteTime(Time_IsValid(t) ? t : TIME_NULL, file))         {return false;}
+    if (!File_WriteInt(minutes, 4, file))                               {return false;}
+    if (!File_WriteSep(file))                                           {return false;}
+
+    return true;
+}
+
+
+// **************************************************************************** Slot_ReadHeader
+
+// Read the header of the slot file and save it in the slot info. Return true
+// if it is valid
+static bool Slot_ReadHeader(SlotInfo* info, FILE* file){
+    char* identifier = NULL;
+    if (!File_ReadString(&identifier, file)) {return false;}
+
+    bool res = String_IsEqual(identifier, SLOT_IDENTIFIER);
+    identifier = Memory_Free(identifier);
+
+    int version = 0, minutes = 0;
+    unsigned char nCols = 0, nRows = 0;
+
+    res = res && File_ReadInt(&version, 2, file) && (version == SLOT_VERSION);
+    res = res && File_ReadByte(&nCols, file) && File_ReadByte(&nRows, file);
+    res = res && File_ReadInt(&info->nRodsLeft, 2, file);
+    res = res && File_ReadTime(&info->time, file);
+    res = res && File_ReadInt(&minutes, 4, file);
+    res = res && File_ReadSep(file);
+
+    res = res && IS_IN_RANGE(nCols, RGRID_MIN_SIZE, RGRID_MAX_SIZE) &&
+                 IS_IN_RANGE(nRows, RGRID_MIN_SIZE, RGRID_MAX_SIZE);
+
+    info->nCols = nCols;
+    info->nRows = nRows;
+    info->date = (long long) minutes * 60;
+
+    return res;
+}
+
+
+// **************************************************************************** Slot_StartThumb
+
+// Copy the legs and the state of the rods and start the worker thread that
+// renders the thumbnail of the slot. Wait for the previous one first
+static void Slot_StartThumb(int slot, const RGrid* rGrid){
+    Slot_WaitForThumb(slot);
+
+    char* path = Path_GetSlotThumbFile(slot);
+    if (path == NULL) {return;}
+
+    Grid size = RGrid_GetSize(rGrid);
+    GNode source = RGrid_GetSource(rGrid);
+
+    SlotThumbJob* job = Memory_Allocate(NULL, sizeof(SlotThumbJob), ZEROVAL_ALL);
+    job->path = path;
+    job->nCols = size.nCols;
+    job->nRows = size.nRows;
+    job->cells = Memory_Allocate(NULL, Grid_N(size), ZEROVAL_ALL);
+
+    GNode node = GNODE_NULL;
+    do{
+        const Rod* rod = RGrid_GetRod_Fast(rGrid, node);
+        unsigned char cell = 0;
+        for (E_Direction dir = DIR_RIGHT; dir <= DIR_UP; dir++){
+            cell |= Rod_HasLegToDir(rod, dir) ? (1 << (dir - DIR_RIGHT)) : 0;
+        }
+        cell |= rod->isElectrified ? SLOT_CELL_ELECTRIFIED : 0;
+        cell |= Grid_NodesAreEqual(node, source) ? SLOT_CELL_SOURCE : 0;
+        job->cells[node.y * size.nCols + node.x] = cell;
+
+        node = Grid_NextNode(node, size);
+    }while (!Grid_NodesAreEqual(node, GNODE_NULL));
+
+    if (pthread_create(&job->thread, NULL, Slot_RenderThumb, job) != 0){
+        // Render on this thread, if the worker cannot start
+        Slot_RenderThumb(job);
+        job->path = Memory_Free(job->path);
+        job->cells = Memory_Free(job->cells);
+        job = Memory_Free(job);
+        return;
+    }
+
+    slotThumbJobs[slot] = job;
+}
+
+
+// **************************************************************************** Slot_WaitForThumb
+
+// Wait for the worker thread of the slot to finish, if any, and free its job
+static void Slot_WaitForThumb(int slot){
+    SlotThumbJob* job = slotThumbJobs[slot];
+    if (job == NULL) {return;}
+
+    pthread_join(job->thread, NULL);
+
+    job->path = Memory_Free(job->path);
+    job->cells = Memory_Free(job->cells);
+    slotThumbJobs[slot] = Memory_Free(job);
+}
+
+
+// **************************************************************************** Slot_RenderThumb
+
+// The worker thread. Render every rod as a small cell with its center and
+// legs and save the thumbnail. It uses only the copy in the job
+static void* Slot_RenderThumb(void* arg){
+    SlotThumbJob* job = arg;
+
+    const int c = SLOT_THUMB_CELL_SIZE;
+    Image image = GenImageColor(job->nCols * c, job->nRows * c, COL_BG);
+    Color* pixels = image.data;
+
+    for (int y = 0; y < job->nRows; y++){
+        for (int x = 0; x < job->nCols; x++){
+            unsigned char cell = job->cells[y * job->nCols + x];
+
+            Color col = (cell & SLOT_CELL_ELECTRIFIED) ? COL_ELECTRIC_1 : COL_ROD;
+            Color* center = pixels + (y * c + c / 2) * image.width + x * c + c / 2;
+
+            *center = (cell & SLOT_CELL_SOURCE) ? COL_ELECTRIC_2 : col;
+            if (cell & 0x1) {*(center + 1)           = col;}
+            if (cell & 0x2) {*(center + image.width) = col;}
+            if (cell & 0x4) {*(center - 1)           = col;}
+            if (cell & 0x8) {*(center - image.width) = col;}
+        }
+    }
+
+    ExportImage(image, job->path);
+    UnloadImage(image);
+
+    return NULL;
+}
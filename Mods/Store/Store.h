@@ -30,20 +30,73 @@
 // ---------------------------------------------------------------------------- Path Functions
 
 char*           Path_GetDataFile(void);
+char*           Path_GetHistoryFile(void);
+char*           Path_GetSlotFile(int slot);
+char*           Path_GetSlotThumbFile(int slot);
+char*           Path_GetTextureFile(void);
+char*           Path_GetFontFile(void);
+char*           Path_GetStallLogFile(void);
+char*           Path_GetStallLogOldFile(void);
 bool            Path_FileExists(const char* path);
 bool            Path_DirExists(const char* path);
 
+// ---------------------------------------------------------------------------- Codec Functions
+
+unsigned char*  Codec_EncodeRGrid(const RGrid* rGrid, int* size);
+RGrid*          Codec_DecodeRGrid(const unsigned char* data, int size);
+
+// ---------------------------------------------------------------------------- Text Functions
+
+bool            Text_WriteRGrid(const RGrid* rGrid, FILE* file);
+bool            Text_ParseRGrid(RGrid* rGrid, const char* text, int size, int* pos);
+int             Text_CountRGrids(const char* text, int size);
+
+// ---------------------------------------------------------------------------- Puzzle Pack Functions
+
+Pack*           Pack_Open(const char* path);
+Pack*           Pack_Close(Pack* pack);
+int             Pack_N(const Pack* pack);
+bool            Pack_GetEntry(const Pack* pack, int index, PackEntry* entry);
+RGrid*          Pack_LoadRGrid(const Pack* pack, int index);
+PackEntry       Pack_MakeEntry(const RGrid* rGrid);
+bool            Pack_WriteToFile(const char* path, const PackEntry* entries, unsigned char** payloads,
+                                 const int* sizes, int n);
+#ifdef DEBUG_MODE
+    void        Pack_Print(const Pack* pack);
+#endif
+
 // ---------------------------------------------------------------------------- Persistent Data Functions
 
 PData*          PData_MakeEmpty(void);
 PData*          PData_Free(PData* pData);
 bool            PData_WriteToFile(const Records* records, const RGrid* rGrid, const SGraph* sg, 
-                                  Time time, bool sound);
+                                  Time time, bool sound, int slot);
 PData*          PData_ReadFromFile(void);
 #ifdef DEBUG_MODE
     void        PData_Print(PData* pData);
 #endif
 
+// ---------------------------------------------------------------------------- Save Slot Functions
+
+bool            Slot_WriteToFile(int slot, const RGrid* rGrid, const SGraph* sg, Time time);
+bool            Slot_ReadFromFile(int slot, RGrid** rGrid, SGraph** sg, Time* time);
+bool            Slot_ReadInfo(int slot, SlotInfo* info);
+void            Slot_FreeInfo(SlotInfo* info);
+void            Slot_WaitForAllThumbs(void);
+#ifdef DEBUG_MODE
+    void        Slot_PrintInfo(const SlotInfo* info, bool withNewLine);
+#endif
+
+// ---------------------------------------------------------------------------- History Data Functions
+
+bool            HData_ReadFromFile(History* history);
+bool            HData_AppendToFile(History* history);
+
+// ---------------------------------------------------------------------------- Texture Data Functions
+
+bool            TData_ReadFromFile(const char* path, unsigned int key, unsigned char* data, int size);
+bool            TData_WriteToFile(const char* path, unsigned int key, const unsigned char* data, int size);
+
 
 
 #endif // STORE_GUARD
@@ -0,0 +1,148 @@
+// ============================================================================
+// RODS
+// Texture Data
+// by Andreas Socratous
+// Jan 2023
+// ============================================================================
+
+
+// ============================================================================ INFO
+/*
+    Functions for reading and writing the cache files of the generated 
+    textures, the texture cache file and the font cache file.
+
+    A cache holds the pixel data of generated textures, so they do not have 
+    to be drawn again at every start. The data is stored with a key, that the 
+    caller makes from everything the textures depend on. A file with a 
+    different key, version or size is ignored and overwritten by the next 
+    write.
+*/
+
+
+// ============================================================================ FILE STRUCTURE
+/*
+    1) HEADER:
+        File Identifier         1 x String                TDATA_IDENTIFIER
+        Version                 1 x Int16                 TDATA_VERSION
+        Key                     1 x Int32                 Lower 31 bits
+        Data Size               1 x Int32
+        Seperator               1 x Byte                  FILE_SEP
+
+    2) DATA:
+        Pixel Data              Data Size x Byte
+        Seperator               1 x Byte                  FILE_SEP
+*/
+
+
+// ============================================================================ DEPENDENCIES
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <raylib.h>
+
+#include "../Public/Public.h"
+#include "../Fund/Fund.h"
+#include "Store.h"
+#include "File_Internal.h"
+
+
+// ============================================================================ PRIVATE CONSTANTS
+
+#define TDATA_IDENTIFIER                    "RODT"
+#define TDATA_VERSION                       1
+#define TDATA_KEY_MASK                      0x7FFFFFFFu
+
+
+// ============================================================================ PRIVATE FUNC DECL
+
+static bool     TData_WriteHeader(unsigned int key, int size, FILE* file);
+static bool     TData_ReadHeader(unsigned int key, int size, FILE* file);
+
+
+
+
+
+
+// ============================================================================ FUNC DEF
+
+// **************************************************************************** TData_ReadFromFile
+
+// Read the pixel data with the given key and size from the cache file at the 
+// path into data. Return false if the file does not exist, it is invalid or it
+// holds different data
+bool TData_ReadFromFile(const char* path, unsigned int key, unsigned char* data, int size){
+    if (path == NULL) {return false;}
+
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {return false;}
+
+    bool res = TData_ReadHeader(key, size, file);
+    res = res && (fread(data, 1, size, file) == (size_t) size);
+    res = res && File_ReadSep(file);
+
+    fclose(file);
+    return res;
+}
+
+
+// **************************************************************************** TData_WriteToFile
+
+// Write the pixel data with the given key to the cache file at the path,
+// replacing any previous data. Return true if successful
+bool TData_WriteToFile(const char* path, unsigned int key, const unsigned char* data, int size){
+    if (path == NULL) {return false;}
+
+    FILE* file = fopen(path, "wb");
+    if (file == NULL) {return false;}
+
+    bool res = TData_WriteHeader(key, size, file);
+    res = res && (fwrite(data, 1, size, file) == (size_t) size);
+    res = res && File_WriteSep(file);
+
+    res = (fclose(file) == 0) && res;
+
+    return res;
+}
+
+
+
+
+
+
+// ============================================================================ PRIVATE FUNC DEF
+
+// **************************************************************************** TData_WriteHeader
+
+// Write the header of the cache file. Return true if successful
+static bool TData_WriteHeader(unsigned int key, int size, FILE* file){
+    int fileKey = (int) (key & TDATA_KEY_MASK);
+
+    if (!File_WriteString(TDATA_IDENTIFIER, file))  {return false;}
+    if (!File_WriteInt(TDATA_VERSION, 2, file))     {return false;}
+    if (!File_WriteInt(fileKey, 4, file))           {return false;}
+    if (!File_WriteInt(size, 4, file))              {return false;}
+    if (!File_WriteSep(file))                       {return false;}
+
+    return true;
+}
+
+
+// **************************************************************************** TData_ReadHeader
+
+// Read the header of the cache file. Return true if it is valid and
+// matches the key and the size
+static bool TData_ReadHeader(unsigned int key, int size, FILE* file){
+    char* identifier = NULL;
+    if (!File_ReadString(&identifier, file)) {return false;}
+
+    bool res = String_IsEqual(identifier, TDATA_IDENTIFIER);
+    identifier = Memory_Free(identifier);
+
+    int version = 0, fileKey = 0, fileSize = 0;
+    res = res && File_ReadInt(&version, 2, file) && (version == TDATA_VERSION);
+    res = res && File_ReadInt(&fileKey, 4, file) && ((unsigned int) fileKey == (key & TDATA_KEY_MASK));
+    res = res && File_ReadInt(&fileSize, 4, file) && (fileSize == size);
+    res = res && File_ReadSep(file);
+
+    return res;
+}
@@ -0,0 +1,276 @@
+// ============================================================================
+// RODS
+// Text
+// by Andreas Socratous
+// Jan 2023
+// ============================================================================
+
+
+// ============================================================================ INFO
+/*
+    Functions for exporting the rod grid to a line-oriented text format and
+    parsing it back.
+
+    The text format is meant for exchanging test grids, keeping reference
+    grids next to the code and comparing grids line by line. A text may hold
+    any number of rod grids, one after the other.
+
+    The exporter streams the grid to the file one row at a time. The parser
+    reads the grid from a block of text in memory, in a single pass, into a
+    rod grid that is given by the caller, so it does not allocate any memory.
+*/
+
+
+// ============================================================================ FILE STRUCTURE
+/*
+    Lines starting with TEXT_COMMENT and empty lines between the grids are
+    ignored. A line may end with "\n" or "\r\n".
+
+    GRID:
+        Header                  1 x Line                  "RGRID <nCols> <nRows> <srcCol> <srcRow>"
+        Rows                    nRows x Line              nCols x Hex Digit
+            Hex Digit:
+                The legs of the rod (0-F). Bit 0: right, 1: down, 2: left,
+                3: up
+
+    EXAMPLE:
+        # 3 x 3, source at the center of the first row
+        RGRID 3 3 1 0
+        376
+        A8A
+        948
+*/
+
+
+// ============================================================================ DEPENDENCIES
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <raylib.h>
+
+#include "../Public/Public.h"
+#include "../Fund/Fund.h"
+#include "../Logic/Logic.h"
+#include "Store.h"
+
+
+// ============================================================================ PRIVATE CONSTANTS
+
+#define TEXT_HEADER                         "RGRID"
+#define TEXT_HEADER_LENGTH                  5
+#define TEXT_COMMENT                        '#'
+#define TEXT_INT_MAX                        9999
+
+
+// ============================================================================ PRIVATE VARIABLES
+
+// The value + 1 of every hex digit, or 0 for any other character
+static const unsigned char textHexValues[256] = {
+    ['0'] = 1,  ['1'] = 2,  ['2'] = 3,  ['3'] = 4,  ['4'] = 5,  ['5'] = 6,  ['6'] = 7,  ['7'] = 8,
+    ['8'] = 9,  ['9'] = 10,
+    ['A'] = 11, ['B'] = 12, ['C'] = 13, ['D'] = 14, ['E'] = 15, ['F'] = 16,
+    ['a'] = 11, ['b'] = 12, ['c'] = 13, ['d'] = 14, ['e'] = 15, ['f'] = 16
+};
+
+static const char textHexDigits[16] = "0123456789ABCDEF";
+
+
+// ============================================================================ PRIVATE FUNC DECL
+
+static bool     Text_SkipToGrid(const char* text, int size, int* pos);
+static bool     Text_IsHeader(const char* text, int size, int pos);
+static bool     Text_ParseHeader(const char* text, int size, int* pos, Grid* gridSize, GNode* source);
+static bool     Text_ParseInt(const char* text, int size, int* pos, int* value);
+static bool     Text_ParseLineEnd(const char* text, int size, int* pos);
+
+
+
+
+
+
+// ============================================================================ FUNC DEF
+
+// **************************************************************************** Text_WriteRGrid
+
+// Write the rod grid to the file in the text format, one row at a time.
+// Return true if successful
+bool Text_WriteRGrid(const RGrid* rGrid, FILE* file){
+    Grid size = RGrid_GetSize(rGrid);
+    GNode source = RGrid_GetSource(rGrid);
+
+    if (fprintf(file, "%s %d %d %d %d\n", TEXT_HEADER, size.nCols, size.nRows, source.x,
+                source.y) < 0){
+        return false;
+    }
+
+    char line[RGRID_MAX_SIZE + 1];
+    for (int y = 0; y < size.nRows; y++){
+        for (int x = 0; x < size.nCols; x++){
+            line[x] = textHexDigits[RGrid_GetRod_Fast(rGrid, GNODE(x, y))->legs];
+        }
+        line[size.nCols] = '\n';
+
+        if (fwrite(line, 1, size.nCols + 1, file) != (size_t) (size.nCols + 1)){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+// **************************************************************************** Text_ParseRGrid
+
+// Parse the next rod grid of the text, starting at pos, into the given rod
+// grid, and move pos after it. Return false at the end of the text, with pos
+// at the size, or if the grid is invalid, with pos at the invalid character
+bool Text_ParseRGrid(RGrid* rGrid, const char* text, int size, int* pos){
+    if (!Text_SkipToGrid(text, size, pos)) {return false;}
+
+    Grid gridSize;
+    GNode source;
+    if (!Text_ParseHeader(text, size, pos, &gridSize, &source)) {return false;}
+
+    RGrid_SetSize(rGrid, gridSize.nCols, gridSize.nRows);
+    RGrid_SetSource(rGrid, source);
+
+    for (int y = 0; y < gridSize.nRows; y++){
+        if (size - *pos < gridSize.nCols) {return false;}
+
+        const unsigned char* row = (const unsigned char*) text + *pos;
+        for (int x = 0; x < gridSize.nCols; x++){
+            int value = textHexValues[row[x]];
+            if (value == 0){
+                *pos += x;
+                return false;
+            }
+            RGrid_SetRod(rGrid, GNODE(x, y), value - 1);
+        }
+        *pos += gridSize.nCols;
+
+        if (!Text_ParseLineEnd(text, size, pos)) {return false;}
+    }
+
+    RGrid_Electrify(rGrid, GNODE_INVALID);
+
+    return true;
+}
+
+
+// **************************************************************************** Text_CountRGrids
+
+// Count the rod grids of the text, by their headers, without parsing them
+int Text_CountRGrids(const char* text, int size){
+    int count = 0;
+
+    for (int pos = 0; pos < size; pos++){
+        if ((pos == 0 || text[pos - 1] == '\n') && Text_IsHeader(text, size, pos)){
+            count++;
+        }
+    }
+
+    return count;
+}
+
+
+
+
+
+
+// ============================================================================ PRIVATE FUNC DEF
+
+// **************************************************************************** Text_SkipToGrid
+
+// Skip the empty lines and the comments up to the next header. Return false
+// if the end of the text is reached
+static bool Text_SkipToGrid(const char* text, int size, int* pos){
+    while (*pos < size){
+        char c = text[*pos];
+
+        if (c == '\n' || c == '\r'){
+            (*pos)++;
+        }else if (c == TEXT_COMMENT){
+            while (*pos < size && text[*pos] != '\n') {(*pos)++;}
+        }else{
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+// **************************************************************************** Text_IsHeader
+
+// Return true if the text at pos starts with TEXT_HEADER
+static bool Text_IsHeader(const char* text, int size, int pos){
+    if (size - pos < TEXT_HEADER_LENGTH) {return false;}
+
+    for (int i = 0; i < TEXT_HEADER_LENGTH; i++){
+        if (text[pos + i] != TEXT_HEADER[i]) {return false;}
+    }
+
+    return true;
+}
+
+
+// **************************************************************************** Text_ParseHeader
+
+// Parse the header line of a grid. Return false if it is invalid
+static bool Text_ParseHeader(const char* text, int size, int* pos, Grid* gridSize, GNode* source){
+    if (!Text_IsHeader(text, size, *pos)) {return false;}
+    *pos += TEXT_HEADER_LENGTH;
+
+    int nCols, nRows, x, y;
+    if (!Text_ParseInt(text, size, pos, &nCols)) {return false;}
+    if (!Text_ParseInt(text, size, pos, &nRows)) {return false;}
+    if (!Text_ParseInt(text, size, pos, &x))     {return false;}
+    if (!Text_ParseInt(text, size, pos, &y))     {return false;}
+
+    if (!IS_IN_RANGE(nCols, RGRID_MIN_SIZE, RGRID_MAX_SIZE) ||
+        !IS_IN_RANGE(nRows, RGRID_MIN_SIZE, RGRID_MAX_SIZE) ||
+        !IS_IN_RANGE(x, 0, nCols - 1) || !IS_IN_RANGE(y, 0, nRows - 1)){
+        return false;
+    }
+
+    *gridSize = GRID0(nCols, nRows);
+    *source = GNODE(x, y);
+
+    return Text_ParseLineEnd(text, size, pos);
+}
+
+
+// **************************************************************************** Text_ParseInt
+
+// Parse a non-negative integer, after one or more spaces. Return false if
+// there is no integer or it is too large
+static bool Text_ParseInt(const char* text, int size, int* pos, int* value){
+    int start = *pos;
+    while (*pos < size && text[*pos] == ' ') {(*pos)++;}
+    if (*pos == start) {return false;}
+
+    start = *pos;
+    *value = 0;
+    while (*pos < size && IS_IN_RANGE(text[*pos], '0', '9')){
+        *value = *value * 10 + (text[*pos] - '0');
+        if (*value > TEXT_INT_MAX) {return false;}
+        (*pos)++;
+    }
+
+    return *pos > start;
+}
+
+
+// **************************************************************************** Text_ParseLineEnd
+
+// Parse the end of a line, "\n" or "\r\n". The end of the text also ends the
+// line. Return false if there is any other character
+static bool Text_ParseLineEnd(const char* text, int size, int* pos){
+    if (*pos < size && text[*pos] == '\r') {(*pos)++;}
+    if (*pos == size) {return true;}
+    if (text[*pos] != '\n') {return false;}
+
+    (*pos)++;
+
+    return true;
+}
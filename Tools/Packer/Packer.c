@@ -0,0 +1,242 @@
+// ============================================================================
+// RODS
+// Packer
+// by Andreas Socratous
+// Jan 2023
+// ============================================================================
+
+
+// ============================================================================ INFO
+/*
+    Command line tool that builds a puzzle pack.
+
+    Usage: packer <output> <nCols>x<nRows>:<count> [...] [-j threads] [-s seed]
+
+    The puzzles are generated and encoded in parallel by the worker threads.
+    Every puzzle takes its seeds from the master seed and its position, so the
+    pack is the same for any number of threads.
+*/
+
+
+// ============================================================================ DEPENDENCIES
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <raylib.h>
+
+#include <pthread.h>
+#include <time.h>
+
+#include "../../Mods/Public/Public.h"
+#include "../../Mods/Fund/Fund.h"
+#include "../../Mods/Logic/Logic.h"
+#include "../../Mods/Store/Store.h"
+
+
+// ============================================================================ PRIVATE CONSTANTS
+
+#define PACKER_MAX_THREADS                  64
+#define PACKER_DEF_THREADS                  4
+#define PACKER_MAX_PUZZLES                  1000000
+
+
+// ============================================================================ PRIVATE STRUCTURES
+
+// **************************************************************************** PackerJob
+
+// The puzzles to be made, shared by all the worker threads
+typedef struct PackerJob{
+    int n;
+    Grid* sizes;
+    unsigned int* seeds;
+
+    PackEntry* entries;
+    unsigned char** payloads;
+    int* payloadSizes;
+
+    int nThreads;
+}PackerJob;
+
+
+// **************************************************************************** PackerWorker
+
+// The part of the job of a single worker thread
+typedef struct PackerWorker{
+    PackerJob* job;
+    int first;
+}PackerWorker;
+
+
+// ============================================================================ PRIVATE FUNC DECL
+
+static void*    Packer_Work(void* arg);
+static bool     Packer_ParseSize(const char* str, Grid* size, int* count);
+static void     Packer_PrintUsage(void);
+
+
+
+
+
+
+// ============================================================================ MAIN
+
+// Parse the arguments, make the puzzles in parallel and write the pack
+int main(int argc, char** argv){
+    if (argc < 3){
+        Packer_PrintUsage();
+        return 1;
+    }
+
+    const char* path = argv[1];
+    int nThreads = PACKER_DEF_THREADS;
+    unsigned int masterSeed = Math_RandomSeed();
+
+    PackerJob job = {0};
+    job.sizes = Memory_Allocate(NULL, sizeof(Grid) * PACKER_MAX_PUZZLES, ZEROVAL_ALL);
+
+    // Arguments
+    for (int i = 2; i < argc; i++){
+        if (String_IsEqual(argv[i], "-j") && i + 1 < argc){
+            i++;
+            nThreads = atoi(argv[i]);
+            nThreads = PUT_IN_RANGE(nThreads, 1, PACKER_MAX_THREADS);
+            continue;
+        }
+
+        if (String_IsEqual(argv[i], "-s") && i + 1 < argc){
+            i++;
+            masterSeed = (unsigned int) strtoul(argv[i], NULL, 10);
+            continue;
+        }
+
+        Grid size;
+        int count = 0;
+        if (!Packer_ParseSize(argv[i], &size, &count) || job.n + count > PACKER_MAX_PUZZLES){
+            printf("Invalid argument: %s\n", argv[i]);
+            Packer_PrintUsage();
+            job.sizes = Memory_Free(job.sizes);
+            return 1;
+        }
+
+        for (int k = 0; k < count; k++){
+            job.sizes[job.n] = size;
+            job.n++;
+        }
+    }
+
+    // Two seeds per puzzle, from the master seed
+    job.seeds        = Memory_Allocate(NULL, sizeof(unsigned int) * 2 * MAX(1, job.n), ZEROVAL_NONE);
+    job.entries      = Memory_Allocate(NULL, sizeof(PackEntry) * MAX(1, job.n), ZEROVAL_ALL);
+    job.payloads     = Memory_Allocate(NULL, sizeof(unsigned char*) * MAX(1, job.n), ZEROVAL_ALL);
+    job.payloadSizes = Memory_Allocate(NULL, sizeof(int) * MAX(1, job.n), ZEROVAL_ALL);
+
+    unsigned int state = masterSeed;
+    for (int i = 0; i < 2 * job.n; i++){
+        job.seeds[i] = (unsigned int) Math_SeededRandomInt(&state, 0, 0x7FFF) << 16;
+        job.seeds[i] ^= (unsigned int) Math_SeededRandomInt(&state, 0, 0xFFFF);
+    }
+
+    // Make the puzzles. Every worker takes every nThreads-th puzzle
+    struct timespec startTime, endTime;
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+
+    nThreads = MIN(nThreads, MAX(1, job.n));
+    job.nThreads = nThreads;
+
+    pthread_t threads[PACKER_MAX_THREADS];
+    PackerWorker workers[PACKER_MAX_THREADS];
+    for (int i = 0; i < nThreads; i++){
+        workers[i] = (PackerWorker) {.job = &job, .first = i};
+        pthread_create(&threads[i], NULL, Packer_Work, &workers[i]);
+    }
+    for (int i = 0; i < nThreads; i++){
+        pthread_join(threads[i], NULL);
+    }
+
+    bool res = Pack_WriteToFile(path, job.entries, job.payloads, job.payloadSizes, job.n);
+
+    clock_gettime(CLOCK_MONOTONIC, &endTime);
+    double ms = (endTime.tv_sec - startTime.tv_sec) * 1000.0 +
+                (endTime.tv_nsec - startTime.tv_nsec) / 1000000.0;
+
+    long total = 0;
+    for (int i = 0; i < job.n; i++){
+        total += job.payloadSizes[i];
+        job.payloads[i] = Memory_Free(job.payloads[i]);
+    }
+
+    if (res){
+        printf("%d puzzles, %ld payload bytes, seed %u, %d threads, %.1f ms\n", job.n, total,
+               masterSeed, nThreads, ms);
+    }else{
+        printf("Failed to write %s\n", path);
+    }
+
+    job.sizes        = Memory_Free(job.sizes);
+    job.seeds        = Memory_Free(job.seeds);
+    job.entries      = Memory_Free(job.entries);
+    job.payloads     = Memory_Free(job.payloads);
+    job.payloadSizes = Memory_Free(job.payloadSizes);
+
+    return res ? 0 : 1;
+}
+
+
+
+
+
+
+// ============================================================================ PRIVATE FUNC DEF
+
+// **************************************************************************** Packer_Work
+
+// The worker thread. Generate, shuffle and encode its share of the puzzles
+static void* Packer_Work(void* arg){
+    PackerWorker* worker = arg;
+    PackerJob* job = worker->job;
+
+    RGrid* rGrid = RGrid_MakeEmpty(RGRID_MIN_SIZE, RGRID_MIN_SIZE);
+
+    for (int i = worker->first; i < job->n; i += job->nThreads){
+        RGrid_SetSize(rGrid, job->sizes[i].nCols, job->sizes[i].nRows);
+        RGrid_CreateFromSeed(rGrid, job->seeds[2 * i]);
+        RGrid_ShuffleFromSeed(rGrid, job->seeds[2 * i + 1]);
+
+        job->entries[i] = Pack_MakeEntry(rGrid);
+        job->payloads[i] = Codec_EncodeRGrid(rGrid, &job->payloadSizes[i]);
+    }
+
+    rGrid = RGrid_Free(rGrid);
+
+    return NULL;
+}
+
+
+// **************************************************************************** Packer_ParseSize
+
+// Parse an argument in the form <nCols>x<nRows>:<count>. Return true if valid
+static bool Packer_ParseSize(const char* str, Grid* size, int* count){
+    int nCols = 0, nRows = 0;
+    if (sscanf(str, "%dx%d:%d", &nCols, &nRows, count) != 3){
+        return false;
+    }
+
+    if (!IS_IN_RANGE(nCols, RGRID_MIN_SIZE, RGRID_MAX_SIZE) ||
+        !IS_IN_RANGE(nRows, RGRID_MIN_SIZE, RGRID_MAX_SIZE) ||
+        !IS_IN_RANGE(*count, 1, PACKER_MAX_PUZZLES)){
+        return false;
+    }
+
+    *size = GRID0(nCols, nRows);
+
+    return true;
+}
+
+
+// **************************************************************************** Packer_PrintUsage
+
+// Print the command line usage
+static void Packer_PrintUsage(void){
+    printf("Usage: packer <output> <nCols>x<nRows>:<count> [...] [-j threads] [-s seed]\n");
+    printf("Sizes: %d-%d, threads: 1-%d\n", RGRID_MIN_SIZE, RGRID_MAX_SIZE, PACKER_MAX_THREADS);
+}
@@ -37,7 +37,7 @@
 // ============================================================================ MAIN
 
 // The main function of the programn
-int main(UNUSED int argc, UNUSED char** argv){
+int main(int argc, char** argv){
     
     #ifdef DEBUG_MODE
         int res = Test(argc, argv);
@@ -47,16 +47,33 @@ int main(UNUSED int argc, UNUSED char** argv){
         return res;
     #endif
 
-    Window_Init();
+    // In headless mode, no data file or cache file is read or written
+    bool isHeadless = Headless_IsRequested(argc, argv);
+    if (isHeadless){
+        Headless_Init();
+    }else{
+        Window_Init();
+    }
+
+    Trace_Init();
+    Scratch_Init(SCRATCH_SIZE);
 
-    Font_LoadDefault();
-    Texture_LoadAll();
+    Font_LoadDefault(isHeadless ? WITHOUT_CACHE : WITH_CACHE);
+    Texture_LoadAll(isHeadless ? WITHOUT_CACHE : WITH_CACHE);
     Sound_LoadAll();
 
     Records_MakeDefault();
+    History_MakeDefault();
+
+    PData* pData = NULL;
+    if (!isHeadless){
+        Glo_FilePath = Path_GetDataFile();
+        HData_ReadFromFile(Glo_History);
+        pData = PData_ReadFromFile();
+    }else{
+        Sound_TurnOff();
+    }
 
-    Glo_FilePath = Path_GetDataFile();
-    PData* pData = PData_ReadFromFile();
     if (pData != NULL){
         if (pData->records != NULL){
             Records_Copy(Glo_Records, pData->records);
@@ -79,23 +96,49 @@ int main(UNUSED int argc, UNUSED char** argv){
     pData = PData_Free(pData);
 
     Router_ShowPage(router, EVENT_NULL, PAGE_MAIN, WITH_ANIM);
-    Router_Loop(router);
 
-    PData_WriteToFile(Glo_Records, 
-                      GamePage_GetRGrid(router->pages[PAGE_GAME]), 
-                      GamePage_GetSGraph(router->pages[PAGE_GAME]), 
-                      GamePage_GetCurrentTime(router->pages[PAGE_GAME]), 
-                      Glo_SoundData->soundOn);
+    if (!isHeadless){
+        Watchdog_Init(GamePage_GetRGrid);
+    }
+
+    int exitCode = 0;
+    if (isHeadless){
+        exitCode = Headless_Run(router, argc, argv);
+    }else{
+        Router_Loop(router);
+
+        PData_WriteToFile(Glo_Records, 
+                          GamePage_GetRGrid(router->pages[PAGE_GAME]), 
+                          GamePage_GetSGraph(router->pages[PAGE_GAME]), 
+                          GamePage_GetCurrentTime(router->pages[PAGE_GAME]), 
+                          Glo_SoundData->soundOn,
+                          GamePage_GetSlot(router->pages[PAGE_GAME]));
+        Slot_WriteToFile(GamePage_GetSlot(router->pages[PAGE_GAME]), 
+                         GamePage_GetRGrid(router->pages[PAGE_GAME]), 
+                         GamePage_GetSGraph(router->pages[PAGE_GAME]), 
+                         GamePage_GetCurrentTime(router->pages[PAGE_GAME]));
+        Slot_WaitForAllThumbs();
+        HData_AppendToFile(Glo_History);
+    }
 
 
+    Watchdog_Close();
     Glo_FilePath = Memory_Free(Glo_FilePath);
     router = Router_Free(router);
     Records_FreeDefault();
+    History_FreeDefault();
     Sound_UnloadAll();
     Texture_UnloadAll();
     Font_UnloadDefault();
+    Scratch_Close();
+    Counter_Dump();
+    Trace_Close();
     Window_Close();
 
-    return 0;
+    #ifdef MEMORY_TRACK
+        Memory_Print();
+    #endif
+
+    return exitCode;
 }
 